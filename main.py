@@ -7,6 +7,7 @@ Punto de entrada principal del emulador
 
 import argparse
 import logging
+import os
 import sys
 from pathlib import Path
 
@@ -32,6 +33,39 @@ logging.basicConfig(
 )
 
 
+def _serve_gdb(viboy: Viboy, port: int, has_console: bool) -> None:
+    """
+    Ejecuta el emulador bajo control de un cliente GDB (RSP).
+    
+    Entre paradas la emulación corre a velocidad completa; entre bloques de
+    instrucciones se refresca la pantalla si la PPU completó un frame.
+    """
+    from src.debug import GDBStub
+    
+    ppu = viboy.get_ppu()
+    renderer = viboy.get_renderer()
+    
+    def refresh_display() -> None:
+        if ppu is not None and renderer is not None and ppu.is_frame_ready():
+            renderer.render_frame()
+        try:
+            import pygame
+            pygame.event.pump()
+        except ImportError:
+            pass
+    
+    stub = GDBStub(viboy, port=port, on_idle=refresh_display)
+    stub.listen()
+    if has_console:
+        print(f"   Esperando a GDB en localhost:{port} (target remote :{port})")
+    try:
+        stub.serve()
+    finally:
+        stub.close()
+        if renderer is not None:
+            renderer.quit()
+
+
 def main() -> None:
     """Función principal del emulador"""
     # Detectar si hay consola disponible (no disponible en modo windowed de PyInstaller)
@@ -56,6 +90,117 @@ def main() -> None:
         action="store_true",
         help="Activar modo verbose (muestra mensajes INFO, incluyendo heartbeat)",
     )
+    parser.add_argument(
+        "--gdb",
+        type=int,
+        metavar="PUERTO",
+        default=None,
+        help="Esperar a un depurador GDB (protocolo remoto) en localhost:PUERTO",
+    )
+    parser.add_argument(
+        "--export-state",
+        nargs="?",
+        const="",
+        default=None,
+        metavar="NOMBRE",
+        help="Publicar el estado en memoria compartida cada frame (por defecto viboy_<pid>)",
+    )
+    parser.add_argument(
+        "--record",
+        type=str,
+        metavar="ARCHIVO",
+        default=None,
+        help="Grabar la pantalla a 59,73 Hz de tiempo emulado (.y4m = Y4M, otra extensión = RGB crudo)",
+    )
+    parser.add_argument(
+        "--ppu-log",
+        type=str,
+        metavar="ARCHIVO",
+        default=None,
+        help="Registrar las escrituras de la PPU sin renderizar (re-renderizado: tools/rerender_ppu_log.py)",
+    )
+    parser.add_argument(
+        "--compositor",
+        choices=("pygame", "numpy"),
+        default="pygame",
+        help="Backend de composición de frames (numpy requiere NumPy; si falta se usa pygame)",
+    )
+    parser.add_argument(
+        "--presenter",
+        choices=("surface", "texture"),
+        default="surface",
+        help="Presentación en ventana: escalado por software o textura SDL2 (si falla se usa surface)",
+    )
+    parser.add_argument(
+        "--frame-blend",
+        choices=("mix", "persistence"),
+        default=None,
+        help="Mezclar frames para suavizar el parpadeo de sprites (se alterna con F2)",
+    )
+    parser.add_argument(
+        "--model",
+        choices=("dmg", "cgb"),
+        default=None,
+        help="Forzar el modelo de máquina (por defecto, según el flag CGB de la cabecera)",
+    )
+    parser.add_argument(
+        "--input-config",
+        default=None,
+        metavar="JSON",
+        help="Asignaciones de teclado/mando y zona muerta de los sticks (ver src/io/input.py)",
+    )
+    parser.add_argument(
+        "--boot-rom",
+        default=None,
+        metavar="ARCHIVO",
+        help="Arrancar con una Boot ROM real (DMG 256 bytes o CGB 2304 bytes) en lugar del Post-Boot State",
+    )
+    parser.add_argument(
+        "--no-boot-cache",
+        action="store_true",
+        help="Ejecutar siempre la Boot ROM, sin restaurar ni guardar el estado post-arranque en caché",
+    )
+    parser.add_argument(
+        "--patch",
+        action="append",
+        default=[],
+        metavar="ARCHIVO",
+        help="Parche IPS, UPS o BPS a aplicar a la ROM al cargarla (sin modificar el archivo); se puede repetir",
+    )
+    parser.add_argument(
+        "--cheat",
+        action="append",
+        default=[],
+        metavar="CÓDIGO",
+        help="Código Game Genie (ABC-DEF-GHI) o GameShark (ABCDEFGH); se puede repetir",
+    )
+    parser.add_argument(
+        "--resume",
+        choices=("ask", "yes", "no"),
+        default="ask",
+        help="Reanudar desde el último estado guardado de la ROM (ask: preguntar si hay consola)",
+    )
+    parser.add_argument(
+        "--no-autosave",
+        action="store_true",
+        help="No guardar el estado al salir ni periódicamente",
+    )
+    parser.add_argument(
+        "--autosave-interval",
+        type=float,
+        default=60.0,
+        metavar="SEGUNDOS",
+        help="Segundos emulados entre guardados automáticos (0 = solo al salir)",
+    )
+    parser.add_argument(
+        "--terminal",
+        nargs="?",
+        type=float,
+        const=0,
+        default=None,
+        metavar="FPS",
+        help="Mostrar la pantalla en la terminal (semibloques, 24 bits; sin ventana). FPS por defecto: 15",
+    )
     
     args = parser.parse_args()
     
@@ -91,9 +236,13 @@ def main() -> None:
                 logging.error("Error: Se requiere especificar una ROM")
         sys.exit(1)
     
+    # Con pantalla en terminal no se abre ventana (p. ej. sesiones SSH sin display)
+    if args.terminal is not None:
+        os.environ.setdefault("SDL_VIDEODRIVER", "dummy")
+    
     # Inicializar sistema Viboy
     try:
-        viboy = Viboy(args.rom)
+        viboy = Viboy(args.rom, model=args.model, patches=args.patch)
         
         # Obtener información del cartucho
         cartridge = viboy.get_cartridge()
@@ -103,10 +252,32 @@ def main() -> None:
             print(f"\n📦 Cartucho cargado:")
             print(f"   Título: {header_info['title']}")
             print(f"   Tipo: {header_info['cartridge_type']}")
+            print(f"   Modelo: {viboy.get_model().upper()}")
             print(f"   ROM: {header_info['rom_size']} KB")
             print(f"   RAM: {header_info['ram_size']} KB")
             print(f"   Tamaño total: {cartridge.get_rom_size()} bytes")
         
+        # Reanudar desde el slot de la ROM (guardado al salir o periódicamente)
+        resumed = False
+        if cartridge is not None and args.resume != "no":
+            from src.autosave import resume_slot_path
+            if resume_slot_path(cartridge).exists():
+                answer = "s"
+                if args.resume == "ask":
+                    answer = input("\n⏯️  Hay una partida guardada. ¿Reanudar? [S/n] ") if (
+                        has_console and sys.stdin is not None and sys.stdin.isatty()) else "n"
+                if answer.strip().lower() in ("", "s", "si", "sí", "y", "yes"):
+                    resumed = viboy.resume()
+                    if has_console and resumed:
+                        print("   Partida reanudada")
+        
+        # Boot ROM real (el estado post-arranque se guarda en caché por Boot ROM y cabecera)
+        if args.boot_rom is not None and cartridge is not None and not resumed:
+            from src.memory.boot_rom import BootCache
+            cached = viboy.run_boot_rom(args.boot_rom, None if args.no_boot_cache else BootCache())
+            if has_console:
+                print(f"\n🥾 Boot ROM: {'estado restaurado desde la caché' if cached else 'ejecutada'}")
+        
         # Obtener estado inicial de la CPU
         cpu = viboy.get_cpu()
         if cpu is not None and has_console:
@@ -116,6 +287,7 @@ def main() -> None:
         
         if has_console:
             print("\n✅ Sistema listo para ejecutar")
+            print("   F5/F8: guardar/cargar estado | F6/F7: cambiar de slot")
             if args.debug:
                 print("   Modo DEBUG activado - Mostrando trazas de instrucciones")
                 print("   Presiona Ctrl+C para detener\n")
@@ -126,6 +298,66 @@ def main() -> None:
                 print("   Presiona Ctrl+C para detener")
                 print("   (Usa --verbose para ver el heartbeat con VRAM_SUM)\n")
         
+        # Backend de composición de frames
+        renderer = viboy.get_renderer()
+        if renderer is not None and args.compositor != "pygame":
+            active = renderer.set_compositor(args.compositor)
+            if has_console and active != args.compositor:
+                print(f"   Compositor '{args.compositor}' no disponible, usando '{active}'")
+        
+        # Mezcla de frames (persistencia del LCD)
+        if renderer is not None and args.frame_blend is not None:
+            renderer.set_frame_blending(args.frame_blend)
+        
+        # Presentación del framebuffer en la ventana
+        if renderer is not None and args.presenter != "surface":
+            active = renderer.set_presenter(args.presenter)
+            if has_console and active != args.presenter:
+                print(f"   Presentador '{args.presenter}' no disponible, usando '{active}'")
+        
+        # Trucos (Game Genie: páginas de ROM parcheadas; GameShark: escrituras en V-Blank)
+        for code in args.cheat:
+            viboy.add_cheat(code)
+        
+        # Asignaciones de teclado y mando
+        if args.input_config is not None:
+            from src.io.input import InputBindings
+            viboy.set_input_bindings(InputBindings.load(args.input_config))
+        
+        # Modo depuración remota: el cliente GDB controla la ejecución
+        if args.gdb is not None:
+            _serve_gdb(viboy, args.gdb, has_console)
+            return
+        
+        # Exportación del estado para herramientas externas
+        if args.export_state is not None:
+            segment = viboy.enable_state_export(args.export_state or None)
+            if has_console:
+                print(f"   Estado exportado en memoria compartida: {segment}")
+        
+        # Pantalla en la terminal
+        if args.terminal is not None:
+            viboy.enable_terminal_display(args.terminal or None)
+        
+        # Registro de la PPU (sustituye al renderizado en el bucle)
+        if args.ppu_log is not None:
+            log_path = viboy.enable_ppu_log(args.ppu_log)
+            if has_console:
+                print(f"   Registrando escrituras de la PPU en: {log_path} (sin renderizar)")
+        
+        # Grabación de vídeo
+        if args.record is not None:
+            video_path = viboy.enable_recording(args.record)
+            if has_console:
+                print(f"   Grabando vídeo en: {video_path}")
+        
+        # Guardado automático en el slot de reanudación (al salir y periódicamente)
+        if cartridge is not None and not args.no_autosave:
+            interval = max(0, round(args.autosave_interval * Viboy.SYSTEM_CLOCK_HZ / Viboy.CYCLES_PER_FRAME))
+            slot = viboy.enable_autosave(interval_frames=interval)
+            if has_console:
+                print(f"   Guardado automático en: {slot}")
+        
         # Ejecutar bucle principal
         viboy.run(debug=args.debug)
         
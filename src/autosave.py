@@ -0,0 +1,174 @@
+"""
+Autosave - Reanudación instantánea desde el último estado guardado
+
+Cada reinicio del emulador obliga a repetir la intro y los menús del juego. Con
+el guardado automático, Viboy escribe un snapshot de la máquina completa
+(src/snapshot.py) en un slot por ROM:
+- al salir limpiamente (cerrar la ventana o Ctrl+C)
+- periódicamente durante la partida (por defecto, cada minuto emulado)
+
+Al volver a abrir la misma ROM, el snapshot se restaura en milisegundos y se
+continúa exactamente donde se dejó.
+
+La captura es lo único que corre en el hilo de emulación: un b"".join() de
+~74 KB, decenas de microsegundos. La compresión (snapshot.compress) y la
+escritura las hace SnapshotWriter en su propio hilo, con un archivo temporal +
+fsync + os.replace() (snapshot.write_atomic): un corte a mitad de escritura deja el snapshot anterior
+intacto, nunca uno a medias. Si el hilo aún está escribiendo cuando llega otro
+snapshot, el pendiente se sustituye (solo importa el más reciente).
+
+Fuente: POSIX rename() - sustitución atómica del archivo destino
+"""
+
+from __future__ import annotations
+
+import logging
+import os
+import threading
+from pathlib import Path
+from typing import TYPE_CHECKING
+
+from . import snapshot
+from .snapshot import write_atomic
+
+if TYPE_CHECKING:
+    from .memory.cartridge import Cartridge
+    from .viboy import Viboy
+
+logger = logging.getLogger(__name__)
+
+# Frames emulados entre guardados periódicos (~60 s a 59,73 FPS)
+DEFAULT_AUTOSAVE_INTERVAL_FRAMES = 3584
+
+RESUME_SUFFIX = ".resume"
+
+
+def default_resume_dir() -> Path:
+    """Directorio por defecto de los slots ($XDG_DATA_HOME/viboy/resume o ~/.local/share/viboy/resume)."""
+    base = os.environ.get("XDG_DATA_HOME") or Path.home() / ".local" / "share"
+    return Path(base) / "viboy" / "resume"
+
+
+def resume_slot_path(cartridge: Cartridge, directory: str | Path | None = None) -> Path:
+    """
+    Slot de reanudación de una ROM: se identifica por el hash de la ROM completa,
+    así que renombrar el archivo no pierde la partida y dos ROMs con el mismo
+    título no se pisan.
+
+    Args:
+        cartridge: Cartucho cargado
+        directory: Directorio de slots (None = default_resume_dir())
+
+    Returns:
+        Ruta del archivo del slot
+    """
+    base = Path(directory) if directory is not None else default_resume_dir()
+    return base / f"{cartridge.get_rom_sha256()[:32]}{RESUME_SUFFIX}"
+
+
+class SnapshotWriter:
+    """
+    Escribe snapshots en un archivo desde un hilo propio (el más reciente gana).
+    """
+
+    def __init__(self, path: str | Path) -> None:
+        """
+        Args:
+            path: Archivo destino
+        """
+        self.path = Path(path)
+        self.writes = 0
+        self._pending: bytes | None = None
+        self._lock = threading.Lock()
+        self._wake = threading.Event()
+        self._stop = False
+        self._thread: threading.Thread | None = threading.Thread(
+            target=self._write_loop, name="viboy-autosave", daemon=True
+        )
+        self._thread.start()
+
+    def submit(self, data: bytes) -> None:
+        """
+        Entrega un snapshot para escribir. No bloquea: si hay uno pendiente, se sustituye.
+
+        Args:
+            data: Snapshot de snapshot.capture() (el objeto no debe modificarse después)
+        """
+        with self._lock:
+            self._pending = data
+        self._wake.set()
+
+    def _write_loop(self) -> None:
+        """Hilo escritor: escribe el último snapshot entregado."""
+        while True:
+            with self._lock:
+                data, self._pending = self._pending, None
+                if data is None:
+                    # Solo se sale con la cola vacía: el snapshot de salida que
+                    # llega durante otra escritura también se escribe
+                    if self._stop:
+                        return
+                    self._wake.clear()
+            if data is None:
+                self._wake.wait()
+                continue
+            try:
+                write_atomic(self.path, snapshot.compress(data))
+                self.writes += 1
+            except OSError as e:
+                # Sin guardado solo se pierde la reanudación, no la partida en curso
+                logger.warning(f"No se pudo guardar el estado en {self.path}: {e}")
+
+    def close(self) -> None:
+        """Escribe el snapshot pendiente (si lo hay) y detiene el hilo."""
+        if self._thread is None:
+            return
+        with self._lock:
+            self._stop = True
+        self._wake.set()
+        self._thread.join()
+        self._thread = None
+
+
+class AutoSave:
+    """Guardado automático periódico y al salir en un slot de reanudación."""
+
+    def __init__(self, path: str | Path, interval_frames: int = DEFAULT_AUTOSAVE_INTERVAL_FRAMES) -> None:
+        """
+        Args:
+            path: Archivo del slot
+            interval_frames: Frames emulados entre guardados periódicos (0 = solo al salir)
+
+        Raises:
+            ValueError: Si el intervalo es negativo
+        """
+        if interval_frames < 0:
+            raise ValueError(f"Intervalo de guardado inválido: {interval_frames}")
+        self.interval_frames = interval_frames
+        self._frames_left = interval_frames
+        self._writer = SnapshotWriter(path)
+
+    @property
+    def path(self) -> Path:
+        return self._writer.path
+
+    @property
+    def writes(self) -> int:
+        """Snapshots escritos en disco hasta ahora."""
+        return self._writer.writes
+
+    def end_frame(self, viboy: Viboy) -> None:
+        """Se llama una vez por frame emulado; captura un snapshot cuando toca."""
+        if self.interval_frames:
+            self._frames_left -= 1
+            if self._frames_left <= 0:
+                self._frames_left = self.interval_frames
+                self.save(viboy)
+
+    def save(self, viboy: Viboy) -> None:
+        """Captura el estado ahora y lo entrega al hilo escritor."""
+        self._writer.submit(snapshot.capture(viboy))
+
+    def close(self) -> None:
+        """Espera a que se escriba el último snapshot entregado."""
+        self._writer.close()
@@ -20,6 +20,7 @@ Fuente: Pan Docs - CPU Instruction Set
 from __future__ import annotations
 
 import logging
+import struct
 from typing import TYPE_CHECKING, Callable
 
 from .registers import FLAG_C, FLAG_H, FLAG_N, FLAG_Z, Registers
@@ -28,8 +29,10 @@ if TYPE_CHECKING:
     from ..memory.mmu import MMU
 
 logger = logging.getLogger(__name__)
-# OPTIMIZACIÓN: Desactivar logging a nivel CRITICAL para máximo rendimiento
-# Todas las llamadas a logger.debug() quedan desactivadas sin overhead
+# OPTIMIZACIÓN: Desactivar logging a nivel CRITICAL para máximo rendimiento.
+# Ojo: el nivel no evita evaluar los argumentos (una f-string se formatea antes de
+# llamar a logger.debug), así que los handlers de opcodes no llaman al logger
+# para no crear cadenas en cada instrucción
 logger.setLevel(logging.CRITICAL)
 
 
@@ -77,143 +80,166 @@ class CPU:
         # Fuente: Pan Docs - CPU Instruction Set (EI behavior)
         self.ime_scheduled: bool = False
         
-        # Tabla de despacho (Dispatch Table) para opcodes
-        # Mapea cada opcode a su función manejadora
-        # Esto es más escalable que if/elif y compatible con Python 3.9+
-        self._opcode_table: dict[int, Callable[[], int]] = {
-            0x00: self._op_nop,
-            0x06: self._op_ld_b_d8,
-            0x0E: self._op_ld_c_d8,
-            0x16: self._op_ld_d_d8,
-            0x1E: self._op_ld_e_d8,
-            0x26: self._op_ld_h_d8,
-            0x2E: self._op_ld_l_d8,
-            0x36: self._op_ld_hl_ptr_d8,
-            0x3E: self._op_ld_a_d8,
-            0xC6: self._op_add_a_d8,
-            0xCE: self._op_adc_a_d8,      # ADC A, d8
-            0xD6: self._op_sub_d8,
-            0xDE: self._op_sbc_a_d8,      # SBC A, d8
-            0xE6: self._op_and_d8,        # AND d8
-            0xEE: self._op_xor_d8,        # XOR d8
-            0xF6: self._op_or_d8,         # OR d8
+        # Carry de la última rotación/shift CB: los helpers _cb_* devuelven solo el
+        # resultado y dejan aquí el bit que sale (sin crear una tupla por instrucción)
+        self._cb_carry: int = 0
+        
+        # Las tablas de despacho (_opcode_table, _cb_opcode_table) son atributos de
+        # clase compartidos por todas las instancias: ver _build_dispatch_tables()
+        
+        logger.info("CPU inicializada")
+    
+    # Tablas de despacho (Dispatch Tables): opcode -> handler(cpu) -> M-Cycles.
+    # Se construyen una sola vez para la clase, no por instancia: los handlers son
+    # funciones sin enlazar que reciben la CPU como argumento, así que miles de
+    # CPUs comparten las mismas ~530 funciones en lugar de crear cada una sus
+    # propios métodos enlazados y closures (~130 KB por instancia)
+    _opcode_table: dict[int, Callable[[CPU], int]]
+    _cb_opcode_table: dict[int, Callable[[CPU], int]]
+    
+    @classmethod
+    def _build_dispatch_tables(cls) -> None:
+        """
+        Construye las tablas de despacho compartidas (se llama al definir la clase).
+        
+        Usa un diccionario en lugar de if/elif: es más escalable y compatible con
+        Python 3.9+.
+        """
+        cls._opcode_table = {
+            0x00: cls._op_nop,
+            0x10: cls._op_stop,       # STOP (bajo consumo / cambio de velocidad CGB)
+            0x06: cls._op_ld_b_d8,
+            0x0E: cls._op_ld_c_d8,
+            0x16: cls._op_ld_d_d8,
+            0x1E: cls._op_ld_e_d8,
+            0x26: cls._op_ld_h_d8,
+            0x2E: cls._op_ld_l_d8,
+            0x36: cls._op_ld_hl_ptr_d8,
+            0x3E: cls._op_ld_a_d8,
+            0xC6: cls._op_add_a_d8,
+            0xCE: cls._op_adc_a_d8,      # ADC A, d8
+            0xD6: cls._op_sub_d8,
+            0xDE: cls._op_sbc_a_d8,      # SBC A, d8
+            0xE6: cls._op_and_d8,        # AND d8
+            0xEE: cls._op_xor_d8,        # XOR d8
+            0xF6: cls._op_or_d8,         # OR d8
             # Rotaciones rápidas del acumulador
-            0x07: self._op_rlca,       # RLCA (Rotate Left Circular Accumulator)
-            0x0F: self._op_rrca,       # RRCA (Rotate Right Circular Accumulator)
-            0x17: self._op_rla,        # RLA (Rotate Left Accumulator through Carry)
-            0x1F: self._op_rra,        # RRA (Rotate Right Accumulator through Carry)
+            0x07: cls._op_rlca,       # RLCA (Rotate Left Circular Accumulator)
+            0x0F: cls._op_rrca,       # RRCA (Rotate Right Circular Accumulator)
+            0x17: cls._op_rla,        # RLA (Rotate Left Accumulator through Carry)
+            0x1F: cls._op_rra,        # RRA (Rotate Right Accumulator through Carry)
             # Saltos (Jumps)
-            0xC3: self._op_jp_nn,      # JP nn (Jump absolute)
-            0xC2: self._op_jp_nz_nn,   # JP NZ, nn (Jump if Not Zero)
-            0xCA: self._op_jp_z_nn,    # JP Z, nn (Jump if Zero)
-            0xD2: self._op_jp_nc_nn,   # JP NC, nn (Jump if Not Carry)
-            0xDA: self._op_jp_c_nn,    # JP C, nn (Jump if Carry)
-            0xE9: self._op_jp_hl,      # JP (HL) (Jump to address in HL)
-            0x18: self._op_jr_e,       # JR e (Jump relative unconditional)
-            0x20: self._op_jr_nz_e,    # JR NZ, e (Jump relative if Not Zero)
-            0x28: self._op_jr_z_e,     # JR Z, e (Jump relative if Zero)
-            0x30: self._op_jr_nc_e,    # JR NC, e (Jump relative if Not Carry)
-            0x38: self._op_jr_c_e,     # JR C, e (Jump relative if Carry)
+            0xC3: cls._op_jp_nn,      # JP nn (Jump absolute)
+            0xC2: cls._op_jp_nz_nn,   # JP NZ, nn (Jump if Not Zero)
+            0xCA: cls._op_jp_z_nn,    # JP Z, nn (Jump if Zero)
+            0xD2: cls._op_jp_nc_nn,   # JP NC, nn (Jump if Not Carry)
+            0xDA: cls._op_jp_c_nn,    # JP C, nn (Jump if Carry)
+            0xE9: cls._op_jp_hl,      # JP (HL) (Jump to address in HL)
+            0x18: cls._op_jr_e,       # JR e (Jump relative unconditional)
+            0x20: cls._op_jr_nz_e,    # JR NZ, e (Jump relative if Not Zero)
+            0x28: cls._op_jr_z_e,     # JR Z, e (Jump relative if Zero)
+            0x30: cls._op_jr_nc_e,    # JR NC, e (Jump relative if Not Carry)
+            0x38: cls._op_jr_c_e,     # JR C, e (Jump relative if Carry)
             # Stack (Pila)
-            0xC5: self._op_push_bc,    # PUSH BC
-            0xC1: self._op_pop_bc,     # POP BC
-            0xD5: self._op_push_de,    # PUSH DE
-            0xD1: self._op_pop_de,     # POP DE
-            0xE5: self._op_push_hl,    # PUSH HL
-            0xE1: self._op_pop_hl,     # POP HL
-            0xF5: self._op_push_af,    # PUSH AF
-            0xF1: self._op_pop_af,     # POP AF
-            0xCD: self._op_call_nn,     # CALL nn
-            0xC4: self._op_call_nz_nn,  # CALL NZ, nn (Call if Not Zero)
-            0xCC: self._op_call_z_nn,   # CALL Z, nn (Call if Zero)
-            0xD4: self._op_call_nc_nn,  # CALL NC, nn (Call if Not Carry)
-            0xDC: self._op_call_c_nn,   # CALL C, nn (Call if Carry)
-            0xC9: self._op_ret,         # RET
-            0xD9: self._op_reti,        # RETI (Return from Interrupt)
+            0xC5: cls._op_push_bc,    # PUSH BC
+            0xC1: cls._op_pop_bc,     # POP BC
+            0xD5: cls._op_push_de,    # PUSH DE
+            0xD1: cls._op_pop_de,     # POP DE
+            0xE5: cls._op_push_hl,    # PUSH HL
+            0xE1: cls._op_pop_hl,     # POP HL
+            0xF5: cls._op_push_af,    # PUSH AF
+            0xF1: cls._op_pop_af,     # POP AF
+            0xCD: cls._op_call_nn,     # CALL nn
+            0xC4: cls._op_call_nz_nn,  # CALL NZ, nn (Call if Not Zero)
+            0xCC: cls._op_call_z_nn,   # CALL Z, nn (Call if Zero)
+            0xD4: cls._op_call_nc_nn,  # CALL NC, nn (Call if Not Carry)
+            0xDC: cls._op_call_c_nn,   # CALL C, nn (Call if Carry)
+            0xC9: cls._op_ret,         # RET
+            0xD9: cls._op_reti,        # RETI (Return from Interrupt)
             # Control de Interrupciones
-            0xF3: self._op_di,          # DI (Disable Interrupts)
-            0xFB: self._op_ei,          # EI (Enable Interrupts)
+            0xF3: cls._op_di,          # DI (Disable Interrupts)
+            0xFB: cls._op_ei,          # EI (Enable Interrupts)
             # Carga inmediata de 16 bits
-            0x31: self._op_ld_sp_d16,   # LD SP, d16
-            0x21: self._op_ld_hl_d16,   # LD HL, d16
-            0x01: self._op_ld_bc_d16,   # LD BC, d16
-            0x11: self._op_ld_de_d16,   # LD DE, d16
+            0x31: cls._op_ld_sp_d16,   # LD SP, d16
+            0x21: cls._op_ld_hl_d16,   # LD HL, d16
+            0x01: cls._op_ld_bc_d16,   # LD BC, d16
+            0x11: cls._op_ld_de_d16,   # LD DE, d16
             # Memoria Indirecta (HL, BC, DE)
-            0x77: self._op_ld_hl_ptr_a,    # LD (HL), A
-            0x22: self._op_ldi_hl_a,       # LD (HL+), A (LDI (HL), A)
-            0x32: self._op_ldd_hl_a,       # LD (HL-), A (LDD (HL), A)
-            0x2A: self._op_ldi_a_hl_ptr,   # LD A, (HL+) (LDI A, (HL))
-            0x3A: self._op_ldd_a_hl_ptr,   # LD A, (HL-) (LDD A, (HL))
-            0x0A: self._op_ld_a_bc_ptr,    # LD A, (BC)
-            0x1A: self._op_ld_a_de_ptr,    # LD A, (DE)
-            0x02: self._op_ld_bc_ptr_a,    # LD (BC), A
-            0x12: self._op_ld_de_ptr_a,    # LD (DE), A
-            0xEA: self._op_ld_nn_ptr_a,    # LD (nn), A (direccionamiento directo)
-            0xFA: self._op_ld_a_nn_ptr,    # LD A, (nn) (direccionamiento directo)
+            0x77: cls._op_ld_hl_ptr_a,    # LD (HL), A
+            0x22: cls._op_ldi_hl_a,       # LD (HL+), A (LDI (HL), A)
+            0x32: cls._op_ldd_hl_a,       # LD (HL-), A (LDD (HL), A)
+            0x2A: cls._op_ldi_a_hl_ptr,   # LD A, (HL+) (LDI A, (HL))
+            0x3A: cls._op_ldd_a_hl_ptr,   # LD A, (HL-) (LDD A, (HL))
+            0x0A: cls._op_ld_a_bc_ptr,    # LD A, (BC)
+            0x1A: cls._op_ld_a_de_ptr,    # LD A, (DE)
+            0x02: cls._op_ld_bc_ptr_a,    # LD (BC), A
+            0x12: cls._op_ld_de_ptr_a,    # LD (DE), A
+            0xEA: cls._op_ld_nn_ptr_a,    # LD (nn), A (direccionamiento directo)
+            0xFA: cls._op_ld_a_nn_ptr,    # LD A, (nn) (direccionamiento directo)
             # Incremento/Decremento de 8 bits
-            0x04: self._op_inc_b,          # INC B
-            0x05: self._op_dec_b,          # DEC B
-            0x0C: self._op_inc_c,          # INC C
-            0x0D: self._op_dec_c,          # DEC C
-            0x14: self._op_inc_d,          # INC D
-            0x15: self._op_dec_d,          # DEC D
-            0x1C: self._op_inc_e,          # INC E
-            0x1D: self._op_dec_e,          # DEC E
-            0x24: self._op_inc_h,          # INC H
-            0x25: self._op_dec_h,          # DEC H
-            0x2C: self._op_inc_l,          # INC L
-            0x2D: self._op_dec_l,          # DEC L
-            0x34: self._op_inc_hl_ptr,     # INC (HL)
-            0x35: self._op_dec_hl_ptr,     # DEC (HL)
-            0x3C: self._op_inc_a,          # INC A
-            0x3D: self._op_dec_a,          # DEC A
+            0x04: cls._op_inc_b,          # INC B
+            0x05: cls._op_dec_b,          # DEC B
+            0x0C: cls._op_inc_c,          # INC C
+            0x0D: cls._op_dec_c,          # DEC C
+            0x14: cls._op_inc_d,          # INC D
+            0x15: cls._op_dec_d,          # DEC D
+            0x1C: cls._op_inc_e,          # INC E
+            0x1D: cls._op_dec_e,          # DEC E
+            0x24: cls._op_inc_h,          # INC H
+            0x25: cls._op_dec_h,          # DEC H
+            0x2C: cls._op_inc_l,          # INC L
+            0x2D: cls._op_dec_l,          # DEC L
+            0x34: cls._op_inc_hl_ptr,     # INC (HL)
+            0x35: cls._op_dec_hl_ptr,     # DEC (HL)
+            0x3C: cls._op_inc_a,          # INC A
+            0x3D: cls._op_dec_a,          # DEC A
             # I/O Access (LDH - Load High)
-            0xE0: self._op_ldh_n_a,       # LDH (n), A
-            0xE2: self._op_ld_c_a,        # LD (C), A (escribe A en 0xFF00 + C)
-            0xF0: self._op_ldh_a_n,       # LDH A, (n)
-            0xF2: self._op_ld_a_c,        # LD A, (C) (lee de 0xFF00 + C a A)
+            0xE0: cls._op_ldh_n_a,       # LDH (n), A
+            0xE2: cls._op_ld_c_a,        # LD (C), A (escribe A en 0xFF00 + C)
+            0xF0: cls._op_ldh_a_n,       # LDH A, (n)
+            0xF2: cls._op_ld_a_c,        # LD A, (C) (lee de 0xFF00 + C a A)
             # Prefijo CB (Extended Instructions)
-            0xCB: self._handle_cb_prefix,  # CB Prefix
+            0xCB: cls._handle_cb_prefix,  # CB Prefix
             # Comparaciones (CP)
-            0xFE: self._op_cp_d8,          # CP d8
-            0xBE: self._op_cp_hl_ptr,      # CP (HL)
+            0xFE: cls._op_cp_d8,          # CP d8
+            0xBE: cls._op_cp_hl_ptr,      # CP (HL)
             # Incremento/Decremento de 16 bits
-            0x03: self._op_inc_bc,         # INC BC
-            0x13: self._op_inc_de,         # INC DE
-            0x23: self._op_inc_hl,         # INC HL
-            0x33: self._op_inc_sp,         # INC SP
-            0x0B: self._op_dec_bc,         # DEC BC
-            0x1B: self._op_dec_de,         # DEC DE
-            0x2B: self._op_dec_hl,         # DEC HL
-            0x3B: self._op_dec_sp,         # DEC SP
+            0x03: cls._op_inc_bc,         # INC BC
+            0x13: cls._op_inc_de,         # INC DE
+            0x23: cls._op_inc_hl,         # INC HL
+            0x33: cls._op_inc_sp,         # INC SP
+            0x0B: cls._op_dec_bc,         # DEC BC
+            0x1B: cls._op_dec_de,         # DEC DE
+            0x2B: cls._op_dec_hl,         # DEC HL
+            0x3B: cls._op_dec_sp,         # DEC SP
             # Aritmética de 16 bits (ADD HL, rr)
-            0x09: self._op_add_hl_bc,      # ADD HL, BC
-            0x19: self._op_add_hl_de,      # ADD HL, DE
-            0x29: self._op_add_hl_hl,      # ADD HL, HL
-            0x39: self._op_add_hl_sp,      # ADD HL, SP
+            0x09: cls._op_add_hl_bc,      # ADD HL, BC
+            0x19: cls._op_add_hl_de,      # ADD HL, DE
+            0x29: cls._op_add_hl_hl,      # ADD HL, HL
+            0x39: cls._op_add_hl_sp,      # ADD HL, SP
             # Aritmética de pila con offset (SP+r8)
-            0xE8: self._op_add_sp_r8,      # ADD SP, r8
-            0xF8: self._op_ld_hl_sp_r8,    # LD HL, SP+r8
-            0xF9: self._op_ld_sp_hl,       # LD SP, HL
+            0xE8: cls._op_add_sp_r8,      # ADD SP, r8
+            0xF8: cls._op_ld_hl_sp_r8,    # LD HL, SP+r8
+            0xF9: cls._op_ld_sp_hl,       # LD SP, HL
             # Retornos condicionales
-            0xC0: self._op_ret_nz,         # RET NZ
-            0xC8: self._op_ret_z,          # RET Z
-            0xD0: self._op_ret_nc,         # RET NC
-            0xD8: self._op_ret_c,          # RET C
+            0xC0: cls._op_ret_nz,         # RET NZ
+            0xC8: cls._op_ret_z,          # RET Z
+            0xD0: cls._op_ret_nc,         # RET NC
+            0xD8: cls._op_ret_c,          # RET C
             # Instrucciones misceláneas
-            0x27: self._op_daa,            # DAA (Decimal Adjust Accumulator)
-            0x2F: self._op_cpl,            # CPL (Complement Accumulator)
-            0x37: self._op_scf,            # SCF (Set Carry Flag)
-            0x3F: self._op_ccf,            # CCF (Complement Carry Flag)
+            0x27: cls._op_daa,            # DAA (Decimal Adjust Accumulator)
+            0x2F: cls._op_cpl,            # CPL (Complement Accumulator)
+            0x37: cls._op_scf,            # SCF (Set Carry Flag)
+            0x3F: cls._op_ccf,            # CCF (Complement Carry Flag)
             # RST (Restart) - Vectores de interrupción
-            0xC7: self._op_rst_00,         # RST 00h
-            0xCF: self._op_rst_08,         # RST 08h
-            0xD7: self._op_rst_10,         # RST 10h
-            0xDF: self._op_rst_18,         # RST 18h
-            0xE7: self._op_rst_20,         # RST 20h
-            0xEF: self._op_rst_28,         # RST 28h
-            0xF7: self._op_rst_30,         # RST 30h
-            0xFF: self._op_rst_38,         # RST 38h
+            0xC7: cls._op_rst_00,         # RST 00h
+            0xCF: cls._op_rst_08,         # RST 08h
+            0xD7: cls._op_rst_10,         # RST 10h
+            0xDF: cls._op_rst_18,         # RST 18h
+            0xE7: cls._op_rst_20,         # RST 20h
+            0xEF: cls._op_rst_28,         # RST 28h
+            0xF7: cls._op_rst_30,         # RST 30h
+            0xFF: cls._op_rst_38,         # RST 38h
         }
         
         # Tabla de despacho para opcodes CB (Extended Instructions)
@@ -222,41 +248,45 @@ class CPU:
         # Rango 0x40-0x7F: BIT b, r (Test bit)
         # Rango 0x80-0xBF: RES b, r (Reset bit)
         # Rango 0xC0-0xFF: SET b, r (Set bit)
-        self._cb_opcode_table: dict[int, Callable[[], int]] = {}
+        cls._cb_opcode_table = {}
         
         # Inicializar tabla CB para rango 0x00-0x3F (rotaciones y shifts)
-        self._init_cb_shifts_table()
+        cls._init_cb_shifts_table()
         
         # Inicializar tabla CB para rango 0x40-0xFF (BIT, RES, SET)
-        self._init_cb_bit_res_set_table()
+        cls._init_cb_bit_res_set_table()
         
-        # Inicializar handlers de transferencias LD r, r' (bloque 0x40-0x7F)
-        # Esto se hace después de definir todos los métodos helper
-        self._init_ld_handlers()
+        # Inicializar handlers de transferencias LD r, r' y HALT (bloque 0x40-0x7F)
+        cls._init_ld_handlers()
         
         # Inicializar handlers del bloque ALU (0x80-0xBF)
-        self._init_alu_handlers()
-        
-        logger.info("CPU inicializada")
+        cls._init_alu_handlers()
     
-    def _init_ld_handlers(self) -> None:
+    @classmethod
+    def _init_ld_handlers(cls) -> None:
         """
-        Inicializa los handlers para todas las transferencias LD r, r' del bloque 0x40-0x7F.
+        Inicializa los handlers de las transferencias LD r, r' del bloque 0x40-0x7F.
         
-        Este método se llama desde __init__ pero los handlers se crearán de forma lazy
-        la primera vez que se acceda a ellos, para poder usar los métodos helper que
-        se definen después de __init__.
-        
-        Por ahora, solo reservamos el espacio en la tabla. Los handlers se crearán
-        cuando se definan los métodos helper usando un método auxiliar.
+        El opcode codifica destino y origen: opcode = 0x40 | (dest << 3) | src.
+        0x76 (que sería LD (HL), (HL)) es HALT.
         
         Fuente: Pan Docs - CPU Instruction Set (LD r, r' encoding)
         """
-        # Los handlers se inicializarán de forma lazy cuando se acceda a ellos
-        # por primera vez, usando _init_ld_handler_lazy
-        pass
+        for opcode in range(0x40, 0x80):
+            if opcode == 0x76:
+                cls._opcode_table[opcode] = cls._op_halt
+                continue
+            
+            def make_handler(dest_code: int = (opcode >> 3) & 0x07,
+                             src_code: int = opcode & 0x07) -> Callable[[CPU], int]:
+                def handler(cpu: CPU) -> int:
+                    return cpu._op_ld_r_r(dest_code, src_code)
+                return handler
+            
+            cls._opcode_table[opcode] = make_handler()
     
-    def _init_alu_handlers(self) -> None:
+    @classmethod
+    def _init_alu_handlers(cls) -> None:
         """
         Inicializa los handlers para el bloque ALU completo (0x80-0xBF).
         
@@ -278,78 +308,61 @@ class CPU:
         
         Fuente: Pan Docs - CPU Instruction Set (ALU block encoding)
         """
-        # Operaciones ALU en orden
+        # Operaciones ALU en orden (funciones sin enlazar: reciben la CPU)
         operations = [
-            self._add,   # 0x80-0x87: ADD
-            self._adc,   # 0x88-0x8F: ADC
-            self._sub,   # 0x90-0x97: SUB
-            self._sbc,   # 0x98-0x9F: SBC
-            self._and,   # 0xA0-0xA7: AND
-            self._xor,   # 0xA8-0xAF: XOR
-            self._or,    # 0xB0-0xB7: OR
-            self._cp,    # 0xB8-0xBF: CP
+            cls._add,   # 0x80-0x87: ADD
+            cls._adc,   # 0x88-0x8F: ADC
+            cls._sub,   # 0x90-0x97: SUB
+            cls._sbc,   # 0x98-0x9F: SBC
+            cls._and,   # 0xA0-0xA7: AND
+            cls._xor,   # 0xA8-0xAF: XOR
+            cls._or,    # 0xB0-0xB7: OR
+            cls._cp,    # 0xB8-0xBF: CP
         ]
         
-        # Nombres de registros para logging
-        reg_names = ["B", "C", "D", "E", "H", "L", "(HL)", "A"]
-        
         # Generar todos los opcodes del bloque
         for op_idx, op_func in enumerate(operations):
             for reg_idx in range(8):
                 # Calcular opcode: base (0x80) + (op_idx * 8) + reg_idx
                 opcode = 0x80 + (op_idx * 8) + reg_idx
                 
-                # Capturar variables en el closure correctamente
-                op_func_ref = op_func
-                reg_idx_ref = reg_idx
-                reg_name_ref = reg_names[reg_idx]
-                
                 # Crear handler para este opcode específico
-                def make_handler(op_func_inner, reg_idx_inner, reg_name_inner):
-                    def handler() -> int:
+                def make_handler(op_func_inner, reg_idx_inner):
+                    def handler(cpu: CPU) -> int:
                         # Obtener valor del registro
                         if reg_idx_inner == 6:  # (HL) - Memoria indirecta
-                            hl_addr = self.registers.get_hl()
-                            value = self.mmu.read_byte(hl_addr)
-                            op_func_inner(value)
-                            op_name = op_func_inner.__name__.upper().replace('_', ' ')
-                            # logger.debug(
-                            #     f"{op_name} A, (HL) -> "
-                            #     f"A=0x{self.registers.get_a():02X} (HL)=0x{value:02X}"
-                            # )
+                            value = cpu.mmu.read_byte(cpu.registers.get_hl())
+                            op_func_inner(cpu, value)
                             return 2  # Acceso a memoria = 2 M-Cycles
-                        else:
-                            # Obtener valor del registro usando el helper existente
-                            value = self._get_register_value(reg_idx_inner)
-                            op_func_inner(value)
-                            op_name = op_func_inner.__name__.upper().replace('_', ' ')
-                            # logger.debug(
-                            #     f"{op_name} A, {reg_name_inner} -> "
-                            #     f"A=0x{self.registers.get_a():02X}"
-                            # )
-                            return 1  # Registro = 1 M-Cycle
+                        # Obtener valor del registro usando el helper existente
+                        op_func_inner(cpu, cpu._get_register_value(reg_idx_inner))
+                        return 1  # Registro = 1 M-Cycle
                     return handler
                 
                 # Crear y registrar handler
-                handler = make_handler(op_func_ref, reg_idx_ref, reg_name_ref)
-                self._opcode_table[opcode] = handler
+                cls._opcode_table[opcode] = make_handler(op_func, reg_idx)
+
+    # Estado para snapshots (src/snapshot.py): A F B C D E H L, SP, PC, IME, EI pendiente, HALT
+    _STATE_FORMAT = struct.Struct("<8B2H3?")
+    
+    def save_state(self) -> bytes:
+        """Serializa los registros y el estado de interrupciones/HALT de la CPU."""
+        r = self.registers
+        return self._STATE_FORMAT.pack(
+            r.a, r.f, r.b, r.c, r.d, r.e, r.h, r.l, r.sp, r.pc,
+            self.ime, self.ime_scheduled, self.halted,
+        )
     
-    def _init_ld_handler_lazy(self, opcode: int) -> None:
-        """
-        Inicializa un handler de LD r, r' de forma lazy cuando se accede por primera vez.
-        
-        Args:
-            opcode: Opcode del bloque 0x40-0x7F (excepto 0x76)
-        """
-        # Decodificar opcode: opcode = (dest_code << 3) | src_code
-        dest_code = (opcode >> 3) & 0x07
-        src_code = opcode & 0x07
-        
-        # Crear handler usando _op_ld_r_r (que ya está definido cuando se llama este método)
-        def handler() -> int:
-            return self._op_ld_r_r(dest_code, src_code)
-        
-        self._opcode_table[opcode] = handler
+    def state_size(self) -> int:
+        """Tamaño en bytes de save_state() (snapshot lo comprueba antes de restaurar)."""
+        return self._STATE_FORMAT.size
+    
+    def load_state(self, data: bytes) -> None:
+        """Restaura un estado de save_state()."""
+        r = self.registers
+        (r.a, r.f, r.b, r.c, r.d, r.e, r.h, r.l, r.sp, r.pc,
+         self.ime, self.ime_scheduled, self.halted) = self._STATE_FORMAT.unpack(data)
+        r.f &= 0xF0
 
     def fetch_byte(self) -> int:
         """
@@ -585,7 +598,6 @@ class CPU:
         if self.ime_scheduled:
             self.ime = True
             self.ime_scheduled = False
-            logger.debug("IME activado después de EI (retraso de 1 instrucción)")
         
         # Verificar estado HALT (antes de comprobar interrupciones)
         # Si estamos en HALT, consumir 1 ciclo y comprobar interrupciones
@@ -641,21 +653,10 @@ class CPU:
         """
         handler = self._opcode_table.get(opcode)
         if handler is None:
-            # Inicialización lazy: si es un opcode del bloque 0x40-0x7F (excepto 0x76),
-            # inicializarlo dinámicamente
-            if 0x40 <= opcode <= 0x7F and opcode != 0x76:
-                self._init_ld_handler_lazy(opcode)
-                handler = self._opcode_table.get(opcode)
-            # HALT (0x76) también se inicializa de forma lazy
-            elif opcode == 0x76:
-                self._opcode_table[0x76] = self._op_halt
-                handler = self._opcode_table.get(opcode)
-            
-            if handler is None:
-                raise NotImplementedError(
-                    f"Opcode 0x{opcode:02X} no implementado en PC=0x{self.registers.get_pc():04X}"
-                )
-        return handler()
+            raise NotImplementedError(
+                f"Opcode 0x{opcode:02X} no implementado en PC=0x{self.registers.get_pc():04X}"
+            )
+        return handler(self)
     
     # ========== Helpers de Pila (Stack) ==========
     
@@ -1324,7 +1325,6 @@ class CPU:
         """
         operand = self.fetch_byte()
         self.registers.set_a(operand)
-        logger.debug(f"LD A, 0x{operand:02X} -> A=0x{self.registers.get_a():02X}")
         return 2
     
     def _op_ld_b_d8(self) -> int:
@@ -1338,7 +1338,6 @@ class CPU:
         """
         operand = self.fetch_byte()
         self.registers.set_b(operand)
-        logger.debug(f"LD B, 0x{operand:02X} -> B=0x{self.registers.get_b():02X}")
         return 2
     
     def _op_ld_c_d8(self) -> int:
@@ -1356,7 +1355,6 @@ class CPU:
         """
         operand = self.fetch_byte()
         self.registers.set_c(operand)
-        logger.debug(f"LD C, 0x{operand:02X} -> C=0x{self.registers.get_c():02X}")
         return 2
     
     def _op_ld_d_d8(self) -> int:
@@ -1373,7 +1371,6 @@ class CPU:
         """
         operand = self.fetch_byte()
         self.registers.set_d(operand)
-        logger.debug(f"LD D, 0x{operand:02X} -> D=0x{self.registers.get_d():02X}")
         return 2
     
     def _op_ld_e_d8(self) -> int:
@@ -1389,7 +1386,6 @@ class CPU:
         """
         operand = self.fetch_byte()
         self.registers.set_e(operand)
-        logger.debug(f"LD E, 0x{operand:02X} -> E=0x{self.registers.get_e():02X}")
         return 2
     
     def _op_ld_h_d8(self) -> int:
@@ -1405,7 +1401,6 @@ class CPU:
         """
         operand = self.fetch_byte()
         self.registers.set_h(operand)
-        logger.debug(f"LD H, 0x{operand:02X} -> H=0x{self.registers.get_h():02X}")
         return 2
     
     def _op_ld_l_d8(self) -> int:
@@ -1421,7 +1416,6 @@ class CPU:
         """
         operand = self.fetch_byte()
         self.registers.set_l(operand)
-        logger.debug(f"LD L, 0x{operand:02X} -> L=0x{self.registers.get_l():02X}")
         return 2
     
     def _op_add_a_d8(self) -> int:
@@ -1438,11 +1432,6 @@ class CPU:
         """
         operand = self.fetch_byte()
         self._add(operand)
-        logger.debug(
-            f"ADD A, 0x{operand:02X} -> A=0x{self.registers.get_a():02X} "
-            f"Z={self.registers.get_flag_z()} H={self.registers.get_flag_h()} "
-            f"C={self.registers.get_flag_c()}"
-        )
         return 2
     
     def _op_sub_d8(self) -> int:
@@ -1459,11 +1448,6 @@ class CPU:
         """
         operand = self.fetch_byte()
         self._sub(operand)
-        logger.debug(
-            f"SUB 0x{operand:02X} -> A=0x{self.registers.get_a():02X} "
-            f"Z={self.registers.get_flag_z()} N={self.registers.get_flag_n()} "
-            f"H={self.registers.get_flag_h()} C={self.registers.get_flag_c()}"
-        )
         return 2
     
     def _op_adc_a_d8(self) -> int:
@@ -1483,11 +1467,6 @@ class CPU:
         """
         operand = self.fetch_byte()
         self._adc(operand)
-        logger.debug(
-            f"ADC A, 0x{operand:02X} -> A=0x{self.registers.get_a():02X} "
-            f"Z={self.registers.get_flag_z()} H={self.registers.get_flag_h()} "
-            f"C={self.registers.get_flag_c()}"
-        )
         return 2
     
     def _op_sbc_a_d8(self) -> int:
@@ -1507,11 +1486,6 @@ class CPU:
         """
         operand = self.fetch_byte()
         self._sbc(operand)
-        logger.debug(
-            f"SBC A, 0x{operand:02X} -> A=0x{self.registers.get_a():02X} "
-            f"Z={self.registers.get_flag_z()} N={self.registers.get_flag_n()} "
-            f"H={self.registers.get_flag_h()} C={self.registers.get_flag_c()}"
-        )
         return 2
     
     def _op_and_d8(self) -> int:
@@ -1539,10 +1513,6 @@ class CPU:
         """
         operand = self.fetch_byte()
         self._and(operand)
-        logger.debug(
-            f"AND 0x{operand:02X} -> A=0x{self.registers.get_a():02X} "
-            f"Z={self.registers.get_flag_z()} H={self.registers.get_flag_h()}"
-        )
         return 2
     
     def _op_or_d8(self) -> int:
@@ -1570,10 +1540,6 @@ class CPU:
         """
         operand = self.fetch_byte()
         self._or(operand)
-        logger.debug(
-            f"OR 0x{operand:02X} -> A=0x{self.registers.get_a():02X} "
-            f"Z={self.registers.get_flag_z()}"
-        )
         return 2
     
     def _op_xor_d8(self) -> int:
@@ -1601,10 +1567,6 @@ class CPU:
         """
         operand = self.fetch_byte()
         self._xor(operand)
-        logger.debug(
-            f"XOR 0x{operand:02X} -> A=0x{self.registers.get_a():02X} "
-            f"Z={self.registers.get_flag_z()}"
-        )
         return 2
 
     # ========== Handlers de Saltos (Jumps) ==========
@@ -1628,7 +1590,6 @@ class CPU:
         """
         target_addr = self.fetch_word()
         self.registers.set_pc(target_addr)
-        logger.debug(f"JP 0x{target_addr:04X} -> PC=0x{self.registers.get_pc():04X}")
         return 4
 
     def _op_jp_nz_nn(self) -> int:
@@ -1654,13 +1615,9 @@ class CPU:
         if not self.registers.get_flag_z():
             # Condición verdadera: ejecutar salto
             self.registers.set_pc(target_addr)
-            logger.debug(
-                f"JP NZ, 0x{target_addr:04X} (TAKEN) -> PC=0x{target_addr:04X}"
-            )
             return 4
         else:
             # Condición falsa: no ejecutar salto, solo avanzar PC
-            logger.debug(f"JP NZ, 0x{target_addr:04X} (NOT TAKEN) -> Z=1")
             return 3
 
     def _op_jp_z_nn(self) -> int:
@@ -1686,13 +1643,9 @@ class CPU:
         if self.registers.get_flag_z():
             # Condición verdadera: ejecutar salto
             self.registers.set_pc(target_addr)
-            logger.debug(
-                f"JP Z, 0x{target_addr:04X} (TAKEN) -> PC=0x{target_addr:04X}"
-            )
             return 4
         else:
             # Condición falsa: no ejecutar salto, solo avanzar PC
-            logger.debug(f"JP Z, 0x{target_addr:04X} (NOT TAKEN) -> Z=0")
             return 3
 
     def _op_jp_nc_nn(self) -> int:
@@ -1718,13 +1671,9 @@ class CPU:
         if not self.registers.get_flag_c():
             # Condición verdadera: ejecutar salto
             self.registers.set_pc(target_addr)
-            logger.debug(
-                f"JP NC, 0x{target_addr:04X} (TAKEN) -> PC=0x{target_addr:04X}"
-            )
             return 4
         else:
             # Condición falsa: no ejecutar salto, solo avanzar PC
-            logger.debug(f"JP NC, 0x{target_addr:04X} (NOT TAKEN) -> C=1")
             return 3
 
     def _op_jp_c_nn(self) -> int:
@@ -1750,13 +1699,9 @@ class CPU:
         if self.registers.get_flag_c():
             # Condición verdadera: ejecutar salto
             self.registers.set_pc(target_addr)
-            logger.debug(
-                f"JP C, 0x{target_addr:04X} (TAKEN) -> PC=0x{target_addr:04X}"
-            )
             return 4
         else:
             # Condición falsa: no ejecutar salto, solo avanzar PC
-            logger.debug(f"JP C, 0x{target_addr:04X} (NOT TAKEN) -> C=0")
             return 3
 
     def _op_jp_hl(self) -> int:
@@ -1776,7 +1721,6 @@ class CPU:
         """
         target_addr = self.registers.get_hl()
         self.registers.set_pc(target_addr)
-        logger.debug(f"JP (HL) -> HL=0x{target_addr:04X}, PC=0x{target_addr:04X}")
         return 1
 
     def _op_jr_e(self) -> int:
@@ -1805,10 +1749,6 @@ class CPU:
         current_pc = self.registers.get_pc()
         new_pc = (current_pc + offset) & 0xFFFF
         self.registers.set_pc(new_pc)
-        logger.debug(
-            f"JR {offset:+d} (0x{offset & 0xFF:02X}) "
-            f"PC: 0x{current_pc:04X} -> 0x{new_pc:04X}"
-        )
         return 3
 
     def _op_jr_nz_e(self) -> int:
@@ -1837,14 +1777,9 @@ class CPU:
             current_pc = self.registers.get_pc()
             new_pc = (current_pc + offset) & 0xFFFF
             self.registers.set_pc(new_pc)
-            logger.debug(
-                f"JR NZ, {offset:+d} (TAKEN) "
-                f"PC: 0x{current_pc:04X} -> 0x{new_pc:04X}"
-            )
             return 3  # 3 M-Cycles si salta
         else:
             # Condición falsa: no saltar, continuar ejecución
-            logger.debug(f"JR NZ, {offset:+d} (NOT TAKEN) Z flag set")
             return 2  # 2 M-Cycles si no salta
 
     def _op_jr_z_e(self) -> int:
@@ -1873,14 +1808,9 @@ class CPU:
             current_pc = self.registers.get_pc()
             new_pc = (current_pc + offset) & 0xFFFF
             self.registers.set_pc(new_pc)
-            logger.debug(
-                f"JR Z, {offset:+d} (TAKEN) "
-                f"PC: 0x{current_pc:04X} -> 0x{new_pc:04X}"
-            )
             return 3  # 3 M-Cycles si salta
         else:
             # Condición falsa: no saltar, continuar ejecución
-            logger.debug(f"JR Z, {offset:+d} (NOT TAKEN) Z flag not set")
             return 2  # 2 M-Cycles si no salta
 
     def _op_jr_nc_e(self) -> int:
@@ -1909,14 +1839,9 @@ class CPU:
             current_pc = self.registers.get_pc()
             new_pc = (current_pc + offset) & 0xFFFF
             self.registers.set_pc(new_pc)
-            logger.debug(
-                f"JR NC, {offset:+d} (TAKEN) "
-                f"PC: 0x{current_pc:04X} -> 0x{new_pc:04X}"
-            )
             return 3  # 3 M-Cycles si salta
         else:
             # Condición falsa: no saltar, continuar ejecución
-            logger.debug(f"JR NC, {offset:+d} (NOT TAKEN) C flag set")
             return 2  # 2 M-Cycles si no salta
 
     def _op_jr_c_e(self) -> int:
@@ -1945,14 +1870,9 @@ class CPU:
             current_pc = self.registers.get_pc()
             new_pc = (current_pc + offset) & 0xFFFF
             self.registers.set_pc(new_pc)
-            logger.debug(
-                f"JR C, {offset:+d} (TAKEN) "
-                f"PC: 0x{current_pc:04X} -> 0x{new_pc:04X}"
-            )
             return 3  # 3 M-Cycles si salta
         else:
             # Condición falsa: no saltar, continuar ejecución
-            logger.debug(f"JR C, {offset:+d} (NOT TAKEN) C flag not set")
             return 2  # 2 M-Cycles si no salta
 
     # ========== Handlers de Stack (Pila) ==========
@@ -1975,7 +1895,6 @@ class CPU:
         """
         bc_value = self.registers.get_bc()
         self._push_word(bc_value)
-        logger.debug(f"PUSH BC (0x{bc_value:04X}) -> SP=0x{self.registers.get_sp():04X}")
         return 4
 
     def _op_pop_bc(self) -> int:
@@ -1996,7 +1915,6 @@ class CPU:
         """
         value = self._pop_word()
         self.registers.set_bc(value)
-        logger.debug(f"POP BC <- 0x{value:04X} (SP=0x{self.registers.get_sp():04X})")
         return 3
     
     def _op_push_de(self) -> int:
@@ -2013,7 +1931,6 @@ class CPU:
         """
         de_value = self.registers.get_de()
         self._push_word(de_value)
-        logger.debug(f"PUSH DE (0x{de_value:04X}) -> SP=0x{self.registers.get_sp():04X}")
         return 4
     
     def _op_pop_de(self) -> int:
@@ -2029,7 +1946,6 @@ class CPU:
         """
         value = self._pop_word()
         self.registers.set_de(value)
-        logger.debug(f"POP DE <- 0x{value:04X} (SP=0x{self.registers.get_sp():04X})")
         return 3
     
     def _op_push_hl(self) -> int:
@@ -2046,7 +1962,6 @@ class CPU:
         """
         hl_value = self.registers.get_hl()
         self._push_word(hl_value)
-        logger.debug(f"PUSH HL (0x{hl_value:04X}) -> SP=0x{self.registers.get_sp():04X}")
         return 4
     
     def _op_pop_hl(self) -> int:
@@ -2062,7 +1977,6 @@ class CPU:
         """
         value = self._pop_word()
         self.registers.set_hl(value)
-        logger.debug(f"POP HL <- 0x{value:04X} (SP=0x{self.registers.get_sp():04X})")
         return 3
     
     def _op_push_af(self) -> int:
@@ -2079,7 +1993,6 @@ class CPU:
         """
         af_value = self.registers.get_af()
         self._push_word(af_value)
-        logger.debug(f"PUSH AF (0x{af_value:04X}) -> SP=0x{self.registers.get_sp():04X}")
         return 4
     
     def _op_pop_af(self) -> int:
@@ -2103,10 +2016,6 @@ class CPU:
         # Esto simula el comportamiento del hardware real donde los bits bajos de F
         # siempre son 0. Si no hacemos esto, los flags pueden tener valores inválidos.
         self.registers.set_af(value)
-        logger.debug(
-            f"POP AF <- 0x{value:04X} -> A=0x{self.registers.get_a():02X} "
-            f"F=0x{self.registers.get_f():02X} (SP=0x{self.registers.get_sp():04X})"
-        )
         return 3
 
     def _op_call_nn(self) -> int:
@@ -2148,10 +2057,6 @@ class CPU:
         # Saltar a la dirección objetivo
         self.registers.set_pc(target_addr)
         
-        logger.debug(
-            f"CALL 0x{target_addr:04X} -> "
-            f"PUSH return 0x{return_addr:04X}, PC=0x{target_addr:04X}"
-        )
         return 6
 
     def _op_call_nz_nn(self) -> int:
@@ -2180,14 +2085,9 @@ class CPU:
             return_addr = self.registers.get_pc()
             self._push_word(return_addr)
             self.registers.set_pc(target_addr)
-            logger.debug(
-                f"CALL NZ, 0x{target_addr:04X} (TAKEN) -> "
-                f"PUSH return 0x{return_addr:04X}, PC=0x{target_addr:04X}"
-            )
             return 6
         else:
             # Condición falsa: no ejecutar CALL, solo avanzar PC
-            logger.debug(f"CALL NZ, 0x{target_addr:04X} (NOT TAKEN) -> Z=1")
             return 3
 
     def _op_call_z_nn(self) -> int:
@@ -2216,14 +2116,9 @@ class CPU:
             return_addr = self.registers.get_pc()
             self._push_word(return_addr)
             self.registers.set_pc(target_addr)
-            logger.debug(
-                f"CALL Z, 0x{target_addr:04X} (TAKEN) -> "
-                f"PUSH return 0x{return_addr:04X}, PC=0x{target_addr:04X}"
-            )
             return 6
         else:
             # Condición falsa: no ejecutar CALL, solo avanzar PC
-            logger.debug(f"CALL Z, 0x{target_addr:04X} (NOT TAKEN) -> Z=0")
             return 3
 
     def _op_call_nc_nn(self) -> int:
@@ -2252,14 +2147,9 @@ class CPU:
             return_addr = self.registers.get_pc()
             self._push_word(return_addr)
             self.registers.set_pc(target_addr)
-            logger.debug(
-                f"CALL NC, 0x{target_addr:04X} (TAKEN) -> "
-                f"PUSH return 0x{return_addr:04X}, PC=0x{target_addr:04X}"
-            )
             return 6
         else:
             # Condición falsa: no ejecutar CALL, solo avanzar PC
-            logger.debug(f"CALL NC, 0x{target_addr:04X} (NOT TAKEN) -> C=1")
             return 3
 
     def _op_call_c_nn(self) -> int:
@@ -2288,14 +2178,9 @@ class CPU:
             return_addr = self.registers.get_pc()
             self._push_word(return_addr)
             self.registers.set_pc(target_addr)
-            logger.debug(
-                f"CALL C, 0x{target_addr:04X} (TAKEN) -> "
-                f"PUSH return 0x{return_addr:04X}, PC=0x{target_addr:04X}"
-            )
             return 6
         else:
             # Condición falsa: no ejecutar CALL, solo avanzar PC
-            logger.debug(f"CALL C, 0x{target_addr:04X} (NOT TAKEN) -> C=0")
             return 3
 
     def _op_ret(self) -> int:
@@ -2319,7 +2204,6 @@ class CPU:
         # Saltar a la dirección de retorno
         self.registers.set_pc(return_addr)
         
-        logger.debug(f"RET -> PC=0x{return_addr:04X} (SP=0x{self.registers.get_sp():04X})")
         return 4
 
     def _op_reti(self) -> int:
@@ -2352,10 +2236,6 @@ class CPU:
         # Reactivar IME (esto es lo que diferencia RETI de RET)
         self.ime = True
         
-        logger.debug(
-            f"RETI -> PC=0x{return_addr:04X}, IME=True "
-            f"(SP=0x{self.registers.get_sp():04X})"
-        )
         return 4
 
     # ========== Handlers de Control de Interrupciones ==========
@@ -2376,7 +2256,6 @@ class CPU:
         Fuente: Pan Docs - CPU Instruction Set (DI)
         """
         self.ime = False
-        logger.debug("DI -> IME=False (interrupciones desactivadas)")
         return 1
 
     def _op_ei(self) -> int:
@@ -2404,7 +2283,6 @@ class CPU:
         """
         # NO activar IME inmediatamente, programarlo para después de la siguiente instrucción
         self.ime_scheduled = True
-        logger.debug("EI -> ime_scheduled=True (IME se activará después de la siguiente instrucción)")
         return 1
 
     # ========== Handlers de Operaciones Lógicas ==========
@@ -2446,7 +2324,6 @@ class CPU:
         self.registers.clear_flag(FLAG_H)
         self.registers.clear_flag(FLAG_C)
         
-        logger.debug("XOR A -> A=0x00, Z=1, N=0, H=0, C=0")
         return 1
 
     # ========== Handlers de Carga Inmediata de 16 bits ==========
@@ -2473,7 +2350,6 @@ class CPU:
         """
         value = self.fetch_word()
         self.registers.set_sp(value)
-        logger.debug(f"LD SP, 0x{value:04X} -> SP=0x{self.registers.get_sp():04X}")
         return 3
 
     def _op_ld_hl_d16(self) -> int:
@@ -2497,7 +2373,6 @@ class CPU:
         """
         value = self.fetch_word()
         self.registers.set_hl(value)
-        logger.debug(f"LD HL, 0x{value:04X} -> HL=0x{self.registers.get_hl():04X}")
         return 3
     
     def _op_ld_bc_d16(self) -> int:
@@ -2521,7 +2396,6 @@ class CPU:
         """
         value = self.fetch_word()
         self.registers.set_bc(value)
-        logger.debug(f"LD BC, 0x{value:04X} -> BC=0x{self.registers.get_bc():04X}")
         return 3
     
     def _op_ld_de_d16(self) -> int:
@@ -2545,7 +2419,6 @@ class CPU:
         """
         value = self.fetch_word()
         self.registers.set_de(value)
-        logger.debug(f"LD DE, 0x{value:04X} -> DE=0x{self.registers.get_de():04X}")
         return 3
 
     # ========== Handlers de Memoria Indirecta (HL) ==========
@@ -2576,7 +2449,6 @@ class CPU:
         hl_addr = self.registers.get_hl()
         a_value = self.registers.get_a()
         self.mmu.write_byte(hl_addr, a_value)
-        logger.debug(f"LD (HL), A -> (0x{hl_addr:04X}) = 0x{a_value:02X}")
         return 2
     
     def _op_ld_hl_ptr_d8(self) -> int:
@@ -2601,7 +2473,6 @@ class CPU:
         hl_addr = self.registers.get_hl()
         operand = self.fetch_byte()
         self.mmu.write_byte(hl_addr, operand & 0xFF)
-        logger.debug(f"LD (HL), 0x{operand:02X} -> (0x{hl_addr:04X}) = 0x{self.mmu.read_byte(hl_addr):02X}")
         return 3
     
     def _op_ldi_hl_a(self) -> int:
@@ -2635,7 +2506,6 @@ class CPU:
         # Incrementar HL (wrap-around de 16 bits)
         new_hl = (hl_addr + 1) & 0xFFFF
         self.registers.set_hl(new_hl)
-        logger.debug(f"LD (HL+), A -> (0x{hl_addr:04X}) = 0x{a_value:02X}, HL = 0x{new_hl:04X}")
         return 2
     
     def _op_ldd_hl_a(self) -> int:
@@ -2664,7 +2534,6 @@ class CPU:
         # Decrementar HL (wrap-around de 16 bits)
         new_hl = (hl_addr - 1) & 0xFFFF
         self.registers.set_hl(new_hl)
-        logger.debug(f"LD (HL-), A -> (0x{hl_addr:04X}) = 0x{a_value:02X}, HL = 0x{new_hl:04X}")
         return 2
     
     def _op_ldi_a_hl_ptr(self) -> int:
@@ -2692,7 +2561,6 @@ class CPU:
         # Incrementar HL (wrap-around de 16 bits)
         new_hl = (hl_addr + 1) & 0xFFFF
         self.registers.set_hl(new_hl)
-        logger.debug(f"LD A, (HL+) -> A = 0x{value:02X} from (0x{hl_addr:04X}), HL = 0x{new_hl:04X}")
         return 2
     
     def _op_ldd_a_hl_ptr(self) -> int:
@@ -2721,7 +2589,6 @@ class CPU:
         # Decrementar HL (wrap-around de 16 bits)
         new_hl = (hl_addr - 1) & 0xFFFF
         self.registers.set_hl(new_hl)
-        logger.debug(f"LD A, (HL-) -> A = 0x{value:02X} from (0x{hl_addr:04X}), HL = 0x{new_hl:04X}")
         return 2
     
     def _op_ld_a_bc_ptr(self) -> int:
@@ -2750,7 +2617,6 @@ class CPU:
         bc_addr = self.registers.get_bc()
         value = self.mmu.read_byte(bc_addr)
         self.registers.set_a(value)
-        logger.debug(f"LD A, (BC) -> A = 0x{value:02X} from (0x{bc_addr:04X})")
         return 2
     
     def _op_ld_a_de_ptr(self) -> int:
@@ -2779,7 +2645,6 @@ class CPU:
         de_addr = self.registers.get_de()
         value = self.mmu.read_byte(de_addr)
         self.registers.set_a(value)
-        logger.debug(f"LD A, (DE) -> A = 0x{value:02X} from (0x{de_addr:04X})")
         return 2
     
     def _op_ld_bc_ptr_a(self) -> int:
@@ -2805,7 +2670,6 @@ class CPU:
         bc_addr = self.registers.get_bc()
         a_value = self.registers.get_a()
         self.mmu.write_byte(bc_addr, a_value)
-        logger.debug(f"LD (BC), A -> (0x{bc_addr:04X}) = 0x{a_value:02X}")
         return 2
     
     def _op_ld_de_ptr_a(self) -> int:
@@ -2831,7 +2695,6 @@ class CPU:
         de_addr = self.registers.get_de()
         a_value = self.registers.get_a()
         self.mmu.write_byte(de_addr, a_value)
-        logger.debug(f"LD (DE), A -> (0x{de_addr:04X}) = 0x{a_value:02X}")
         return 2
     
     def _op_ld_nn_ptr_a(self) -> int:
@@ -2863,7 +2726,6 @@ class CPU:
         addr = self.fetch_word()
         a_value = self.registers.get_a()
         self.mmu.write_byte(addr, a_value)
-        logger.debug(f"LD (0x{addr:04X}), A -> (0x{addr:04X}) = 0x{a_value:02X}")
         return 4
     
     def _op_ld_a_nn_ptr(self) -> int:
@@ -2894,7 +2756,6 @@ class CPU:
         addr = self.fetch_word()
         value = self.mmu.read_byte(addr)
         self.registers.set_a(value)
-        logger.debug(f"LD A, (0x{addr:04X}) -> A = 0x{value:02X}")
         return 4
     
     # ========== Handlers de Incremento/Decremento ==========
@@ -2913,11 +2774,6 @@ class CPU:
         """
         new_value = self._inc_n(self.registers.get_b())
         self.registers.set_b(new_value)
-        logger.debug(
-            f"INC B -> B=0x{new_value:02X} "
-            f"Z={self.registers.get_flag_z()} N={self.registers.get_flag_n()} "
-            f"H={self.registers.get_flag_h()}"
-        )
         return 1
     
     def _op_dec_b(self) -> int:
@@ -2934,11 +2790,6 @@ class CPU:
         """
         new_value = self._dec_n(self.registers.get_b())
         self.registers.set_b(new_value)
-        logger.debug(
-            f"DEC B -> B=0x{new_value:02X} "
-            f"Z={self.registers.get_flag_z()} N={self.registers.get_flag_n()} "
-            f"H={self.registers.get_flag_h()}"
-        )
         return 1
     
     def _op_inc_c(self) -> int:
@@ -2955,11 +2806,6 @@ class CPU:
         """
         new_value = self._inc_n(self.registers.get_c())
         self.registers.set_c(new_value)
-        logger.debug(
-            f"INC C -> C=0x{new_value:02X} "
-            f"Z={self.registers.get_flag_z()} N={self.registers.get_flag_n()} "
-            f"H={self.registers.get_flag_h()}"
-        )
         return 1
     
     def _op_dec_c(self) -> int:
@@ -2976,11 +2822,6 @@ class CPU:
         """
         new_value = self._dec_n(self.registers.get_c())
         self.registers.set_c(new_value)
-        logger.debug(
-            f"DEC C -> C=0x{new_value:02X} "
-            f"Z={self.registers.get_flag_z()} N={self.registers.get_flag_n()} "
-            f"H={self.registers.get_flag_h()}"
-        )
         return 1
     
     def _op_inc_a(self) -> int:
@@ -2997,11 +2838,6 @@ class CPU:
         """
         new_value = self._inc_n(self.registers.get_a())
         self.registers.set_a(new_value)
-        logger.debug(
-            f"INC A -> A=0x{new_value:02X} "
-            f"Z={self.registers.get_flag_z()} N={self.registers.get_flag_n()} "
-            f"H={self.registers.get_flag_h()}"
-        )
         return 1
     
     def _op_dec_a(self) -> int:
@@ -3018,11 +2854,6 @@ class CPU:
         """
         new_value = self._dec_n(self.registers.get_a())
         self.registers.set_a(new_value)
-        logger.debug(
-            f"DEC A -> A=0x{new_value:02X} "
-            f"Z={self.registers.get_flag_z()} N={self.registers.get_flag_n()} "
-            f"H={self.registers.get_flag_h()}"
-        )
         return 1
     
     def _op_inc_d(self) -> int:
@@ -3039,11 +2870,6 @@ class CPU:
         """
         new_value = self._inc_n(self.registers.get_d())
         self.registers.set_d(new_value)
-        logger.debug(
-            f"INC D -> D=0x{new_value:02X} "
-            f"Z={self.registers.get_flag_z()} N={self.registers.get_flag_n()} "
-            f"H={self.registers.get_flag_h()}"
-        )
         return 1
     
     def _op_dec_d(self) -> int:
@@ -3060,11 +2886,6 @@ class CPU:
         """
         new_value = self._dec_n(self.registers.get_d())
         self.registers.set_d(new_value)
-        logger.debug(
-            f"DEC D -> D=0x{new_value:02X} "
-            f"Z={self.registers.get_flag_z()} N={self.registers.get_flag_n()} "
-            f"H={self.registers.get_flag_h()}"
-        )
         return 1
     
     def _op_inc_e(self) -> int:
@@ -3081,11 +2902,6 @@ class CPU:
         """
         new_value = self._inc_n(self.registers.get_e())
         self.registers.set_e(new_value)
-        logger.debug(
-            f"INC E -> E=0x{new_value:02X} "
-            f"Z={self.registers.get_flag_z()} N={self.registers.get_flag_n()} "
-            f"H={self.registers.get_flag_h()}"
-        )
         return 1
     
     def _op_dec_e(self) -> int:
@@ -3102,11 +2918,6 @@ class CPU:
         """
         new_value = self._dec_n(self.registers.get_e())
         self.registers.set_e(new_value)
-        logger.debug(
-            f"DEC E -> E=0x{new_value:02X} "
-            f"Z={self.registers.get_flag_z()} N={self.registers.get_flag_n()} "
-            f"H={self.registers.get_flag_h()}"
-        )
         return 1
     
     def _op_inc_h(self) -> int:
@@ -3123,11 +2934,6 @@ class CPU:
         """
         new_value = self._inc_n(self.registers.get_h())
         self.registers.set_h(new_value)
-        logger.debug(
-            f"INC H -> H=0x{new_value:02X} "
-            f"Z={self.registers.get_flag_z()} N={self.registers.get_flag_n()} "
-            f"H={self.registers.get_flag_h()}"
-        )
         return 1
     
     def _op_dec_h(self) -> int:
@@ -3144,11 +2950,6 @@ class CPU:
         """
         new_value = self._dec_n(self.registers.get_h())
         self.registers.set_h(new_value)
-        logger.debug(
-            f"DEC H -> H=0x{new_value:02X} "
-            f"Z={self.registers.get_flag_z()} N={self.registers.get_flag_n()} "
-            f"H={self.registers.get_flag_h()}"
-        )
         return 1
     
     def _op_inc_l(self) -> int:
@@ -3165,11 +2966,6 @@ class CPU:
         """
         new_value = self._inc_n(self.registers.get_l())
         self.registers.set_l(new_value)
-        logger.debug(
-            f"INC L -> L=0x{new_value:02X} "
-            f"Z={self.registers.get_flag_z()} N={self.registers.get_flag_n()} "
-            f"H={self.registers.get_flag_h()}"
-        )
         return 1
     
     def _op_dec_l(self) -> int:
@@ -3186,11 +2982,6 @@ class CPU:
         """
         new_value = self._dec_n(self.registers.get_l())
         self.registers.set_l(new_value)
-        logger.debug(
-            f"DEC L -> L=0x{new_value:02X} "
-            f"Z={self.registers.get_flag_z()} N={self.registers.get_flag_n()} "
-            f"H={self.registers.get_flag_h()}"
-        )
         return 1
     
     def _op_inc_hl_ptr(self) -> int:
@@ -3217,11 +3008,6 @@ class CPU:
         current_value = self.mmu.read_byte(hl_addr)
         new_value = self._inc_n(current_value)
         self.mmu.write_byte(hl_addr, new_value)
-        logger.debug(
-            f"INC (HL) -> (0x{hl_addr:04X}) = 0x{current_value:02X} -> 0x{new_value:02X} "
-            f"Z={self.registers.get_flag_z()} N={self.registers.get_flag_n()} "
-            f"H={self.registers.get_flag_h()}"
-        )
         return 3
     
     def _op_dec_hl_ptr(self) -> int:
@@ -3248,11 +3034,6 @@ class CPU:
         current_value = self.mmu.read_byte(hl_addr)
         new_value = self._dec_n(current_value)
         self.mmu.write_byte(hl_addr, new_value)
-        logger.debug(
-            f"DEC (HL) -> (0x{hl_addr:04X}) = 0x{current_value:02X} -> 0x{new_value:02X} "
-            f"Z={self.registers.get_flag_z()} N={self.registers.get_flag_n()} "
-            f"H={self.registers.get_flag_h()}"
-        )
         return 3
     
     # ========== Handlers de Rotaciones Rápidas del Acumulador ==========
@@ -3307,10 +3088,6 @@ class CPU:
         else:
             self.registers.clear_flag(FLAG_C)
         
-        logger.debug(
-            f"RLCA -> A=0x{a:02X} -> 0x{result:02X} "
-            f"C={self.registers.get_flag_c()}"
-        )
         return 1
     
     def _op_rrca(self) -> int:
@@ -3356,10 +3133,6 @@ class CPU:
         else:
             self.registers.clear_flag(FLAG_C)
         
-        logger.debug(
-            f"RRCA -> A=0x{a:02X} -> 0x{result:02X} "
-            f"C={self.registers.get_flag_c()}"
-        )
         return 1
     
     def _op_rla(self) -> int:
@@ -3412,10 +3185,6 @@ class CPU:
         else:
             self.registers.clear_flag(FLAG_C)
         
-        logger.debug(
-            f"RLA -> A=0x{a:02X} -> 0x{result:02X} "
-            f"C={self.registers.get_flag_c()} (old_carry={old_carry})"
-        )
         return 1
     
     def _op_rra(self) -> int:
@@ -3460,10 +3229,6 @@ class CPU:
         else:
             self.registers.clear_flag(FLAG_C)
         
-        logger.debug(
-            f"RRA -> A=0x{a:02X} -> 0x{result:02X} "
-            f"C={self.registers.get_flag_c()} (old_carry={old_carry})"
-        )
         return 1
     
     # ========== Handlers de I/O Access (LDH) ==========
@@ -3500,9 +3265,6 @@ class CPU:
         a_value = self.registers.get_a()
         self.mmu.write_byte(io_addr, a_value)
         
-        logger.debug(
-            f"LDH (0x{n:02X}), A -> (0x{io_addr:04X}) = 0x{a_value:02X}"
-        )
         return 3
     
     def _op_ldh_a_n(self) -> int:
@@ -3535,9 +3297,6 @@ class CPU:
         value = self.mmu.read_byte(io_addr)
         self.registers.set_a(value)
         
-        logger.debug(
-            f"LDH A, (0x{n:02X}) -> A = 0x{value:02X} from (0x{io_addr:04X})"
-        )
         return 3
     
     def _op_ld_c_a(self) -> int:
@@ -3572,9 +3331,6 @@ class CPU:
         a_value = self.registers.get_a()
         self.mmu.write_byte(io_addr, a_value)
         
-        logger.debug(
-            f"LD (C), A -> (0x{io_addr:04X}) = 0x{a_value:02X} [C=0x{c_value:02X}]"
-        )
         return 2
     
     def _op_ld_a_c(self) -> int:
@@ -3608,9 +3364,6 @@ class CPU:
         value = self.mmu.read_byte(io_addr)
         self.registers.set_a(value)
         
-        logger.debug(
-            f"LD A, (C) -> A = 0x{value:02X} from (0x{io_addr:04X}) [C=0x{c_value:02X}]"
-        )
         return 2
     
     # ========== Handlers del Prefijo CB (Extended Instructions) ==========
@@ -3646,8 +3399,6 @@ class CPU:
         # Leer el opcode CB (siguiente byte después de 0xCB)
         cb_opcode = self.fetch_byte()
         
-        logger.debug(f"CB Prefix -> CB Opcode=0x{cb_opcode:02X}")
-        
         # Buscar handler en la tabla CB
         handler = self._cb_opcode_table.get(cb_opcode)
         if handler is None:
@@ -3656,7 +3407,7 @@ class CPU:
             )
         
         # Ejecutar la instrucción CB
-        return handler()
+        return handler(self)
     
     def _bit(self, bit: int, value: int) -> None:
         """
@@ -3793,17 +3544,11 @@ class CPU:
         h_value = self.registers.get_h()
         self._bit(7, h_value)
         
-        logger.debug(
-            f"BIT 7, H -> H=0x{h_value:02X} "
-            f"Z={self.registers.get_flag_z()} "
-            f"H={self.registers.get_flag_h()} "
-            f"N={self.registers.get_flag_n()}"
-        )
         return 2
     
     # ========== Helpers para Operaciones CB (Rotaciones, Shifts, SWAP) ==========
     
-    def _cb_rlc(self, value: int) -> tuple[int, int]:
+    def _cb_rlc(self, value: int) -> int:
         """
         Rotate Left Circular - Helper genérico para CB RLC.
         
@@ -3818,9 +3563,8 @@ class CPU:
             value: Valor de 8 bits a rotar
             
         Returns:
-            Tupla (result, carry) donde:
-            - result: Valor rotado (8 bits)
-            - carry: 1 si bit 7 original era 1, 0 si era 0
+            Valor rotado (8 bits).
+            El bit 7 original (el carry) queda en self._cb_carry.
             
         Fuente: Pan Docs - CPU Instruction Set (RLC r)
         """
@@ -3832,9 +3576,10 @@ class CPU:
         # Rotar: (value << 1) | bit7, enmascarar a 8 bits
         result = ((value << 1) | bit7) & 0xFF
         
-        return (result, bit7)
+        self._cb_carry = bit7
+        return result
     
-    def _cb_rrc(self, value: int) -> tuple[int, int]:
+    def _cb_rrc(self, value: int) -> int:
         """
         Rotate Right Circular - Helper genérico para CB RRC.
         
@@ -3849,9 +3594,8 @@ class CPU:
             value: Valor de 8 bits a rotar
             
         Returns:
-            Tupla (result, carry) donde:
-            - result: Valor rotado (8 bits)
-            - carry: 1 si bit 0 original era 1, 0 si era 0
+            Valor rotado (8 bits).
+            El bit 0 original (el carry) queda en self._cb_carry.
             
         Fuente: Pan Docs - CPU Instruction Set (RRC r)
         """
@@ -3863,9 +3607,10 @@ class CPU:
         # Rotar: (value >> 1) | (bit0 << 7)
         result = ((value >> 1) | (bit0 << 7)) & 0xFF
         
-        return (result, bit0)
+        self._cb_carry = bit0
+        return result
     
-    def _cb_rl(self, value: int) -> tuple[int, int]:
+    def _cb_rl(self, value: int) -> int:
         """
         Rotate Left through Carry - Helper genérico para CB RL.
         
@@ -3881,9 +3626,8 @@ class CPU:
             value: Valor de 8 bits a rotar
             
         Returns:
-            Tupla (result, carry) donde:
-            - result: Valor rotado (8 bits)
-            - carry: 1 si bit 7 original era 1, 0 si era 0
+            Valor rotado (8 bits).
+            El bit 7 original (el carry) queda en self._cb_carry.
             
         Fuente: Pan Docs - CPU Instruction Set (RL r)
         """
@@ -3898,9 +3642,10 @@ class CPU:
         # Rotar: (value << 1) | old_carry, enmascarar a 8 bits
         result = ((value << 1) | old_carry) & 0xFF
         
-        return (result, bit7)
+        self._cb_carry = bit7
+        return result
     
-    def _cb_rr(self, value: int) -> tuple[int, int]:
+    def _cb_rr(self, value: int) -> int:
         """
         Rotate Right through Carry - Helper genérico para CB RR.
         
@@ -3916,9 +3661,8 @@ class CPU:
             value: Valor de 8 bits a rotar
             
         Returns:
-            Tupla (result, carry) donde:
-            - result: Valor rotado (8 bits)
-            - carry: 1 si bit 0 original era 1, 0 si era 0
+            Valor rotado (8 bits).
+            El bit 0 original (el carry) queda en self._cb_carry.
             
         Fuente: Pan Docs - CPU Instruction Set (RR r)
         """
@@ -3933,9 +3677,10 @@ class CPU:
         # Rotar: (value >> 1) | (old_carry << 7)
         result = ((value >> 1) | (old_carry << 7)) & 0xFF
         
-        return (result, bit0)
+        self._cb_carry = bit0
+        return result
     
-    def _cb_sla(self, value: int) -> tuple[int, int]:
+    def _cb_sla(self, value: int) -> int:
         """
         Shift Left Arithmetic - Helper genérico para CB SLA.
         
@@ -3955,9 +3700,8 @@ class CPU:
             value: Valor de 8 bits a desplazar
             
         Returns:
-            Tupla (result, carry) donde:
-            - result: Valor desplazado (8 bits)
-            - carry: 1 si bit 7 original era 1, 0 si era 0
+            Valor desplazado (8 bits).
+            El bit 7 original (el carry) queda en self._cb_carry.
             
         Fuente: Pan Docs - CPU Instruction Set (SLA r)
         """
@@ -3969,9 +3713,10 @@ class CPU:
         # Desplazar: (value << 1), bit 0 entra 0
         result = (value << 1) & 0xFF
         
-        return (result, bit7)
+        self._cb_carry = bit7
+        return result
     
-    def _cb_sra(self, value: int) -> tuple[int, int]:
+    def _cb_sra(self, value: int) -> int:
         """
         Shift Right Arithmetic - Helper genérico para CB SRA.
         
@@ -3996,9 +3741,8 @@ class CPU:
             value: Valor de 8 bits a desplazar
             
         Returns:
-            Tupla (result, carry) donde:
-            - result: Valor desplazado (8 bits, signo preservado)
-            - carry: 1 si bit 0 original era 1, 0 si era 0
+            Valor desplazado (8 bits, signo preservado).
+            El bit 0 original (el carry) queda en self._cb_carry.
             
         Fuente: Pan Docs - CPU Instruction Set (SRA r)
         """
@@ -4013,9 +3757,10 @@ class CPU:
         # Desplazar: (value >> 1) | (bit7 << 7)
         result = ((value >> 1) | (bit7 << 7)) & 0xFF
         
-        return (result, bit0)
+        self._cb_carry = bit0
+        return result
     
-    def _cb_srl(self, value: int) -> tuple[int, int]:
+    def _cb_srl(self, value: int) -> int:
         """
         Shift Right Logical - Helper genérico para CB SRL.
         
@@ -4040,9 +3785,8 @@ class CPU:
             value: Valor de 8 bits a desplazar
             
         Returns:
-            Tupla (result, carry) donde:
-            - result: Valor desplazado (8 bits, bit 7 = 0)
-            - carry: 1 si bit 0 original era 1, 0 si era 0
+            Valor desplazado (8 bits, bit 7 = 0).
+            El bit 0 original (el carry) queda en self._cb_carry.
             
         Fuente: Pan Docs - CPU Instruction Set (SRL r)
         """
@@ -4054,9 +3798,10 @@ class CPU:
         # Desplazar: (value >> 1), bit 7 entra 0
         result = (value >> 1) & 0xFF
         
-        return (result, bit0)
+        self._cb_carry = bit0
+        return result
     
-    def _cb_swap(self, value: int) -> tuple[int, int]:
+    def _cb_swap(self, value: int) -> int:
         """
         SWAP - Helper genérico para CB SWAP.
         
@@ -4076,9 +3821,8 @@ class CPU:
             value: Valor de 8 bits a intercambiar
             
         Returns:
-            Tupla (result, carry) donde:
-            - result: Valor con nibbles intercambiados (8 bits)
-            - carry: Siempre 0 (SWAP no genera carry)
+            Valor con nibbles intercambiados (8 bits).
+            SWAP no genera carry: self._cb_carry queda a 0.
             
         Fuente: Pan Docs - CPU Instruction Set (SWAP r)
         """
@@ -4091,7 +3835,8 @@ class CPU:
         # Intercambiar: low_nibble va arriba, high_nibble va abajo
         result = ((low_nibble << 4) | high_nibble) & 0xFF
         
-        return (result, 0)
+        self._cb_carry = 0
+        return result
     
     def _cb_get_register_value(self, reg_index: int) -> int:
         """
@@ -4209,7 +3954,8 @@ class CPU:
         else:
             self.registers.clear_flag(FLAG_C)
     
-    def _init_cb_shifts_table(self) -> None:
+    @classmethod
+    def _init_cb_shifts_table(cls) -> None:
         """
         Inicializa la tabla CB para el rango 0x00-0x3F (rotaciones y shifts).
         
@@ -4239,14 +3985,14 @@ class CPU:
         """
         # Operaciones en orden
         operations = [
-            (self._cb_rlc, "RLC"),
-            (self._cb_rrc, "RRC"),
-            (self._cb_rl, "RL"),
-            (self._cb_rr, "RR"),
-            (self._cb_sla, "SLA"),
-            (self._cb_sra, "SRA"),
-            (self._cb_srl, "SRL"),
-            (self._cb_swap, "SWAP"),
+            (cls._cb_rlc, "RLC"),
+            (cls._cb_rrc, "RRC"),
+            (cls._cb_rl, "RL"),
+            (cls._cb_rr, "RR"),
+            (cls._cb_sla, "SLA"),
+            (cls._cb_sra, "SRA"),
+            (cls._cb_srl, "SRL"),
+            (cls._cb_swap, "SWAP"),
         ]
         
         # Generar handlers para cada combinación operación x registro
@@ -4257,37 +4003,31 @@ class CPU:
                 # Crear handler específico para esta combinación
                 # IMPORTANTE: Capturar valores por defecto para evitar problemas de closure
                 def make_handler(op_func=op_func, op_name=op_name, reg_index=reg_index, cb_opcode=cb_opcode):
-                    def handler() -> int:
+                    def handler(cpu: CPU) -> int:
                         # Leer valor del registro/memoria
-                        value = self._cb_get_register_value(reg_index)
+                        value = cpu._cb_get_register_value(reg_index)
                         
-                        # Ejecutar operación
-                        result, carry = op_func(value)
+                        # Ejecutar operación (el bit que sale queda en cpu._cb_carry)
+                        result = op_func(cpu, value)
                         
                         # Escribir resultado
-                        self._cb_set_register_value(reg_index, result)
+                        cpu._cb_set_register_value(reg_index, result)
                         
                         # Actualizar flags
-                        self._cb_update_flags(result, carry)
+                        cpu._cb_update_flags(result, cpu._cb_carry)
                         
                         # Timing: (HL) consume 4 M-Cycles, registros consumen 2
                         cycles = 4 if reg_index == 6 else 2
                         
-                        reg_name = ["B", "C", "D", "E", "H", "L", "(HL)", "A"][reg_index]
-                        logger.debug(
-                            f"CB 0x{cb_opcode:02X} ({op_name} {reg_name}) -> "
-                            f"0x{value:02X} -> 0x{result:02X} "
-                            f"Z={self.registers.get_flag_z()} C={self.registers.get_flag_c()}"
-                        )
-                        
                         return cycles
                     
                     return handler
                 
                 # Añadir handler a la tabla
-                self._cb_opcode_table[cb_opcode] = make_handler()
+                cls._cb_opcode_table[cb_opcode] = make_handler()
     
-    def _init_cb_bit_res_set_table(self) -> None:
+    @classmethod
+    def _init_cb_bit_res_set_table(cls) -> None:
         """
         Inicializa la tabla CB para el rango 0x40-0xFF (BIT, RES, SET).
         
@@ -4322,8 +4062,6 @@ class CPU:
         
         Fuente: Pan Docs - CPU Instruction Set (CB Prefix encoding)
         """
-        # Nombres de registros para logging
-        reg_names = ["B", "C", "D", "E", "H", "L", "(HL)", "A"]
         
         # Generar handlers para BIT (0x40-0x7F)
         for bit in range(8):
@@ -4331,29 +4069,22 @@ class CPU:
                 cb_opcode = 0x40 + (bit * 8) + reg_index
                 
                 def make_bit_handler(bit=bit, reg_index=reg_index, cb_opcode=cb_opcode):
-                    def handler() -> int:
+                    def handler(cpu: CPU) -> int:
                         # Leer valor del registro/memoria
-                        value = self._cb_get_register_value(reg_index)
+                        value = cpu._cb_get_register_value(reg_index)
                         
                         # Ejecutar BIT (actualiza flags, no modifica el valor)
-                        self._bit(bit, value)
+                        cpu._bit(bit, value)
                         
                         # Timing: (HL) consume 4 M-Cycles, registros consumen 2
                         cycles = 4 if reg_index == 6 else 2
                         
-                        reg_name = reg_names[reg_index]
-                        logger.debug(
-                            f"CB 0x{cb_opcode:02X} (BIT {bit}, {reg_name}) -> "
-                            f"0x{value:02X} bit{bit}={1 if (value >> bit) & 1 else 0} "
-                            f"Z={self.registers.get_flag_z()} H={self.registers.get_flag_h()}"
-                        )
-                        
                         return cycles
                     
                     return handler
                 
                 # Añadir handler a la tabla (sobrescribe el manual si existe)
-                self._cb_opcode_table[cb_opcode] = make_bit_handler()
+                cls._cb_opcode_table[cb_opcode] = make_bit_handler()
         
         # Generar handlers para RES (0x80-0xBF)
         for bit in range(8):
@@ -4361,31 +4092,25 @@ class CPU:
                 cb_opcode = 0x80 + (bit * 8) + reg_index
                 
                 def make_res_handler(bit=bit, reg_index=reg_index, cb_opcode=cb_opcode):
-                    def handler() -> int:
+                    def handler(cpu: CPU) -> int:
                         # Leer valor del registro/memoria
-                        value = self._cb_get_register_value(reg_index)
+                        value = cpu._cb_get_register_value(reg_index)
                         
                         # Ejecutar RES (apaga el bit)
-                        result = self._cb_res(bit, value)
+                        result = cpu._cb_res(bit, value)
                         
                         # Escribir resultado
-                        self._cb_set_register_value(reg_index, result)
+                        cpu._cb_set_register_value(reg_index, result)
                         
                         # Timing: (HL) consume 4 M-Cycles, registros consumen 2
                         cycles = 4 if reg_index == 6 else 2
                         
-                        reg_name = reg_names[reg_index]
-                        logger.debug(
-                            f"CB 0x{cb_opcode:02X} (RES {bit}, {reg_name}) -> "
-                            f"0x{value:02X} -> 0x{result:02X}"
-                        )
-                        
                         return cycles
                     
                     return handler
                 
                 # Añadir handler a la tabla
-                self._cb_opcode_table[cb_opcode] = make_res_handler()
+                cls._cb_opcode_table[cb_opcode] = make_res_handler()
         
         # Generar handlers para SET (0xC0-0xFF)
         for bit in range(8):
@@ -4393,31 +4118,25 @@ class CPU:
                 cb_opcode = 0xC0 + (bit * 8) + reg_index
                 
                 def make_set_handler(bit=bit, reg_index=reg_index, cb_opcode=cb_opcode):
-                    def handler() -> int:
+                    def handler(cpu: CPU) -> int:
                         # Leer valor del registro/memoria
-                        value = self._cb_get_register_value(reg_index)
+                        value = cpu._cb_get_register_value(reg_index)
                         
                         # Ejecutar SET (enciende el bit)
-                        result = self._cb_set(bit, value)
+                        result = cpu._cb_set(bit, value)
                         
                         # Escribir resultado
-                        self._cb_set_register_value(reg_index, result)
+                        cpu._cb_set_register_value(reg_index, result)
                         
                         # Timing: (HL) consume 4 M-Cycles, registros consumen 2
                         cycles = 4 if reg_index == 6 else 2
                         
-                        reg_name = reg_names[reg_index]
-                        logger.debug(
-                            f"CB 0x{cb_opcode:02X} (SET {bit}, {reg_name}) -> "
-                            f"0x{value:02X} -> 0x{result:02X}"
-                        )
-                        
                         return cycles
                     
                     return handler
                 
                 # Añadir handler a la tabla
-                self._cb_opcode_table[cb_opcode] = make_set_handler()
+                cls._cb_opcode_table[cb_opcode] = make_set_handler()
     
     # ========== Handlers de Comparación (CP) ==========
     
@@ -4446,11 +4165,6 @@ class CPU:
         """
         operand = self.fetch_byte()
         self._cp(operand)
-        logger.debug(
-            f"CP 0x{operand:02X} -> A=0x{self.registers.get_a():02X} "
-            f"Z={self.registers.get_flag_z()} N={self.registers.get_flag_n()} "
-            f"H={self.registers.get_flag_h()} C={self.registers.get_flag_c()}"
-        )
         return 2
     
     def _op_cp_hl_ptr(self) -> int:
@@ -4479,11 +4193,6 @@ class CPU:
         hl_addr = self.registers.get_hl()
         value = self.mmu.read_byte(hl_addr)
         self._cp(value)
-        logger.debug(
-            f"CP (HL) -> A=0x{self.registers.get_a():02X} (HL)=0x{value:02X} "
-            f"Z={self.registers.get_flag_z()} N={self.registers.get_flag_n()} "
-            f"H={self.registers.get_flag_h()} C={self.registers.get_flag_c()}"
-        )
         return 2
 
     # ========== Handlers de Incremento/Decremento de 16 bits ==========
@@ -4508,7 +4217,6 @@ class CPU:
         current_bc = self.registers.get_bc()
         new_bc = (current_bc + 1) & 0xFFFF
         self.registers.set_bc(new_bc)
-        logger.debug(f"INC BC -> BC=0x{current_bc:04X} -> 0x{new_bc:04X}")
         return 2
     
     def _op_inc_de(self) -> int:
@@ -4526,7 +4234,6 @@ class CPU:
         current_de = self.registers.get_de()
         new_de = (current_de + 1) & 0xFFFF
         self.registers.set_de(new_de)
-        logger.debug(f"INC DE -> DE=0x{current_de:04X} -> 0x{new_de:04X}")
         return 2
     
     def _op_inc_hl(self) -> int:
@@ -4544,7 +4251,6 @@ class CPU:
         current_hl = self.registers.get_hl()
         new_hl = (current_hl + 1) & 0xFFFF
         self.registers.set_hl(new_hl)
-        logger.debug(f"INC HL -> HL=0x{current_hl:04X} -> 0x{new_hl:04X}")
         return 2
     
     def _op_inc_sp(self) -> int:
@@ -4562,7 +4268,6 @@ class CPU:
         current_sp = self.registers.get_sp()
         new_sp = (current_sp + 1) & 0xFFFF
         self.registers.set_sp(new_sp)
-        logger.debug(f"INC SP -> SP=0x{current_sp:04X} -> 0x{new_sp:04X}")
         return 2
     
     def _op_dec_bc(self) -> int:
@@ -4585,7 +4290,6 @@ class CPU:
         current_bc = self.registers.get_bc()
         new_bc = (current_bc - 1) & 0xFFFF
         self.registers.set_bc(new_bc)
-        logger.debug(f"DEC BC -> BC=0x{current_bc:04X} -> 0x{new_bc:04X}")
         return 2
     
     def _op_dec_de(self) -> int:
@@ -4603,7 +4307,6 @@ class CPU:
         current_de = self.registers.get_de()
         new_de = (current_de - 1) & 0xFFFF
         self.registers.set_de(new_de)
-        logger.debug(f"DEC DE -> DE=0x{current_de:04X} -> 0x{new_de:04X}")
         return 2
     
     def _op_dec_hl(self) -> int:
@@ -4621,7 +4324,6 @@ class CPU:
         current_hl = self.registers.get_hl()
         new_hl = (current_hl - 1) & 0xFFFF
         self.registers.set_hl(new_hl)
-        logger.debug(f"DEC HL -> HL=0x{current_hl:04X} -> 0x{new_hl:04X}")
         return 2
     
     def _op_dec_sp(self) -> int:
@@ -4639,7 +4341,6 @@ class CPU:
         current_sp = self.registers.get_sp()
         new_sp = (current_sp - 1) & 0xFFFF
         self.registers.set_sp(new_sp)
-        logger.debug(f"DEC SP -> SP=0x{current_sp:04X} -> 0x{new_sp:04X}")
         return 2
 
     # ========== Handlers de Aritmética de 16 bits (ADD HL, rr) ==========
@@ -4708,13 +4409,7 @@ class CPU:
         Fuente: Pan Docs - Instruction Set (ADD HL, BC)
         """
         bc_value = self.registers.get_bc()
-        old_hl = self.registers.get_hl()
         self._add_hl_16bit(bc_value)
-        new_hl = self.registers.get_hl()
-        logger.debug(
-            f"ADD HL, BC -> HL=0x{old_hl:04X} + BC=0x{bc_value:04X} = 0x{new_hl:04X} "
-            f"H={self.registers.get_flag_h()} C={self.registers.get_flag_c()}"
-        )
         return 2
     
     def _op_add_hl_de(self) -> int:
@@ -4731,13 +4426,7 @@ class CPU:
         Fuente: Pan Docs - Instruction Set (ADD HL, DE)
         """
         de_value = self.registers.get_de()
-        old_hl = self.registers.get_hl()
         self._add_hl_16bit(de_value)
-        new_hl = self.registers.get_hl()
-        logger.debug(
-            f"ADD HL, DE -> HL=0x{old_hl:04X} + DE=0x{de_value:04X} = 0x{new_hl:04X} "
-            f"H={self.registers.get_flag_h()} C={self.registers.get_flag_c()}"
-        )
         return 2
     
     def _op_add_hl_hl(self) -> int:
@@ -4754,13 +4443,7 @@ class CPU:
         Fuente: Pan Docs - Instruction Set (ADD HL, HL)
         """
         hl_value = self.registers.get_hl()
-        old_hl = hl_value
         self._add_hl_16bit(hl_value)
-        new_hl = self.registers.get_hl()
-        logger.debug(
-            f"ADD HL, HL -> HL=0x{old_hl:04X} * 2 = 0x{new_hl:04X} "
-            f"H={self.registers.get_flag_h()} C={self.registers.get_flag_c()}"
-        )
         return 2
     
     def _op_add_hl_sp(self) -> int:
@@ -4777,13 +4460,7 @@ class CPU:
         Fuente: Pan Docs - Instruction Set (ADD HL, SP)
         """
         sp_value = self.registers.get_sp()
-        old_hl = self.registers.get_hl()
         self._add_hl_16bit(sp_value)
-        new_hl = self.registers.get_hl()
-        logger.debug(
-            f"ADD HL, SP -> HL=0x{old_hl:04X} + SP=0x{sp_value:04X} = 0x{new_hl:04X} "
-            f"H={self.registers.get_flag_h()} C={self.registers.get_flag_c()}"
-        )
         return 2
 
     # ========== Handlers de Aritmética de Pila con Offset (SP+r8) ==========
@@ -4861,7 +4538,6 @@ class CPU:
         Fuente: Pan Docs - Instruction Set (ADD SP, r8)
         """
         offset = self._read_signed_byte()
-        old_sp = self.registers.get_sp()
         
         # Calcular nuevo SP y flags
         new_sp, h_flag, c_flag = self._add_sp_offset(offset)
@@ -4885,10 +4561,6 @@ class CPU:
         else:
             self.registers.clear_flag(FLAG_C)
         
-        logger.debug(
-            f"ADD SP, {offset:+d} -> SP=0x{old_sp:04X} + {offset:+d} = 0x{new_sp:04X} "
-            f"H={h_flag} C={c_flag}"
-        )
         return 4
     
     def _op_ld_hl_sp_r8(self) -> int:
@@ -4914,7 +4586,6 @@ class CPU:
         Fuente: Pan Docs - Instruction Set (LD HL, SP+r8)
         """
         offset = self._read_signed_byte()
-        sp = self.registers.get_sp()
         
         # Calcular HL = SP + offset y flags
         hl_value, h_flag, c_flag = self._add_sp_offset(offset)
@@ -4938,10 +4609,6 @@ class CPU:
         else:
             self.registers.clear_flag(FLAG_C)
         
-        logger.debug(
-            f"LD HL, SP{offset:+d} -> HL=0x{hl_value:04X} (SP=0x{sp:04X} no cambia) "
-            f"H={h_flag} C={c_flag}"
-        )
         return 3
 
     def _op_ld_sp_hl(self) -> int:
@@ -4970,7 +4637,6 @@ class CPU:
         hl_value = self.registers.get_hl()
         self.registers.set_sp(hl_value)
         
-        logger.debug(f"LD SP, HL -> SP=0x{hl_value:04X} (HL=0x{hl_value:04X})")
         return 2
 
     # ========== Handlers de Retornos Condicionales ==========
@@ -4999,13 +4665,9 @@ class CPU:
             # Condición verdadera: retornar
             return_addr = self._pop_word()
             self.registers.set_pc(return_addr)
-            logger.debug(
-                f"RET NZ (TAKEN) -> PC=0x{return_addr:04X} (SP=0x{self.registers.get_sp():04X})"
-            )
             return 5  # 5 M-Cycles cuando se toma el retorno
         else:
             # Condición falsa: no retornar
-            logger.debug("RET NZ (NOT TAKEN) Z flag set")
             return 2  # 2 M-Cycles cuando no se toma el retorno
     
     def _op_ret_z(self) -> int:
@@ -5023,13 +4685,9 @@ class CPU:
             # Condición verdadera: retornar
             return_addr = self._pop_word()
             self.registers.set_pc(return_addr)
-            logger.debug(
-                f"RET Z (TAKEN) -> PC=0x{return_addr:04X} (SP=0x{self.registers.get_sp():04X})"
-            )
             return 5
         else:
             # Condición falsa: no retornar
-            logger.debug("RET Z (NOT TAKEN) Z flag not set")
             return 2
     
     def _op_ret_nc(self) -> int:
@@ -5047,13 +4705,9 @@ class CPU:
             # Condición verdadera: retornar
             return_addr = self._pop_word()
             self.registers.set_pc(return_addr)
-            logger.debug(
-                f"RET NC (TAKEN) -> PC=0x{return_addr:04X} (SP=0x{self.registers.get_sp():04X})"
-            )
             return 5
         else:
             # Condición falsa: no retornar
-            logger.debug("RET NC (NOT TAKEN) C flag set")
             return 2
     
     def _op_ret_c(self) -> int:
@@ -5071,13 +4725,9 @@ class CPU:
             # Condición verdadera: retornar
             return_addr = self._pop_word()
             self.registers.set_pc(return_addr)
-            logger.debug(
-                f"RET C (TAKEN) -> PC=0x{return_addr:04X} (SP=0x{self.registers.get_sp():04X})"
-            )
             return 5
         else:
             # Condición falsa: no retornar
-            logger.debug("RET C (NOT TAKEN) C flag not set")
             return 2
     
     # ========== Helpers para Transferencias LD r, r' ==========
@@ -5182,32 +4832,10 @@ class CPU:
         # Establecer valor en el destino
         self._set_register_value(dest_code, src_value)
         
-        # Determinar timing según si hay acceso a memoria
-        if dest_code == 6 or src_code == 6:  # (HL) está involucrado
-            cycles = 2
-            dest_name = "(HL)" if dest_code == 6 else self._get_register_name(dest_code)
-            src_name = "(HL)" if src_code == 6 else self._get_register_name(src_code)
-            logger.debug(f"LD {dest_name}, {src_name} -> {dest_name}=0x{src_value:02X} (2 M-Cycles)")
-        else:
-            cycles = 1
-            dest_name = self._get_register_name(dest_code)
-            src_name = self._get_register_name(src_code)
-            logger.debug(f"LD {dest_name}, {src_name} -> {dest_name}=0x{src_value:02X} (1 M-Cycle)")
-        
-        return cycles
-    
-    def _get_register_name(self, reg_code: int) -> str:
-        """
-        Obtiene el nombre legible de un registro según su código.
-        
-        Args:
-            reg_code: Código del registro (0-7)
-            
-        Returns:
-            Nombre del registro (ej: "B", "C", "(HL)", "A")
-        """
-        names = ["B", "C", "D", "E", "H", "L", "(HL)", "A"]
-        return names[reg_code]
+        # Timing: 2 M-Cycles si (HL) está involucrado (acceso a memoria), 1 si no
+        if dest_code == 6 or src_code == 6:
+            return 2
+        return 1
     
     # ========== Handlers de Transferencias LD r, r' (Bloque 0x40-0x7F) ==========
     
@@ -5234,7 +4862,29 @@ class CPU:
         Fuente: Pan Docs - CPU Instruction Set (HALT)
         """
         self.halted = True
-        logger.debug("HALT -> CPU en modo de bajo consumo (halted=True)")
+        return 1
+    
+    def _op_stop(self) -> int:
+        """
+        STOP - Opcode 0x10 (0x10 0x00)
+        
+        Ocupa 2 bytes: el segundo (normalmente 0x00) se lee y se descarta.
+        
+        - En CGB, si KEY1 (0xFF4D) tiene el bit 0 armado, STOP realiza el cambio
+          de velocidad (normal <-> doble) y la ejecución continúa en la siguiente
+          instrucción (ver MMU.speed_switch()).
+        - En otro caso la CPU entra en modo de muy bajo consumo hasta que se pulsa
+          un botón. Se aproxima con el estado HALT: la pulsación solicita la
+          interrupción Joypad, que despierta a la CPU.
+        
+        Returns:
+            1 M-Cycle
+            
+        Fuente: Pan Docs - CPU Instruction Set (STOP), CGB Registers (FF4D - KEY1)
+        """
+        self.fetch_byte()
+        if not self.mmu.speed_switch():
+            self.halted = True
         return 1
     
     # ========== Instrucciones Misceláneas (DAA, CPL, SCF, CCF, RST) ==========
@@ -5321,10 +4971,6 @@ class CPU:
         else:
             self.registers.clear_flag(FLAG_C)
         
-        logger.debug(
-            f"DAA: A=0x{a:02X} -> 0x{result:02X} "
-            f"(correction={correction:+d}, N={n_flag}, C={new_c})"
-        )
         return 1
     
     def _op_cpl(self) -> int:
@@ -5355,7 +5001,6 @@ class CPU:
         self.registers.set_flag(FLAG_N)
         self.registers.set_flag(FLAG_H)
         
-        logger.debug(f"CPL: A=0x{a:02X} -> 0x{result:02X} (complemento)")
         return 1
     
     def _op_scf(self) -> int:
@@ -5382,7 +5027,6 @@ class CPU:
         self.registers.clear_flag(FLAG_N)
         self.registers.clear_flag(FLAG_H)
         
-        logger.debug("SCF: C=1, N=0, H=0")
         return 1
     
     def _op_ccf(self) -> int:
@@ -5412,8 +5056,6 @@ class CPU:
         self.registers.clear_flag(FLAG_N)
         self.registers.clear_flag(FLAG_H)
         
-        new_c = self.registers.check_flag(FLAG_C)
-        logger.debug(f"CCF: C={new_c}, N=0, H=0")
         return 1
     
     def _rst(self, vector: int) -> int:
@@ -5459,7 +5101,6 @@ class CPU:
         # Saltar al vector
         self.registers.set_pc(vector)
         
-        logger.debug(f"RST 0x{vector:02X}h: PC=0x{return_addr:04X} -> 0x{vector:04X}")
         return 4
     
     def _op_rst_00(self) -> int:
@@ -5494,3 +5135,6 @@ class CPU:
         """RST 38h - Opcode 0xFF"""
         return self._rst(0x0038)
 
+
+# Tablas de despacho compartidas: se construyen una vez, con la clase ya definida
+CPU._build_dispatch_tables()
@@ -0,0 +1,22 @@
+"""
+Módulo de depuración
+
+Contiene las herramientas para detener y examinar la emulación:
+- DebugController: Breakpoints de PC (con banco), watchpoints y paradas condicionales
+- GDBStub: Servidor del protocolo remoto de GDB (RSP) sobre localhost o socket Unix
+- SharedStateExporter/SharedStateReader: Estado publicado en memoria compartida (seqlock)
+"""
+
+from .controller import DebugBreak, DebugController, StopReason
+from .gdb_stub import GDBStub
+from .state_export import SharedStateExporter, SharedStateReader, StateSnapshot
+
+__all__ = [
+    "DebugBreak",
+    "DebugController",
+    "GDBStub",
+    "SharedStateExporter",
+    "SharedStateReader",
+    "StateSnapshot",
+    "StopReason",
+]
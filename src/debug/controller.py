@@ -0,0 +1,459 @@
+"""
+DebugController - Breakpoints, Watchpoints y Paradas Condicionales
+
+Un depurador necesita detener la emulación en puntos concretos:
+- Breakpoints de PC: parar antes de ejecutar la instrucción en una dirección.
+  Como 0x4000-0x7FFF es una ventana a un banco ROM conmutable (MBC), la misma
+  dirección puede contener código distinto según el banco mapeado, así que los
+  breakpoints pueden calificarse con el banco (p.ej. "banco 3, 0x4A10").
+- Watchpoints de memoria: parar cuando la CPU lee o escribe una dirección.
+- Condiciones sobre registros: parar cuando se cumple un predicado (p.ej. A == 0x42).
+- Step / Step-over (saltar por encima de CALL/RST) / Step-out (hasta el RET
+  que abandona la subrutina actual).
+
+Coste cero cuando no se usa: el bucle normal llama a CPU.step() sin ninguna
+comprobación. Solo mientras haya algo armado, el controlador sustituye el step
+de la instancia de CPU por una versión instrumentada (atributo de instancia que
+oculta el método de clase) y, si hay watchpoints, la referencia cpu.mmu por un
+proxy que vigila los accesos. Al desarmar todo se restauran los originales.
+
+Los breakpoints de PC se comprueban contra un bitset de 64K bits (8 KiB): una
+operación AND por instrucción; el banco solo se consulta si el bit está activo.
+
+Las paradas se producen siempre en frontera de instrucción: si la condición se
+detecta tras ejecutar una instrucción (watchpoint, condición, step), la parada se
+difiere al inicio del siguiente step, para que PPU y Timer ya hayan avanzado los
+ciclos de la instrucción ejecutada.
+
+Fuente: Pan Docs - Memory Map, MBC1; CPU Instruction Set (CALL, RST, RET)
+"""
+
+from __future__ import annotations
+
+import logging
+from dataclasses import dataclass
+from typing import TYPE_CHECKING, Callable
+
+if TYPE_CHECKING:
+    from ..cpu.core import CPU
+    from ..cpu.registers import Registers
+    from ..memory.cartridge import Cartridge
+    from ..memory.mmu import MMU
+    from ..viboy import Viboy
+
+logger = logging.getLogger(__name__)
+
+# Opcodes de llamada y su longitud en bytes (para step-over)
+# CALL nn / CALL cc,nn: 3 bytes; RST n: 1 byte
+CALL_OPCODE_LENGTHS: dict[int, int] = {
+    0xCD: 3, 0xC4: 3, 0xCC: 3, 0xD4: 3, 0xDC: 3,
+    0xC7: 1, 0xCF: 1, 0xD7: 1, 0xDF: 1, 0xE7: 1, 0xEF: 1, 0xF7: 1, 0xFF: 1,
+}
+
+# Opcodes de retorno: RET, RETI, RET cc
+RET_OPCODES = frozenset((0xC9, 0xD9, 0xC0, 0xC8, 0xD0, 0xD8))
+
+# Marcador de "cualquier banco" para breakpoints sin calificar
+ANY_BANK = -1
+
+
+@dataclass(frozen=True)
+class StopReason:
+    """
+    Motivo de una parada del depurador.
+
+    Attributes:
+        kind: "breakpoint", "watch_read", "watch_write", "condition", "step" o "step_out"
+        pc: PC en el momento de la parada (siguiente instrucción a ejecutar)
+        addr: Dirección de memoria implicada (watchpoints)
+        value: Valor leído/escrito (watchpoints)
+        description: Texto descriptivo (condiciones)
+    """
+
+    kind: str
+    pc: int
+    addr: int | None = None
+    value: int | None = None
+    description: str = ""
+
+
+class DebugBreak(Exception):
+    """Excepción que interrumpe el bucle de emulación al alcanzar una parada."""
+
+    def __init__(self, reason: StopReason) -> None:
+        super().__init__(f"{reason.kind} en PC=0x{reason.pc:04X}")
+        self.reason = reason
+
+
+class WatchMMU:
+    """
+    Proxy de MMU que vigila lecturas/escrituras de la CPU.
+
+    Solo se instala en cpu.mmu mientras haya watchpoints armados. El resto de
+    componentes (PPU, Renderer, Timer) siguen usando la MMU real.
+    """
+
+    def __init__(self, mmu: MMU, controller: DebugController) -> None:
+        self._mmu = mmu
+        self._controller = controller
+        self._read_flags = controller._watch_read
+        self._write_flags = controller._watch_write
+
+    def __getattr__(self, name: str):
+        """Delega todo lo no interceptado a la MMU real."""
+        return getattr(self._mmu, name)
+
+    def read_byte(self, addr: int) -> int:
+        value = self._mmu.read_byte(addr)
+        if self._read_flags[addr & 0xFFFF]:
+            self._controller._on_watch("watch_read", addr & 0xFFFF, value)
+        return value
+
+    def write_byte(self, addr: int, value: int) -> None:
+        if self._write_flags[addr & 0xFFFF]:
+            self._controller._on_watch("watch_write", addr & 0xFFFF, value & 0xFF)
+        self._mmu.write_byte(addr, value)
+
+    def read_word(self, addr: int) -> int:
+        lsb = self.read_byte(addr)
+        msb = self.read_byte((addr + 1) & 0xFFFF)
+        return (msb << 8) | lsb
+
+    def write_word(self, addr: int, value: int) -> None:
+        self.write_byte(addr, value & 0xFF)
+        self.write_byte((addr + 1) & 0xFFFF, (value >> 8) & 0xFF)
+
+
+class DebugController:
+    """
+    Controlador de depuración para una instancia de Viboy.
+
+    Uso típico:
+        dbg = DebugController(viboy)
+        dbg.add_breakpoint(0x0150)
+        dbg.add_watchpoint(0xC000, write=True)
+        reason = dbg.cont()          # ejecuta hasta la siguiente parada
+        dbg.step_over()
+    """
+
+    def __init__(self, viboy: Viboy) -> None:
+        """
+        Args:
+            viboy: Sistema a depurar (debe estar inicializado)
+
+        Raises:
+            RuntimeError: Si el sistema no tiene CPU/MMU
+        """
+        cpu = viboy.get_cpu()
+        mmu = viboy.get_mmu()
+        if cpu is None or mmu is None:
+            raise RuntimeError("Sistema no inicializado. Llama a load_cartridge() primero.")
+        self._viboy = viboy
+        self._cpu: CPU = cpu
+        self._mmu: MMU = mmu
+        self._cartridge: Cartridge | None = viboy.get_cartridge()
+
+        # Bitset de 64K bits con las direcciones que tienen algún breakpoint
+        self._bp_bits = bytearray(0x10000 >> 3)
+        # Dirección -> bancos en los que parar (ANY_BANK = cualquiera)
+        self._bp_banks: dict[int, set[int]] = {}
+
+        # Flags por dirección para watchpoints (1 byte por dirección)
+        self._watch_read = bytearray(0x10000)
+        self._watch_write = bytearray(0x10000)
+        self._watch_count = 0
+        self._watch_mmu: WatchMMU | None = None
+
+        # Condiciones sobre registros: (descripción, predicado)
+        self._conditions: list[tuple[str, Callable[[Registers], bool]]] = []
+
+        # Estado temporal de step / step-over / step-out
+        self._steps_remaining = 0
+        self._temp_breakpoint: int | None = None
+        self._step_out_sp: int | None = None
+
+        # Parada detectada tras una instrucción, pendiente de lanzar
+        self._pending: StopReason | None = None
+        # PC en el que se paró por breakpoint (se ignora una vez al reanudar)
+        self._resume_pc: int | None = None
+
+        self.last_stop: StopReason | None = None
+
+    # ========== Breakpoints de PC ==========
+
+    def add_breakpoint(self, addr: int, bank: int | None = None) -> None:
+        """
+        Añade un breakpoint de PC.
+
+        Args:
+            addr: Dirección (0x0000-0xFFFF)
+            bank: Banco ROM en el que parar (solo relevante en 0x4000-0x7FFF).
+                  None = cualquier banco.
+        """
+        addr &= 0xFFFF
+        self._bp_banks.setdefault(addr, set()).add(ANY_BANK if bank is None else bank)
+        self._bp_bits[addr >> 3] |= 1 << (addr & 7)
+        self._update_dispatch()
+
+    def remove_breakpoint(self, addr: int, bank: int | None = None) -> None:
+        """Elimina un breakpoint de PC (no hace nada si no existe)."""
+        addr &= 0xFFFF
+        banks = self._bp_banks.get(addr)
+        if banks is None:
+            return
+        banks.discard(ANY_BANK if bank is None else bank)
+        if not banks:
+            del self._bp_banks[addr]
+            self._bp_bits[addr >> 3] &= ~(1 << (addr & 7)) & 0xFF
+        self._update_dispatch()
+
+    def has_breakpoint(self, addr: int) -> bool:
+        """Indica si hay algún breakpoint en la dirección (en cualquier banco)."""
+        addr &= 0xFFFF
+        return bool(self._bp_bits[addr >> 3] & (1 << (addr & 7)))
+
+    # ========== Watchpoints de memoria ==========
+
+    def add_watchpoint(self, addr: int, length: int = 1, read: bool = False, write: bool = True) -> None:
+        """
+        Añade un watchpoint sobre [addr, addr + length).
+
+        Args:
+            addr: Dirección inicial
+            length: Número de bytes vigilados
+            read: Parar en lecturas de la CPU
+            write: Parar en escrituras de la CPU
+        """
+        for offset in range(length):
+            a = (addr + offset) & 0xFFFF
+            if read and not self._watch_read[a]:
+                self._watch_read[a] = 1
+                self._watch_count += 1
+            if write and not self._watch_write[a]:
+                self._watch_write[a] = 1
+                self._watch_count += 1
+        self._update_dispatch()
+
+    def remove_watchpoint(self, addr: int, length: int = 1, read: bool = True, write: bool = True) -> None:
+        """Elimina watchpoints sobre [addr, addr + length)."""
+        for offset in range(length):
+            a = (addr + offset) & 0xFFFF
+            if read and self._watch_read[a]:
+                self._watch_read[a] = 0
+                self._watch_count -= 1
+            if write and self._watch_write[a]:
+                self._watch_write[a] = 0
+                self._watch_count -= 1
+        self._update_dispatch()
+
+    # ========== Condiciones sobre registros ==========
+
+    def add_condition(self, predicate: Callable[[Registers], bool], description: str = "") -> None:
+        """
+        Añade una parada condicional evaluada tras cada instrucción.
+
+        Args:
+            predicate: Función que recibe los registros y devuelve True para parar
+            description: Texto para identificar la condición en StopReason
+        """
+        self._conditions.append((description or repr(predicate), predicate))
+        self._update_dispatch()
+
+    def add_register_condition(self, register: str, value: int) -> None:
+        """
+        Atajo: parar cuando un registro tome un valor (p.ej. ("a", 0x42), ("hl", 0xC000)).
+
+        Raises:
+            ValueError: Si el registro no existe
+        """
+        name = register.lower()
+        getter = getattr(self._cpu.registers.__class__, f"get_{name}", None)
+        if getter is None:
+            raise ValueError(f"Registro desconocido: {register}")
+        self.add_condition(lambda regs: getter(regs) == value, f"{name.upper()}==0x{value:X}")
+
+    def clear_conditions(self) -> None:
+        """Elimina todas las condiciones."""
+        self._conditions.clear()
+        self._update_dispatch()
+
+    def clear_all(self) -> None:
+        """Elimina breakpoints, watchpoints y condiciones; restaura el step original."""
+        self._bp_banks.clear()
+        self._bp_bits[:] = bytes(len(self._bp_bits))
+        self._watch_read[:] = bytes(0x10000)
+        self._watch_write[:] = bytes(0x10000)
+        self._watch_count = 0
+        self._conditions.clear()
+        self._update_dispatch()
+
+    # ========== Ejecución ==========
+
+    def is_armed(self) -> bool:
+        """Indica si el step instrumentado está instalado."""
+        return "step" in self._cpu.__dict__
+
+    def cont(self, max_instructions: int | None = None) -> StopReason | None:
+        """
+        Ejecuta (Viboy.tick) hasta la siguiente parada.
+
+        Args:
+            max_instructions: Límite de ticks (None = sin límite)
+
+        Returns:
+            Motivo de la parada, o None si se alcanzó el límite sin parar
+        """
+        tick = self._viboy.tick
+        reason: StopReason | None = None
+        try:
+            if max_instructions is None:
+                while True:
+                    tick()
+            else:
+                for _ in range(max_instructions):
+                    tick()
+        except DebugBreak as brk:
+            reason = brk.reason
+        if reason is None and self._pending is not None:
+            # La parada se detectó en la última instrucción permitida
+            reason = self._take_pending()
+        self._update_dispatch()
+        self.last_stop = reason
+        return reason
+
+    def step(self, count: int = 1) -> StopReason | None:
+        """Ejecuta `count` instrucciones (o hasta otra parada anterior)."""
+        self._steps_remaining = count
+        self._update_dispatch()
+        try:
+            return self.cont()
+        finally:
+            self._steps_remaining = 0
+            self._update_dispatch()
+
+    def step_over(self) -> StopReason | None:
+        """
+        Ejecuta la instrucción actual; si es CALL/RST, corre hasta que retorne.
+
+        La subrutina llamada puede detenerse antes en otro breakpoint o watchpoint.
+        """
+        pc = self._cpu.registers.get_pc()
+        length = CALL_OPCODE_LENGTHS.get(self._mmu.read_byte(pc))
+        if length is None:
+            return self.step()
+        self._temp_breakpoint = (pc + length) & 0xFFFF
+        self._update_dispatch()
+        try:
+            return self.cont()
+        finally:
+            self._temp_breakpoint = None
+            self._update_dispatch()
+
+    def step_out(self) -> StopReason | None:
+        """Ejecuta hasta que un RET abandone la subrutina actual (SP sube por encima del actual)."""
+        self._step_out_sp = self._cpu.registers.get_sp()
+        self._update_dispatch()
+        try:
+            return self.cont()
+        finally:
+            self._step_out_sp = None
+            self._update_dispatch()
+
+    # ========== Instrumentación ==========
+
+    def _update_dispatch(self) -> None:
+        """Instala o retira el step instrumentado y el proxy de MMU según lo armado."""
+        cpu = self._cpu
+        watching = self._watch_count > 0
+        if watching and self._watch_mmu is None:
+            self._watch_mmu = WatchMMU(self._mmu, self)
+            cpu.mmu = self._watch_mmu  # type: ignore[assignment]
+        elif not watching and self._watch_mmu is not None:
+            cpu.mmu = self._mmu
+            self._watch_mmu = None
+
+        armed = bool(
+            self._bp_banks
+            or watching
+            or self._conditions
+            or self._steps_remaining
+            or self._temp_breakpoint is not None
+            or self._step_out_sp is not None
+            or self._pending is not None
+        )
+        if armed:
+            if "step" not in cpu.__dict__:
+                cpu.step = self._instrumented_step  # type: ignore[method-assign]
+        else:
+            cpu.__dict__.pop("step", None)
+
+    def _current_bank(self, addr: int) -> int:
+        """Banco ROM correspondiente a una dirección de código."""
+        if addr < 0x4000:
+            return 0
+        if addr < 0x8000:
+            return self._cartridge.get_rom_bank() if self._cartridge is not None else 1
+        return ANY_BANK
+
+    def _breakpoint_matches(self, pc: int) -> bool:
+        banks = self._bp_banks.get(pc)
+        if banks is None:
+            return False
+        return ANY_BANK in banks or self._current_bank(pc) in banks
+
+    def _on_watch(self, kind: str, addr: int, value: int) -> None:
+        """Llamado por WatchMMU: registra la parada (se lanza tras la instrucción)."""
+        if self._pending is None:
+            self._pending = StopReason(kind, self._cpu.registers.get_pc(), addr, value)
+
+    def _take_pending(self) -> StopReason:
+        reason = self._pending
+        assert reason is not None
+        self._pending = None
+        # Reconstruir con el PC actual (la instrucción ya terminó)
+        return StopReason(reason.kind, self._cpu.registers.get_pc(), reason.addr, reason.value, reason.description)
+
+    def _instrumented_step(self) -> int:
+        """
+        Versión de CPU.step() con comprobación de paradas.
+
+        Solo está instalada mientras hay algo armado.
+        """
+        cpu = self._cpu
+        regs = cpu.registers
+
+        # Parada diferida de la instrucción anterior
+        if self._pending is not None:
+            raise DebugBreak(self._take_pending())
+
+        pc = regs.get_pc()
+        if not cpu.halted:
+            if pc == self._resume_pc:
+                # Reanudando desde este breakpoint: ejecutar la instrucción una vez
+                self._resume_pc = None
+            elif (self._bp_bits[pc >> 3] >> (pc & 7)) & 1 and self._breakpoint_matches(pc):
+                self._resume_pc = pc
+                raise DebugBreak(StopReason("breakpoint", pc))
+            elif pc == self._temp_breakpoint:
+                self._resume_pc = pc
+                raise DebugBreak(StopReason("step", pc))
+            else:
+                self._resume_pc = None
+
+        step_out_sp = self._step_out_sp
+        opcode = self._mmu.read_byte(pc) if step_out_sp is not None and not cpu.halted else -1
+
+        cycles = type(cpu).step(cpu)
+
+        if self._pending is None:
+            for description, predicate in self._conditions:
+                if predicate(regs):
+                    self._pending = StopReason("condition", pc, description=description)
+                    break
+        if self._pending is None and opcode in RET_OPCODES and regs.get_sp() > step_out_sp:  # type: ignore[operator]
+            self._pending = StopReason("step_out", pc)
+        if self._steps_remaining:
+            self._steps_remaining -= 1
+            if not self._steps_remaining and self._pending is None:
+                self._pending = StopReason("step", pc)
+        return cycles
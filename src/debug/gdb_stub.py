@@ -0,0 +1,443 @@
+"""
+GDBStub - Servidor del Protocolo Remoto de GDB (RSP)
+
+El GDB Remote Serial Protocol permite que un depurador estándar (gdb, IDEs que
+hablan RSP) controle un objetivo remoto mediante paquetes de texto:
+
+    $<datos>#<checksum>      checksum = suma de los bytes de datos módulo 256 (2 hex)
+
+El receptor responde '+' (recibido bien) o '-' (reenviar), salvo que se negocie
+QStartNoAckMode. Ctrl-C se envía como el byte 0x03 fuera de paquete.
+
+Paquetes soportados:
+- ?                 Motivo de la última parada
+- g / G             Leer/escribir todos los registros
+- p n / P n=v       Leer/escribir un registro
+- m addr,len        Leer memoria (vía MMU)
+- M addr,len:xx..   Escribir memoria (vía MMU)
+- c / s             Continuar / paso a paso
+- Z0-Z4 / z0-z4     Breakpoints (0 = software, 1 = hardware) y watchpoints
+                    (2 = escritura, 3 = lectura, 4 = acceso)
+- qSupported, qAttached, QStartNoAckMode, D (detach), k (kill)
+
+Disposición de registros (la LR35902 no tiene arquitectura oficial en GDB):
+6 registros de 16 bits little-endian en el orden AF, BC, DE, HL, SP, PC.
+
+Breakpoints por banco: en Z0/Z1 una dirección mayor que 0xFFFF se interpreta como
+(banco << 16) | dirección, p.ej. Z0,34a10,1 = banco 3, 0x4A10.
+
+Coste por instrucción: el stub no toca la CPU; delega en DebugController, que
+solo instala su step instrumentado mientras haya breakpoints/watchpoints. Entre
+paradas, 'c' ejecuta bloques de instrucciones a velocidad completa y solo entre
+bloques mira el socket (select con timeout 0) por si llega Ctrl-C.
+
+Fuente: GDB Manual - Appendix E "GDB Remote Serial Protocol"
+"""
+
+from __future__ import annotations
+
+import logging
+import os
+import select
+import socket
+from typing import TYPE_CHECKING, Callable
+
+from .controller import DebugController, StopReason
+
+if TYPE_CHECKING:
+    from ..viboy import Viboy
+
+logger = logging.getLogger(__name__)
+
+# Señales POSIX usadas en las respuestas de parada
+SIGINT = 0x02
+SIGTRAP = 0x05
+
+# Instrucciones ejecutadas entre comprobaciones de Ctrl-C durante 'c'
+CONTINUE_CHUNK = 20_000
+
+# Orden de los registros expuestos a GDB (getters/setters de Registers)
+REGISTER_NAMES = ("af", "bc", "de", "hl", "sp", "pc")
+
+# Tipo de watchpoint RSP -> (lectura, escritura)
+WATCH_TYPES = {2: (False, True), 3: (True, False), 4: (True, True)}
+ACCESS_WATCH = 4
+
+
+def checksum(data: bytes) -> int:
+    """Checksum RSP: suma de los bytes módulo 256."""
+    return sum(data) & 0xFF
+
+
+def escape_binary(data: bytes) -> bytes:
+    """Escapa '#', '$', '}' y '*' con '}' + (byte ^ 0x20)."""
+    out = bytearray()
+    for b in data:
+        if b in (0x23, 0x24, 0x7D, 0x2A):
+            out.append(0x7D)
+            out.append(b ^ 0x20)
+        else:
+            out.append(b)
+    return bytes(out)
+
+
+def encode_packet(payload: bytes) -> bytes:
+    """Enmarca un payload como paquete RSP ($datos#cs)."""
+    body = escape_binary(payload)
+    return b"$" + body + b"#" + f"{checksum(body):02x}".encode("ascii")
+
+
+class GDBStub:
+    """
+    Servidor RSP para un Viboy.
+
+    Uso:
+        stub = GDBStub(viboy, port=2159)         # o unix_path="/tmp/viboy.sock"
+        stub.listen()
+        stub.serve()                             # atiende a un cliente hasta D/k
+    """
+
+    def __init__(
+        self,
+        viboy: Viboy,
+        host: str = "127.0.0.1",
+        port: int = 2159,
+        unix_path: str | None = None,
+        on_idle: Callable[[], None] | None = None,
+    ) -> None:
+        """
+        Args:
+            viboy: Sistema a depurar
+            host: Interfaz TCP (por defecto solo localhost)
+            port: Puerto TCP (0 = elegir uno libre)
+            unix_path: Si se indica, escuchar en un socket Unix en lugar de TCP
+            on_idle: Callback opcional entre bloques de 'c' (p.ej. refrescar pantalla)
+        """
+        self._viboy = viboy
+        self.debugger = DebugController(viboy)
+        self._cpu = self.debugger._cpu
+        self._mmu = self.debugger._mmu
+        self._host = host
+        self._port = port
+        self._unix_path = unix_path
+        self._on_idle = on_idle
+        self._server: socket.socket | None = None
+        self._conn: socket.socket | None = None
+        self._rx = bytearray()
+        self._ack = True
+        self._no_ack_requested = False
+        self._detaching = False
+        self._interrupt_pending = False
+        self._last_signal = SIGTRAP
+        self._last_stop: StopReason | None = None
+        # Watchpoints de acceso (Z4) como (dirección, longitud): el controlador los
+        # arma como lectura + escritura, pero GDB espera una parada "awatch"
+        self._access_watches: set[tuple[int, int]] = set()
+
+    # ========== Transporte ==========
+
+    def listen(self) -> str | tuple[str, int]:
+        """
+        Abre el socket de escucha.
+
+        Returns:
+            Dirección real (ruta Unix o (host, puerto))
+        """
+        if self._unix_path is not None:
+            if os.path.exists(self._unix_path):
+                os.unlink(self._unix_path)
+            server = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+            server.bind(self._unix_path)
+        else:
+            server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+            server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+            server.bind((self._host, self._port))
+        server.listen(1)
+        self._server = server
+        address = server.getsockname()
+        logger.info(f"GDB stub escuchando en {address}")
+        return address
+
+    def close(self) -> None:
+        """Cierra la conexión y el socket de escucha; desarma el depurador."""
+        if self._conn is not None:
+            self._conn.close()
+            self._conn = None
+        if self._server is not None:
+            self._server.close()
+            self._server = None
+            if self._unix_path is not None and os.path.exists(self._unix_path):
+                os.unlink(self._unix_path)
+        self.debugger.clear_all()
+
+    def serve(self) -> None:
+        """Acepta un cliente y procesa paquetes hasta que se desconecte (D/k/EOF)."""
+        if self._server is None:
+            self.listen()
+        assert self._server is not None
+        conn, _ = self._server.accept()
+        if conn.family != getattr(socket, "AF_UNIX", None):
+            conn.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self._conn = conn
+        self._rx.clear()
+        self._ack = True
+        self._detaching = False
+        self._interrupt_pending = False
+        try:
+            while True:
+                packet = self._read_packet()
+                if packet is None:
+                    break
+                reply = self.handle_packet(packet)
+                if reply is None:
+                    break
+                self._send(reply)
+                if self._no_ack_requested:
+                    self._no_ack_requested = False
+                    self._ack = False
+                if self._detaching:
+                    break
+        finally:
+            conn.close()
+            self._conn = None
+            # Sin cliente no debe quedar nada armado: velocidad completa
+            self.debugger.clear_all()
+
+    def _recv(self) -> bool:
+        assert self._conn is not None
+        data = self._conn.recv(4096)
+        if not data:
+            return False
+        self._rx += data
+        return True
+
+    def _read_packet(self) -> bytes | None:
+        """Lee el siguiente paquete completo (None si el cliente se desconectó)."""
+        rx = self._rx
+        while True:
+            # Descartar acks sueltos entre paquetes (recordando un Ctrl-C)
+            start = rx.find(b"$")
+            if 0x03 in (rx if start < 0 else rx[:start]):
+                self._interrupt_pending = True
+            if start < 0:
+                rx.clear()
+            else:
+                del rx[:start]
+                end = rx.find(b"#")
+                if end >= 0 and len(rx) >= end + 3:
+                    body = bytes(rx[1:end])
+                    received = rx[end + 1:end + 3]
+                    del rx[:end + 3]
+                    if self._ack:
+                        ok = int(received, 16) == checksum(body)
+                        self._conn.sendall(b"+" if ok else b"-")  # type: ignore[union-attr]
+                        if not ok:
+                            continue
+                    return body
+            if not self._recv():
+                return None
+
+    def _send(self, payload: bytes) -> None:
+        assert self._conn is not None
+        packet = encode_packet(payload)
+        while True:
+            self._conn.sendall(packet)
+            if not self._ack:
+                return
+            while not self._rx:
+                if not self._recv():
+                    return
+            ack = self._rx[0]
+            if ack == 0x2D:  # '-': reenviar
+                del self._rx[0]
+                continue
+            if ack == 0x2B:  # '+'
+                del self._rx[0]
+            return
+
+    def _interrupt_requested(self) -> bool:
+        """Comprueba (sin bloquear) si el cliente envió Ctrl-C (0x03)."""
+        if self._interrupt_pending:
+            self._interrupt_pending = False
+            return True
+        conn = self._conn
+        if conn is None:
+            return False
+        readable, _, _ = select.select([conn], [], [], 0)
+        if readable and not self._recv():
+            return True
+        if 0x03 in self._rx:
+            self._rx.remove(0x03)
+            return True
+        return False
+
+    # ========== Paquetes ==========
+
+    def handle_packet(self, packet: bytes) -> bytes | None:
+        """
+        Procesa un paquete y devuelve la respuesta (None = cerrar la sesión).
+
+        Es independiente del transporte para poder probarlo directamente.
+        Un argumento mal formado (hex inválido, valor demasiado corto) se
+        responde con E01 en lugar de cortar la sesión.
+        """
+        if not packet:
+            return b""
+        try:
+            return self._dispatch(packet)
+        except (ValueError, IndexError):
+            return b"E01"
+
+    def _dispatch(self, packet: bytes) -> bytes | None:
+        cmd = packet[:1]
+        args = packet[1:]
+
+        if cmd == b"?":
+            return self._stop_reply()
+        if cmd == b"g":
+            return "".join(self._reg_hex(n) for n in REGISTER_NAMES).encode("ascii")
+        if cmd == b"G":
+            data = bytes.fromhex(args.decode("ascii"))
+            for i, name in enumerate(REGISTER_NAMES):
+                if 2 * i + 1 < len(data):
+                    self._set_reg(name, data[2 * i] | (data[2 * i + 1] << 8))
+            return b"OK"
+        if cmd == b"p":
+            index = int(args, 16)
+            if index >= len(REGISTER_NAMES):
+                return b"E00"
+            return self._reg_hex(REGISTER_NAMES[index]).encode("ascii")
+        if cmd == b"P":
+            index_hex, _, value_hex = args.partition(b"=")
+            index = int(index_hex, 16)
+            if index >= len(REGISTER_NAMES):
+                return b"E00"
+            data = bytes.fromhex(value_hex.decode("ascii"))
+            self._set_reg(REGISTER_NAMES[index], data[0] | (data[1] << 8))
+            return b"OK"
+        if cmd == b"m":
+            addr_hex, _, length_hex = args.partition(b",")
+            addr, length = int(addr_hex, 16), int(length_hex, 16)
+            read = self._mmu.read_byte
+            return bytes(read((addr + i) & 0xFFFF) for i in range(length)).hex().encode("ascii")
+        if cmd == b"M":
+            header, _, data_hex = args.partition(b":")
+            addr_hex, _, _ = header.partition(b",")
+            addr = int(addr_hex, 16)
+            write = self._mmu.write_byte
+            for i, value in enumerate(bytes.fromhex(data_hex.decode("ascii"))):
+                write((addr + i) & 0xFFFF, value)
+            return b"OK"
+        if cmd == b"c":
+            if args:
+                self._cpu.registers.set_pc(int(args, 16))
+            return self._continue()
+        if cmd == b"s":
+            if args:
+                self._cpu.registers.set_pc(int(args, 16))
+            self._last_stop = self.debugger.step()
+            self._last_signal = SIGTRAP
+            return self._stop_reply()
+        if cmd in (b"Z", b"z"):
+            return self._breakpoint_packet(cmd == b"Z", args)
+        if cmd == b"H":
+            return b"OK"
+        if cmd == b"D":
+            self._detaching = True
+            return b"OK"
+        if cmd == b"k":
+            return None
+        if cmd == b"q":
+            return self._query(packet)
+        if packet == b"QStartNoAckMode":
+            # El modo sin acks empieza después de enviar este OK
+            self._no_ack_requested = True
+            return b"OK"
+        # Paquete no soportado: respuesta vacía (estándar RSP)
+        return b""
+
+    def _query(self, packet: bytes) -> bytes:
+        if packet.startswith(b"qSupported"):
+            return b"PacketSize=1000;QStartNoAckMode+;swbreak+;hwbreak+"
+        if packet == b"qAttached":
+            return b"1"
+        if packet == b"qC":
+            return b"QC1"
+        if packet == b"qfThreadInfo":
+            return b"m1"
+        if packet == b"qsThreadInfo":
+            return b"l"
+        return b""
+
+    def _breakpoint_packet(self, insert: bool, args: bytes) -> bytes:
+        parts = args.split(b",")
+        if len(parts) < 2:
+            return b"E01"
+        kind, addr = int(parts[0], 16), int(parts[1], 16)
+        length = int(parts[2], 16) if len(parts) > 2 else 1
+        dbg = self.debugger
+        if kind in (0, 1):
+            bank = (addr >> 16) if addr > 0xFFFF else None
+            if insert:
+                dbg.add_breakpoint(addr & 0xFFFF, bank)
+            else:
+                dbg.remove_breakpoint(addr & 0xFFFF, bank)
+            return b"OK"
+        if kind in WATCH_TYPES:
+            read, write = WATCH_TYPES[kind]
+            length = max(length, 1)
+            if insert:
+                dbg.add_watchpoint(addr, length, read=read, write=write)
+            else:
+                dbg.remove_watchpoint(addr, length, read=read, write=write)
+            if kind == ACCESS_WATCH:
+                if insert:
+                    self._access_watches.add((addr, length))
+                else:
+                    self._access_watches.discard((addr, length))
+            return b"OK"
+        return b""
+
+    # ========== Ejecución ==========
+
+    def _continue(self) -> bytes:
+        """Ejecuta a velocidad completa hasta una parada o un Ctrl-C."""
+        dbg = self.debugger
+        on_idle = self._on_idle
+        while True:
+            reason = dbg.cont(max_instructions=CONTINUE_CHUNK)
+            if reason is not None:
+                self._last_stop = reason
+                self._last_signal = SIGTRAP
+                return self._stop_reply()
+            if on_idle is not None:
+                on_idle()
+            if self._interrupt_requested():
+                self._last_stop = None
+                self._last_signal = SIGINT
+                return self._stop_reply()
+
+    def _stop_reply(self) -> bytes:
+        """Construye la respuesta de parada (Txx con detalle de watchpoint/breakpoint)."""
+        reply = f"T{self._last_signal:02x}"
+        stop = self._last_stop
+        if stop is not None:
+            if stop.kind in ("watch_read", "watch_write") and self._is_access_watch(stop.addr):
+                reply += f"awatch:{stop.addr:x};"
+            elif stop.kind == "watch_write":
+                reply += f"watch:{stop.addr:x};"
+            elif stop.kind == "watch_read":
+                reply += f"rwatch:{stop.addr:x};"
+            elif stop.kind == "breakpoint":
+                reply += "swbreak:;"
+        return reply.encode("ascii")
+
+    def _is_access_watch(self, addr: int) -> bool:
+        return any(start <= addr < start + length for start, length in self._access_watches)
+
+    def _reg_hex(self, name: str) -> str:
+        value = getattr(self._cpu.registers, f"get_{name}")()
+        return f"{value & 0xFF:02x}{(value >> 8) & 0xFF:02x}"
+
+    def _set_reg(self, name: str, value: int) -> None:
+        getattr(self._cpu.registers, f"set_{name}")(value & 0xFFFF)
@@ -0,0 +1,247 @@
+"""
+Exportación del Estado en Memoria Compartida (Seqlock)
+
+Las herramientas de monitorización (dashboards, buscadores de memoria, bots)
+no deberían ejecutarse dentro del proceso del emulador: cada consulta roba
+tiempo al bucle principal. En su lugar, el emulador publica una instantánea de
+su estado en un segmento de memoria compartida POSIX con nombre, una vez por
+frame, y otros procesos la leen sin pausar ni ralentizar la emulación.
+
+Sincronización con un seqlock (un escritor, N lectores, sin bloqueos):
+- Escritor: seq += 1 (impar = escribiendo) → copia los datos → seq += 1 (par).
+- Lector: lee seq; si es impar, reintenta. Copia los datos. Vuelve a leer seq:
+  si cambió, la copia puede estar a medias y se reintenta.
+El escritor nunca espera a los lectores.
+
+Disposición del segmento (little-endian):
+    0x0000  magic "VIBOYSHM" (8) | versión u16 | tamaño cabecera u16 | seq u32
+    0x0010  frame u64 | ciclos totales u64
+    0x0020  A F B C D E H L (8 bytes) | SP u16 | PC u16 | IME u8 | HALT u8
+    0x0040  Framebuffer 160x144 RGB (69120 bytes)
+    ...     WRAM 0xC000-0xDFFF (8 KiB) | OAM 0xFE00-0xFE9F (160)
+    ...     I/O 0xFF00-0xFF7F (128) | HRAM + IE 0xFF80-0xFFFF (128)
+
+Fuente: Pan Docs - Memory Map; Linux kernel - seqlock (include/linux/seqlock.h);
+Python docs - multiprocessing.shared_memory
+"""
+
+from __future__ import annotations
+
+import logging
+import os
+import struct
+from dataclasses import dataclass
+from multiprocessing import resource_tracker, shared_memory
+from typing import TYPE_CHECKING
+
+if TYPE_CHECKING:
+    from ..viboy import Viboy
+
+logger = logging.getLogger(__name__)
+
+MAGIC = b"VIBOYSHM"
+VERSION = 1
+
+# Cabecera y registros
+HEADER_STRUCT = struct.Struct("<8sHHI")   # magic, versión, tamaño cabecera, seq
+SEQ_OFFSET = 12
+COUNTERS_STRUCT = struct.Struct("<QQ")    # frame, ciclos totales
+COUNTERS_OFFSET = 0x10
+REGS_STRUCT = struct.Struct("<8BHHBB")    # A F B C D E H L, SP, PC, IME, HALT
+REGS_OFFSET = 0x20
+HEADER_SIZE = 0x40
+
+# Regiones de datos
+FRAMEBUFFER_SIZE = 160 * 144 * 3
+FRAMEBUFFER_OFFSET = HEADER_SIZE
+WRAM_START, WRAM_SIZE = 0xC000, 0x2000
+WRAM_OFFSET = FRAMEBUFFER_OFFSET + FRAMEBUFFER_SIZE
+OAM_START, OAM_SIZE = 0xFE00, 0xA0
+OAM_OFFSET = WRAM_OFFSET + WRAM_SIZE
+IO_START, IO_SIZE = 0xFF00, 0x80
+IO_OFFSET = OAM_OFFSET + OAM_SIZE
+HRAM_START, HRAM_SIZE = 0xFF80, 0x80
+HRAM_OFFSET = IO_OFFSET + IO_SIZE
+SEGMENT_SIZE = HRAM_OFFSET + HRAM_SIZE
+
+SEQ_STRUCT = struct.Struct("<I")
+
+
+def default_segment_name() -> str:
+    """Nombre por defecto del segmento: único por proceso."""
+    return f"viboy_{os.getpid()}"
+
+
+@dataclass
+class StateSnapshot:
+    """Instantánea coherente del estado exportado."""
+
+    frame: int
+    total_cycles: int
+    registers: dict[str, int]
+    ime: bool
+    halted: bool
+    framebuffer: bytes
+    wram: bytes
+    oam: bytes
+    io: bytes
+    hram: bytes
+
+
+class SharedStateExporter:
+    """
+    Escritor: publica el estado de un Viboy en memoria compartida.
+
+    Se llama a publish() una vez por frame desde el bucle principal.
+    """
+
+    def __init__(self, name: str | None = None) -> None:
+        """
+        Args:
+            name: Nombre del segmento (None = "viboy_<pid>")
+        """
+        self.name = name or default_segment_name()
+        self._shm = shared_memory.SharedMemory(name=self.name, create=True, size=SEGMENT_SIZE)
+        self._buf = self._shm.buf
+        self._seq = 0
+        self._frame = 0
+        HEADER_STRUCT.pack_into(self._buf, 0, MAGIC, VERSION, HEADER_SIZE, 0)
+        logger.info(f"Exportando estado en memoria compartida '{self.name}' ({SEGMENT_SIZE} bytes)")
+
+    def publish(self, viboy: Viboy) -> None:
+        """
+        Copia el estado actual al segmento (protegido por el seqlock).
+
+        Args:
+            viboy: Sistema del que tomar el estado
+        """
+        buf = self._buf
+        cpu = viboy.get_cpu()
+        mmu = viboy.get_mmu()
+        if cpu is None or mmu is None:
+            return
+        renderer = viboy.get_renderer()
+        self._frame += 1
+
+        # Preparar fuera de la sección crítica para acortarla
+        framebuffer = renderer.get_framebuffer_rgb() if renderer is not None else None
+        read = mmu.read_byte
+        io = bytes(read(addr) for addr in range(IO_START, IO_START + IO_SIZE))
+        regs = cpu.registers
+
+        # seq impar: escritura en curso
+        self._seq += 1
+        SEQ_STRUCT.pack_into(buf, SEQ_OFFSET, self._seq & 0xFFFFFFFF)
+
+        COUNTERS_STRUCT.pack_into(buf, COUNTERS_OFFSET, self._frame, viboy.get_total_cycles())
+        REGS_STRUCT.pack_into(
+            buf, REGS_OFFSET,
+            regs.get_a(), regs.get_f(), regs.get_b(), regs.get_c(),
+            regs.get_d(), regs.get_e(), regs.get_h(), regs.get_l(),
+            regs.get_sp(), regs.get_pc(), int(cpu.ime), int(cpu.halted),
+        )
+        if framebuffer is not None and len(framebuffer) == FRAMEBUFFER_SIZE:
+            buf[FRAMEBUFFER_OFFSET:FRAMEBUFFER_OFFSET + FRAMEBUFFER_SIZE] = framebuffer
+        buf[WRAM_OFFSET:WRAM_OFFSET + WRAM_SIZE] = mmu.read_block(WRAM_START, WRAM_SIZE)
+        buf[OAM_OFFSET:OAM_OFFSET + OAM_SIZE] = mmu.read_block(OAM_START, OAM_SIZE)
+        buf[IO_OFFSET:IO_OFFSET + IO_SIZE] = io
+        buf[HRAM_OFFSET:HRAM_OFFSET + HRAM_SIZE] = mmu.read_block(HRAM_START, HRAM_SIZE)
+
+        # seq par: datos coherentes
+        self._seq += 1
+        SEQ_STRUCT.pack_into(buf, SEQ_OFFSET, self._seq & 0xFFFFFFFF)
+
+    def close(self) -> None:
+        """Libera y elimina el segmento."""
+        if self._shm is None:
+            return
+        self._buf.release()
+        self._shm.close()
+        try:
+            self._shm.unlink()
+        except FileNotFoundError:
+            pass
+        self._shm = None  # type: ignore[assignment]
+
+
+class SharedStateReader:
+    """
+    Lector: se conecta a un segmento existente (normalmente desde otro proceso).
+    """
+
+    def __init__(self, name: str) -> None:
+        """
+        Args:
+            name: Nombre del segmento publicado por SharedStateExporter
+
+        Raises:
+            FileNotFoundError: Si el segmento no existe
+            ValueError: Si el segmento no tiene el formato esperado
+        """
+        self._shm = shared_memory.SharedMemory(name=name, create=False)
+        # En Python < 3.13 el lector también se registra en el resource_tracker,
+        # que eliminaría el segmento al salir: solo el escritor debe hacerlo
+        try:
+            resource_tracker.unregister(self._shm._name, "shared_memory")  # type: ignore[attr-defined]
+        except Exception:
+            pass
+        self._buf = self._shm.buf
+        magic, version, header_size, _ = HEADER_STRUCT.unpack_from(self._buf, 0)
+        if magic != MAGIC or version != VERSION or header_size != HEADER_SIZE:
+            self.close()
+            raise ValueError(f"Segmento '{name}' no es un estado de Viboy v{VERSION}")
+
+    def sequence(self) -> int:
+        """Valor actual del contador del seqlock (par = estable)."""
+        return SEQ_STRUCT.unpack_from(self._buf, SEQ_OFFSET)[0]
+
+    def read(self, max_retries: int = 1000) -> StateSnapshot | None:
+        """
+        Lee una instantánea coherente.
+
+        Args:
+            max_retries: Intentos antes de rendirse si el escritor no deja de escribir
+
+        Returns:
+            StateSnapshot, o None si no se obtuvo una copia coherente
+            (o aún no se ha publicado ningún frame)
+        """
+        buf = self._buf
+        for _ in range(max_retries):
+            seq_before = SEQ_STRUCT.unpack_from(buf, SEQ_OFFSET)[0]
+            if seq_before & 1:
+                continue
+            if seq_before == 0:
+                return None
+            frame, cycles = COUNTERS_STRUCT.unpack_from(buf, COUNTERS_OFFSET)
+            a, f, b, c, d, e, h, l, sp, pc, ime, halted = REGS_STRUCT.unpack_from(buf, REGS_OFFSET)
+            data = bytes(buf[FRAMEBUFFER_OFFSET:SEGMENT_SIZE])
+            if SEQ_STRUCT.unpack_from(buf, SEQ_OFFSET)[0] != seq_before:
+                continue
+
+            def region(offset: int, size: int) -> bytes:
+                start = offset - FRAMEBUFFER_OFFSET
+                return data[start:start + size]
+
+            return StateSnapshot(
+                frame=frame,
+                total_cycles=cycles,
+                registers={"a": a, "f": f, "b": b, "c": c, "d": d, "e": e,
+                           "h": h, "l": l, "sp": sp, "pc": pc},
+                ime=bool(ime),
+                halted=bool(halted),
+                framebuffer=region(FRAMEBUFFER_OFFSET, FRAMEBUFFER_SIZE),
+                wram=region(WRAM_OFFSET, WRAM_SIZE),
+                oam=region(OAM_OFFSET, OAM_SIZE),
+                io=region(IO_OFFSET, IO_SIZE),
+                hram=region(HRAM_OFFSET, HRAM_SIZE),
+            )
+        return None
+
+    def close(self) -> None:
+        """Desconecta del segmento (sin eliminarlo)."""
+        if self._shm is None:
+            return
+        self._buf.release()
+        self._shm.close()
+        self._shm = None  # type: ignore[assignment]
@@ -0,0 +1,250 @@
+"""
+Compositor Vectorizado con NumPy - Backend alternativo de composición de frames
+
+El compositor de pygame (Renderer.render_frame) trabaja tile a tile: ~400 blits
+por frame más uno por sprite, cada uno con su coste de llamada desde Python.
+Este backend compone el frame completo con operaciones vectorizadas de NumPy,
+sin extensiones nativas propias (solo hace falta NumPy instalado):
+
+1. Decodificación: VRAM se trata como un array uint8. Los 768 tiles (2 bancos x 384)
+   se decodifican a la vez: los bits bajo/alto de cada fila se separan con
+   desplazamientos y máscaras sobre arrays (768, 8, 8).
+2. Fondo/Window: el tilemap de 32x32 se convierte en slots de tile (tablas por
+   LCDC.4 + bit de banco CGB) y el fancy indexing construye la imagen de 256x256
+   índices de color. El scroll (SCX/SCY) se aplica con np.take sobre índices
+   en módulo 256 (wrap-around del tilemap).
+3. Paleta: los índices 0-3 se traducen a colores empaquetados en uint32
+   (R | G << 8 | B << 16) con np.take; al final se reinterpreta el array como
+   bytes (144, 160, 4) y se descarta el cuarto canal, sin copias.
+4. Sprites: cada sprite se compone con asignación enmascarada (el color 0 es
+   transparente), en orden de OAM igual que el compositor de pygame.
+
+Los tiles decodificados se reutilizan entre frames: solo se vuelven a decodificar
+si los 12 KiB de datos de tile (ambos bancos) cambiaron desde el frame anterior.
+
+El resultado es idéntico, píxel a píxel, al del compositor de pygame (incluidas
+sus simplificaciones: LCDC.0 ignorado, prioridad OBJ-BG ignorada).
+
+Fuente: Pan Docs - Tile Data, Tile Maps, Scrolling, Window, OAM
+"""
+
+from __future__ import annotations
+
+from typing import TYPE_CHECKING
+
+try:
+    import numpy as np
+except ImportError:
+    np = None  # type: ignore
+
+if TYPE_CHECKING:
+    from ..memory.mmu import MMU
+
+from ..memory.cartridge import MODEL_DMG
+from ..memory.mmu import IO_BGP, IO_LCDC, IO_OBP0, IO_OBP1, IO_SCX, IO_SCY, IO_WX, IO_WY
+from .renderer import (
+    GB_HEIGHT,
+    GB_WIDTH,
+    PALETTE_GREYSCALE,
+    TILE_SLOT_SIGNED,
+    TILE_SLOT_UNSIGNED,
+    TILES_PER_BANK,
+)
+
+
+def numpy_available() -> bool:
+    """Indica si NumPy está instalado (requisito de este backend)."""
+    return np is not None
+
+
+class NumpyCompositor:
+    """
+    Compone frames completos (160x144 RGB) con NumPy a partir de VRAM, OAM y registros.
+    """
+
+    def __init__(self, mmu: MMU) -> None:
+        """
+        Args:
+            mmu: MMU de la que se toman las vistas de VRAM/OAM y los registros
+
+        Raises:
+            ImportError: Si NumPy no está instalado
+        """
+        if np is None:
+            raise ImportError("NumPy no está instalado. Instala con: pip install numpy")
+
+        self.mmu = mmu
+
+        # Arrays sin copia sobre las vistas de solo lectura de la MMU
+        self._vram_banks = (
+            np.frombuffer(mmu.get_vram_view(0), dtype=np.uint8),
+            np.frombuffer(mmu.get_vram_view(1), dtype=np.uint8),
+        )
+        self._oam = np.frombuffer(mmu.get_oam_view(), dtype=np.uint8)
+        # En DMG no hay atributos de tile (banco 1): se omite la selección de banco
+        self._cgb = getattr(mmu, "MODEL", None) != MODEL_DMG
+
+        # Tablas Tile ID -> slot (banco 0) para LCDC.4 = 0 (signed) y 1 (unsigned)
+        self._slot_tables = (
+            np.array(TILE_SLOT_SIGNED, dtype=np.intp),
+            np.array(TILE_SLOT_UNSIGNED, dtype=np.intp),
+        )
+
+        # Desplazamientos para extraer los 8 píxeles de una fila (bit 7 = píxel 0)
+        self._bit_shifts = np.arange(7, -1, -1, dtype=np.uint8)
+
+        # Coordenadas de pantalla reutilizadas en cada frame
+        self._rows = np.arange(GB_HEIGHT, dtype=np.intp)
+        self._cols = np.arange(GB_WIDTH, dtype=np.intp)
+
+        # Grises empaquetados en uint32 little-endian: R | G << 8 | B << 16
+        self._greyscale = np.array(
+            [r | (g << 8) | (b << 16) for r, g, b in PALETTE_GREYSCALE], dtype="<u4"
+        )
+        self._white_frame = np.full((GB_HEIGHT, GB_WIDTH, 3), 255, dtype=np.uint8)
+
+        # Caché de tiles decodificados y copia de los datos de los que salieron
+        self._tile_data: np.ndarray | None = None
+        self._tiles: np.ndarray | None = None
+
+    def _palette(self, value: int) -> np.ndarray:
+        """Traduce un registro de paleta (BGP/OBP) a un array (4,) de colores empaquetados."""
+        return self._greyscale[[(value >> shift) & 0x03 for shift in (0, 2, 4, 6)]]
+
+    def decode_tiles(self) -> np.ndarray:
+        """
+        Decodifica los 768 tiles de VRAM (banco 0 y banco 1) a índices de color.
+
+        Si los datos de tile no cambiaron desde la última llamada, devuelve el
+        resultado anterior.
+
+        Returns:
+            Array (768, 8, 8) uint8: [slot, fila, columna] -> color 0-3
+        """
+        data = np.concatenate([bank[:TILES_PER_BANK * 16] for bank in self._vram_banks])
+        if self._tiles is not None and np.array_equal(data, self._tile_data):
+            return self._tiles
+        rows = data.reshape(2 * TILES_PER_BANK, 8, 2)
+        low = (rows[:, :, 0, None] >> self._bit_shifts) & 0x01
+        high = (rows[:, :, 1, None] >> self._bit_shifts) & 0x01
+        self._tile_data = data
+        self._tiles = (high << 1) | low
+        return self._tiles
+
+    def _map_image(self, tiles: np.ndarray, map_select: int, slot_table: np.ndarray) -> np.ndarray:
+        """
+        Construye la imagen de 256x256 índices de color de un tilemap.
+
+        Args:
+            tiles: Tiles decodificados (768, 8, 8)
+            map_select: 0 = 0x9800, 1 = 0x9C00
+            slot_table: Tabla Tile ID -> slot según LCDC.4
+
+        Returns:
+            Array (256, 256) uint8
+        """
+        start = 0x1800 + map_select * 0x400
+        tile_ids = self._vram_banks[0][start:start + 0x400]
+        slots = slot_table[tile_ids]
+        if self._cgb:
+            # Bit 3 del atributo CGB: tile del banco 1
+            attrs = self._vram_banks[1][start:start + 0x400]
+            slots = slots + ((attrs & 0x08) != 0) * TILES_PER_BANK
+        # (32, 32, 8, 8) -> (fila de tile, fila de píxel, columna de tile, columna de píxel)
+        return tiles[slots.reshape(32, 32)].transpose(0, 2, 1, 3).reshape(256, 256)
+
+    def compose(self) -> np.ndarray:
+        """
+        Compone el frame actual.
+
+        Returns:
+            Array (144, 160, 3) uint8 con el frame en RGB (fila, columna, canal)
+        """
+        mmu = self.mmu
+        lcdc = mmu.read_byte(IO_LCDC) & 0xFF
+
+        # LCD apagado: pantalla blanca
+        if not lcdc & 0x80:
+            return self._white_frame.copy()
+
+        bg_palette = self._palette(mmu.read_byte(IO_BGP) & 0xFF)
+        scx = mmu.read_byte(IO_SCX) & 0xFF
+        scy = mmu.read_byte(IO_SCY) & 0xFF
+        wy = mmu.read_byte(IO_WY) & 0xFF
+        wx = mmu.read_byte(IO_WX) & 0xFF
+
+        tiles = self.decode_tiles()
+        slot_table = self._slot_tables[(lcdc >> 4) & 0x01]
+
+        # Fondo (LCDC.0 se ignora, igual que en el compositor de pygame)
+        bg = self._map_image(tiles, (lcdc >> 3) & 0x01, slot_table)
+        indices = bg.take((self._rows + scy) & 0xFF, axis=0).take((self._cols + scx) & 0xFF, axis=1)
+
+        # Window: rectángulo desde (WX-7, WY); su ancho/alto se calcula en tiles
+        # completos igual que el compositor de pygame
+        if lcdc & 0x20:
+            win_x = wx - 7
+            tiles_x = min(32, (GB_WIDTH - max(0, win_x) + 7) // 8)
+            tiles_y = min(32, (GB_HEIGHT - max(0, wy) + 7) // 8)
+            x0, x1 = max(0, win_x), min(GB_WIDTH, win_x + tiles_x * 8)
+            y0, y1 = max(0, wy), min(GB_HEIGHT, wy + tiles_y * 8)
+            if x0 < x1 and y0 < y1:
+                window = self._map_image(tiles, (lcdc >> 6) & 0x01, slot_table)
+                indices[y0:y1, x0:x1] = window[y0 - wy:y1 - wy, x0 - win_x:x1 - win_x]
+
+        frame = bg_palette.take(indices)
+
+        if lcdc & 0x02:
+            self._compose_sprites(frame, tiles, lcdc)
+
+        # uint32 (144, 160) -> bytes (144, 160, 4) -> RGB (vista, sin copia)
+        return frame.view(np.uint8).reshape(GB_HEIGHT, GB_WIDTH, 4)[:, :, :3]
+
+    def _compose_sprites(self, frame: np.ndarray, tiles: np.ndarray, lcdc: int) -> None:
+        """
+        Dibuja los sprites sobre el frame con asignación enmascarada.
+
+        Args:
+            frame: Frame de colores empaquetados (144, 160) a modificar
+            tiles: Tiles decodificados (768, 8, 8)
+            lcdc: Valor de LCDC
+        """
+        mmu = self.mmu
+        obp0 = mmu.read_byte(IO_OBP0) & 0xFF
+        obp1 = mmu.read_byte(IO_OBP1) & 0xFF
+        # OBP a 0x00 (todo blanco): paleta por defecto, como el compositor de pygame
+        palettes = (
+            self._greyscale if obp0 == 0 else self._palette(obp0),
+            self._greyscale if obp1 == 0 else self._palette(obp1),
+        )
+        height = 16 if lcdc & 0x04 else 8
+        oam = self._oam.tolist()
+
+        for base in range(0, 160, 4):
+            sprite_y, sprite_x, tile_id, attributes = oam[base:base + 4]
+            if sprite_y == 0 or sprite_x == 0:
+                continue
+            screen_y = sprite_y - 16
+            screen_x = sprite_x - 8
+            if screen_y <= -height or screen_y >= GB_HEIGHT or screen_x < -7 or screen_x >= GB_WIDTH:
+                continue
+
+            # Píxeles del sprite (8x8 o 8x16: tile par arriba, impar abajo)
+            if height == 16:
+                pixels = tiles[[tile_id & 0xFE, tile_id | 0x01]].reshape(16, 8)
+            else:
+                pixels = tiles[tile_id]
+            if attributes & 0x40:
+                pixels = pixels[::-1]
+            if attributes & 0x20:
+                pixels = pixels[:, ::-1]
+
+            # Recorte a la pantalla
+            y0, y1 = max(0, screen_y), min(GB_HEIGHT, screen_y + height)
+            x0, x1 = max(0, screen_x), min(GB_WIDTH, screen_x + 8)
+            pixels = pixels[y0 - screen_y:y1 - screen_y, x0 - screen_x:x1 - screen_x]
+
+            # Color 0 transparente: solo se asignan los píxeles con índice != 0
+            mask = pixels != 0
+            palette = palettes[(attributes >> 4) & 0x01]
+            frame[y0:y1, x0:x1][mask] = palette.take(pixels[mask])
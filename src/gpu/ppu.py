@@ -27,6 +27,7 @@ Fuente: Pan Docs - LCD Timing, V-Blank, LY Register
 from __future__ import annotations
 
 import logging
+import struct
 from typing import TYPE_CHECKING
 
 if TYPE_CHECKING:
@@ -443,6 +444,24 @@ class PPU:
         if self.lyc != old_lyc:
             self._check_stat_interrupt()
 
+    # Estado para snapshots (src/snapshot.py): LY, clock, modo, frame listo, LYC, línea STAT
+    _STATE_FORMAT = struct.Struct("<BIB?B?")
+    
+    def save_state(self) -> bytes:
+        """Serializa el estado de timing de la PPU."""
+        return self._STATE_FORMAT.pack(
+            self.ly, self.clock, self.mode, self.frame_ready, self.lyc, self.stat_interrupt_line
+        )
+    
+    def state_size(self) -> int:
+        """Tamaño en bytes de save_state() (snapshot lo comprueba antes de restaurar)."""
+        return self._STATE_FORMAT.size
+    
+    def load_state(self, data: bytes) -> None:
+        """Restaura un estado de save_state()."""
+        (self.ly, self.clock, self.mode, self.frame_ready, self.lyc,
+         self.stat_interrupt_line) = self._STATE_FORMAT.unpack(data)
+
     def is_frame_ready(self) -> bool:
         """
         Comprueba si hay un frame listo para renderizar y resetea el flag.
@@ -0,0 +1,268 @@
+"""
+Registro de Escrituras de la PPU - Re-renderizado offline de ejecuciones largas
+
+En ejecuciones largas sin pantalla (pruebas, grabaciones de demos), componer cada
+frame en el hilo de emulación es trabajo desperdiciado si las imágenes solo se
+necesitan después. En su lugar se registran, durante la emulación, las escrituras
+que determinan la imagen: VRAM (ambos bancos), OAM (incluidas las copias DMA) y
+los registros LCD que usa el renderer. Después, una herramienta independiente
+(tools/rerender_ppu_log.py) reconstruye el estado y compone los frames, repartiendo
+el trabajo entre procesos.
+
+Formato del archivo (little-endian):
+
+    Cabecera:  magic "VIBOYPPU" (8) | versión u16 | intervalo de keyframes u16
+    Registros: addr u16 | valor u8 | LY u8   (4 bytes)
+
+Las direcciones 0x0000-0x7FFF (ROM) nunca se registran como escrituras, así que
+se reutilizan como etiquetas:
+
+    TAG_FRAME    (0x0000): fin de frame. El estado en ese punto es el del frame.
+    TAG_OAM      (0x0001): copia DMA, seguida de los 160 bytes de OAM.
+    TAG_KEYFRAME (0x0002): estado completo, seguido de VRAM banco 0 (8 KiB),
+                           VRAM banco 1 (8 KiB), OAM (160), registros
+                           0xFF40-0xFF4B (12) y VBK (1).
+
+Cada `keyframe_interval` frames se escribe un keyframe: es el punto desde el que
+un proceso puede empezar a reconstruir sin leer el registro desde el principio.
+Al cerrar se añade un índice (frame, offset) de los keyframes y un trailer:
+
+    Índice:  por keyframe: frame u64 | offset u64
+    Trailer: magic "VPPUINDX" (8) | offset del índice u64 | keyframes u64 | frames u64
+
+Si el emulador no cerró el registro (sin trailer), el lector recorre el archivo
+para reconstruir el índice.
+
+Fuente: Pan Docs - VRAM, OAM, OAM DMA Transfer, LCD Control/Position/Palettes
+"""
+
+from __future__ import annotations
+
+import logging
+import struct
+from dataclasses import dataclass
+from pathlib import Path
+from typing import TYPE_CHECKING, Iterator
+
+if TYPE_CHECKING:
+    from ..memory.mmu import MMU
+    from .ppu import PPU
+
+logger = logging.getLogger(__name__)
+
+MAGIC = b"VIBOYPPU"
+INDEX_MAGIC = b"VPPUINDX"
+VERSION = 1
+
+HEADER_STRUCT = struct.Struct("<8sHH")
+RECORD_STRUCT = struct.Struct("<HBB")
+INDEX_ENTRY_STRUCT = struct.Struct("<QQ")
+TRAILER_STRUCT = struct.Struct("<8sQQQ")
+
+TAG_FRAME = 0x0000
+TAG_OAM = 0x0001
+TAG_KEYFRAME = 0x0002
+
+OAM_START, OAM_SIZE = 0xFE00, 0xA0
+VRAM_BANK_SIZE = 0x2000
+LCD_REGS_START, LCD_REGS_SIZE = 0xFF40, 12
+IO_VBK = 0xFF4F
+KEYFRAME_SIZE = 2 * VRAM_BANK_SIZE + OAM_SIZE + LCD_REGS_SIZE + 1
+
+# Registros LCD que se restauran desde un keyframe (LY, STAT, LYC y DMA no
+# afectan a la composición del frame y tienen efectos secundarios al escribirlos)
+LCD_RESTORE_REGS = (0xFF40, 0xFF42, 0xFF43, 0xFF47, 0xFF48, 0xFF49, 0xFF4A, 0xFF4B)
+
+DEFAULT_KEYFRAME_INTERVAL = 60
+
+# Tamaño del buffer en memoria antes de volcar al archivo
+FLUSH_SIZE = 1 << 16
+
+
+class PPUWriteLog:
+    """
+    Escritor del registro. La MMU llama a record()/record_oam_dma() en cada
+    escritura relevante y el bucle principal llama a end_frame() una vez por frame.
+    """
+
+    def __init__(self, path: str | Path, mmu: MMU, ppu: PPU | None = None,
+                 keyframe_interval: int = DEFAULT_KEYFRAME_INTERVAL) -> None:
+        """
+        Args:
+            path: Archivo de salida
+            mmu: MMU de la que se toman los keyframes
+            ppu: PPU de la que se toma LY para cada registro (None = LY 0)
+            keyframe_interval: Frames entre keyframes (1-65535)
+
+        Raises:
+            ValueError: Si el intervalo de keyframes no es válido
+        """
+        if not 1 <= keyframe_interval <= 0xFFFF:
+            raise ValueError(f"Intervalo de keyframes inválido: {keyframe_interval}")
+        self.path = Path(path)
+        self.keyframe_interval = keyframe_interval
+        self.frames = 0
+        self._mmu = mmu
+        self._ppu = ppu
+        self._file = open(self.path, "wb")
+        self._file.write(HEADER_STRUCT.pack(MAGIC, VERSION, keyframe_interval))
+        self._written = HEADER_STRUCT.size
+        self._buf = bytearray()
+        self._keyframes: list[tuple[int, int]] = []
+        self._write_keyframe()
+        logger.info(f"Registrando escrituras de la PPU en {self.path}")
+
+    def _ly(self) -> int:
+        return self._ppu.ly if self._ppu is not None else 0
+
+    def record(self, addr: int, value: int) -> None:
+        """Registra una escritura en VRAM, OAM, registros LCD (0xFF40-0xFF4B) o VBK."""
+        self._buf += RECORD_STRUCT.pack(addr, value, self._ly())
+
+    def record_oam_dma(self) -> None:
+        """Registra el contenido de OAM tras una transferencia DMA (un único bloque)."""
+        self._buf += RECORD_STRUCT.pack(TAG_OAM, 0, self._ly())
+        self._buf += self._mmu.get_oam_view()
+
+    def end_frame(self) -> None:
+        """Marca el fin de un frame y, si toca, escribe un keyframe."""
+        self._buf += RECORD_STRUCT.pack(TAG_FRAME, 0, self._ly())
+        self.frames += 1
+        if self.frames % self.keyframe_interval == 0:
+            self._write_keyframe()
+        if len(self._buf) >= FLUSH_SIZE:
+            self._flush()
+
+    def _write_keyframe(self) -> None:
+        mmu = self._mmu
+        self._keyframes.append((self.frames, self._written + len(self._buf)))
+        buf = self._buf
+        buf += RECORD_STRUCT.pack(TAG_KEYFRAME, 0, self._ly())
+        buf += mmu.get_vram_view(0)
+        buf += mmu.get_vram_view(1)
+        buf += mmu.get_oam_view()
+        buf += bytes(mmu.read_byte(LCD_REGS_START + i) & 0xFF for i in range(LCD_REGS_SIZE))
+        buf.append(mmu.read_byte(IO_VBK) & 0x01)
+
+    def _flush(self) -> None:
+        self._file.write(self._buf)
+        self._written += len(self._buf)
+        self._buf.clear()
+
+    def close(self) -> None:
+        """Vuelca lo pendiente y escribe el índice de keyframes y el trailer."""
+        if self._file is None:
+            return
+        self._flush()
+        index_offset = self._written
+        for frame, offset in self._keyframes:
+            self._file.write(INDEX_ENTRY_STRUCT.pack(frame, offset))
+        self._file.write(TRAILER_STRUCT.pack(INDEX_MAGIC, index_offset, len(self._keyframes), self.frames))
+        self._file.close()
+        self._file = None  # type: ignore[assignment]
+        logger.info(f"Registro de la PPU cerrado: {self.frames} frames, {len(self._keyframes)} keyframes")
+
+
+@dataclass
+class PPULogInfo:
+    """Metadatos de un registro: frames completos y keyframes (frame, offset)."""
+
+    keyframe_interval: int
+    frames: int
+    keyframes: list[tuple[int, int]]
+    data_end: int
+
+
+def read_log_info(path: str | Path) -> PPULogInfo:
+    """
+    Lee la cabecera y el índice de keyframes de un registro.
+
+    Si falta el trailer (registro no cerrado), recorre el archivo entero.
+
+    Raises:
+        ValueError: Si el archivo no es un registro de la PPU
+    """
+    data = Path(path).read_bytes()
+    magic, version, interval = HEADER_STRUCT.unpack_from(data, 0)
+    if magic != MAGIC or version != VERSION:
+        raise ValueError(f"{path} no es un registro de la PPU (versión {VERSION})")
+
+    if len(data) >= HEADER_STRUCT.size + TRAILER_STRUCT.size:
+        trailer = TRAILER_STRUCT.unpack_from(data, len(data) - TRAILER_STRUCT.size)
+        if trailer[0] == INDEX_MAGIC:
+            _, index_offset, count, frames = trailer
+            keyframes = [INDEX_ENTRY_STRUCT.unpack_from(data, index_offset + i * INDEX_ENTRY_STRUCT.size)
+                         for i in range(count)]
+            return PPULogInfo(interval, frames, keyframes, index_offset)
+
+    # Sin trailer: recorrer los registros (descartando un registro final incompleto)
+    keyframes = []
+    frames = 0
+    pos = HEADER_STRUCT.size
+    while pos + RECORD_STRUCT.size <= len(data):
+        addr = RECORD_STRUCT.unpack_from(data, pos)[0]
+        size = RECORD_STRUCT.size
+        if addr == TAG_OAM:
+            size += OAM_SIZE
+        elif addr == TAG_KEYFRAME:
+            size += KEYFRAME_SIZE
+        if pos + size > len(data):
+            break
+        if addr == TAG_FRAME:
+            frames += 1
+        elif addr == TAG_KEYFRAME:
+            keyframes.append((frames, pos))
+        pos += size
+    return PPULogInfo(interval, frames, keyframes, pos)
+
+
+def replay(path: str | Path, mmu: MMU, start_offset: int, count: int) -> Iterator[int]:
+    """
+    Aplica el registro a una MMU desde un keyframe y se detiene en cada fin de frame.
+
+    Args:
+        path: Registro de la PPU
+        mmu: MMU vacía en la que reconstruir el estado
+        start_offset: Offset de un keyframe (de PPULogInfo.keyframes)
+        count: Número de frames a reproducir
+
+    Yields:
+        Número de frame relativo (0, 1, ...) con la MMU en el estado de ese frame
+    """
+    with open(path, "rb") as f:
+        f.seek(start_offset)
+        write = mmu.write_byte
+        frame = 0
+        while frame < count:
+            record = f.read(RECORD_STRUCT.size)
+            if len(record) < RECORD_STRUCT.size:
+                return
+            addr, value, _ly = RECORD_STRUCT.unpack(record)
+            if addr == TAG_FRAME:
+                yield frame
+                frame += 1
+            elif addr == TAG_OAM:
+                for i, byte in enumerate(f.read(OAM_SIZE)):
+                    write(OAM_START + i, byte)
+            elif addr == TAG_KEYFRAME:
+                _load_keyframe(mmu, f.read(KEYFRAME_SIZE))
+            else:
+                write(addr, value)
+
+
+def _load_keyframe(mmu: MMU, snapshot: bytes) -> None:
+    """Restaura VRAM (ambos bancos), OAM, registros LCD y VBK desde un keyframe."""
+    write = mmu.write_byte
+    for bank in (0, 1):
+        write(IO_VBK, bank)
+        base = bank * VRAM_BANK_SIZE
+        for i, byte in enumerate(snapshot[base:base + VRAM_BANK_SIZE]):
+            write(0x8000 + i, byte)
+    pos = 2 * VRAM_BANK_SIZE
+    for i, byte in enumerate(snapshot[pos:pos + OAM_SIZE]):
+        mmu.write_byte(OAM_START + i, byte)
+    pos += OAM_SIZE
+    regs = snapshot[pos:pos + LCD_REGS_SIZE]
+    for addr in LCD_RESTORE_REGS:
+        mmu.write_byte(addr, regs[addr - LCD_REGS_START])
+    mmu.write_byte(IO_VBK, snapshot[pos + LCD_REGS_SIZE])
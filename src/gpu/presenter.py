@@ -0,0 +1,162 @@
+"""
+Presentadores - Cómo llega el framebuffer de 160x144 a la ventana
+
+El renderer compone cada frame en una superficie nativa de 160x144. Presentarlo
+en una ventana de 480x432 (scale=3) admite dos estrategias:
+
+- SurfacePresenter ("surface"): escalado por software. pygame.transform.scale
+  escribe el frame escalado directamente en la superficie de la ventana (o en
+  una superficie intermedia persistente si los formatos no coinciden) y se hace
+  display.flip(). Todo en CPU, sin crear superficies por frame. Es el
+  comportamiento original y el más compatible.
+
+- TexturePresenter ("texture"): streaming de texturas SDL2 (pygame._sdl2.video).
+  Se crea una única textura "streaming" de 160x144 para toda la vida de la
+  ventana. Cada frame se sube el framebuffer nativo (SDL_UpdateTexture) y el
+  renderer de SDL lo escala al dibujarlo: acelerado por GPU cuando hay driver,
+  por software en máquinas sin pantalla. Se evitan las dos copias escaladas.
+
+Las pantallas auxiliares (pantalla de carga, volcado de VRAM) dibujan en
+`screen`, una superficie del tamaño de la ventana, y se muestran con
+present_screen(); son poco frecuentes y no necesitan la ruta rápida.
+
+Fuente: SDL2 Wiki - SDL_CreateTexture (SDL_TEXTUREACCESS_STREAMING), SDL_UpdateTexture,
+SDL_RenderCopy; pygame docs - pygame._sdl2.video
+"""
+
+from __future__ import annotations
+
+import logging
+
+try:
+    import pygame
+except ImportError:
+    pygame = None  # type: ignore
+
+logger = logging.getLogger(__name__)
+
+
+class SurfacePresenter:
+    """Presentación por software: transform.scale + blit + display.flip()."""
+
+    name = "surface"
+
+    def __init__(self, width: int, height: int, title: str) -> None:
+        """
+        Args:
+            width: Ancho de la ventana en píxeles
+            height: Alto de la ventana en píxeles
+            title: Título de la ventana
+        """
+        self.size = (width, height)
+        self.screen = pygame.display.set_mode(self.size)
+        pygame.display.set_caption(title)
+        # Destino del escalado (se elige con el primer frame, ver _scale_target)
+        self._scaled: pygame.Surface | None = None
+
+    def _scale_target(self, buffer: pygame.Surface) -> pygame.Surface:
+        """
+        Superficie en la que escalar el framebuffer, creada una sola vez.
+
+        transform.scale solo escribe en una superficie con los mismos bytes por
+        píxel que el origen: si la ventana los tiene, se escala directamente en
+        ella; si no, en una superficie persistente con el formato del framebuffer.
+        """
+        if self.screen.get_bytesize() == buffer.get_bytesize():
+            return self.screen
+        return pygame.Surface(self.size, 0, buffer)
+
+    def present(self, buffer: pygame.Surface) -> None:
+        """Escala el framebuffer a la ventana y actualiza la pantalla."""
+        # pygame.transform.scale es rápido porque opera sobre una superficie completa;
+        # con superficie de destino no crea una nueva en cada frame
+        scaled = self._scaled
+        if scaled is None or scaled.get_bytesize() != buffer.get_bytesize():
+            scaled = self._scaled = self._scale_target(buffer)
+        pygame.transform.scale(buffer, self.size, scaled)
+        if scaled is not self.screen:
+            self.screen.blit(scaled, (0, 0))
+        pygame.display.flip()
+
+    def present_screen(self) -> None:
+        """Muestra lo dibujado directamente en `screen`."""
+        pygame.display.flip()
+
+    def set_title(self, title: str) -> None:
+        pygame.display.set_caption(title)
+
+    def set_icon(self, icon: pygame.Surface) -> None:
+        pygame.display.set_icon(icon)
+
+    def close(self) -> None:
+        """La ventana pertenece al módulo display: se cierra con pygame.quit()."""
+
+
+class TexturePresenter:
+    """Presentación con una textura SDL2 en streaming escalada por el renderer de SDL."""
+
+    name = "texture"
+
+    def __init__(self, width: int, height: int, title: str, texture_size: tuple[int, int]) -> None:
+        """
+        Args:
+            width: Ancho de la ventana en píxeles
+            height: Alto de la ventana en píxeles
+            title: Título de la ventana
+            texture_size: Tamaño del framebuffer nativo (160x144)
+
+        Raises:
+            ImportError: Si pygame no incluye pygame._sdl2
+            pygame.error: Si SDL no puede crear la ventana, el renderer o la textura
+        """
+        from pygame._sdl2 import video
+
+        self._video = video
+        self.size = (width, height)
+
+        # Una ventana con superficie del módulo display no admite un renderer SDL:
+        # se cierra (si existe) y se crea una ventana propia
+        pygame.display.quit()
+        pygame.display.init()
+        self.window = video.Window(title, size=self.size)
+        self.renderer = video.Renderer(self.window, vsync=False)
+        # Textura única, reutilizada durante toda la vida de la ventana
+        self.texture = video.Texture(self.renderer, texture_size, streaming=True)
+
+        # Superficie del tamaño de la ventana para pantallas auxiliares
+        self.screen = pygame.Surface(self.size, 0, 32)
+        # Copia de 32 bits del framebuffer (solo si el framebuffer no lo es),
+        # reutilizada en cada frame
+        self._converted: pygame.Surface | None = None
+        logger.info(f"Presentación por textura SDL2 ({texture_size[0]}x{texture_size[1]} -> {width}x{height})")
+
+    def present(self, buffer: pygame.Surface) -> None:
+        """Sube el framebuffer nativo a la textura y deja que SDL lo escale."""
+        # SDL_UpdateTexture copia los píxeles tal cual: la textura es de 32 bits.
+        # Un blit a la copia persistente convierte el formato sin crear superficies
+        if buffer.get_bytesize() != 4:
+            converted = self._converted
+            if converted is None or converted.get_size() != buffer.get_size():
+                converted = self._converted = pygame.Surface(buffer.get_size(), 0, 32)
+            converted.blit(buffer, (0, 0))
+            buffer = converted
+        self.texture.update(buffer)
+        self.texture.draw()
+        self.renderer.present()
+
+    def present_screen(self) -> None:
+        """Muestra `screen` (textura temporal: solo para pantallas auxiliares)."""
+        self._video.Texture.from_surface(self.renderer, self.screen).draw()
+        self.renderer.present()
+
+    def set_title(self, title: str) -> None:
+        self.window.title = title
+
+    def set_icon(self, icon: pygame.Surface) -> None:
+        self.window.set_icon(icon)
+
+    def close(self) -> None:
+        """Destruye la ventana (y con ella el renderer y la textura)."""
+        if self.window is not None:
+            self.window.destroy()
+            self.window = None  # type: ignore[assignment]
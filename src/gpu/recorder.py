@@ -0,0 +1,186 @@
+"""
+Grabación de Vídeo - Frames del emulador a Y4M o RGB crudo
+
+Grabar la pantalla del sistema anfitrión captura a la frecuencia del monitor y
+depende de la velocidad real de la emulación. Este grabador toma cada frame
+emulado directamente del framebuffer y lo escribe sin compresión:
+
+- Y4M (YUV4MPEG2, extensión .y4m): cabecera de texto más "FRAME\\n" y los planos
+  Y, Cb y Cr completos (4:4:4) por frame. Lo leen ffmpeg, mpv o x264 sin opciones.
+- RGB crudo (cualquier otra extensión): 160*144*3 bytes por frame, sin cabecera.
+  ffmpeg lo lee con: -f rawvideo -pixel_format rgb24 -video_size 160x144
+  -framerate 4194304/70224
+
+La frecuencia del vídeo es la de la Game Boy en tiempo emulado: 4194304/70224
+≈ 59,73 Hz (F4194304:70224 en la cabecera Y4M). Se escribe exactamente un frame
+por cada frame emulado, así que grabar a 10x (o sin pantalla) produce un vídeo
+a velocidad correcta.
+
+Reparto del trabajo:
+- Hilo de emulación: push() hace una única copia del framebuffer (bytes) y la
+  encola en una cola acotada. Si el escritor se queda atrás, push() espera en
+  lugar de descartar frames (un vídeo sin huecos es el objetivo).
+- Hilo escritor: conversión RGB -> YUV (solo Y4M) y escritura en disco.
+
+Fuente: YUV4MPEG2 (wiki de multimedia.cx, Y4M); ITU-R BT.601 (conversión RGB -> YCbCr
+de rango limitado); Pan Docs - LCD Timing (70224 ciclos por frame)
+"""
+
+from __future__ import annotations
+
+import logging
+import queue
+import threading
+from pathlib import Path
+
+try:
+    import numpy as np
+except ImportError:
+    np = None  # type: ignore
+
+logger = logging.getLogger(__name__)
+
+FRAME_WIDTH = 160
+FRAME_HEIGHT = 144
+FRAME_SIZE = FRAME_WIDTH * FRAME_HEIGHT * 3
+
+# Frecuencia de frames en tiempo emulado: reloj del sistema / ciclos por frame
+FRAME_RATE_NUM = 4_194_304
+FRAME_RATE_DEN = 70_224
+
+Y4M_HEADER = (
+    f"YUV4MPEG2 W{FRAME_WIDTH} H{FRAME_HEIGHT} F{FRAME_RATE_NUM}:{FRAME_RATE_DEN} "
+    "Ip A1:1 C444\n"
+).encode("ascii")
+Y4M_FRAME_HEADER = b"FRAME\n"
+
+# Tamaño por defecto de la cola: ~2 segundos de vídeo (~8 MiB)
+DEFAULT_QUEUE_FRAMES = 120
+
+
+def rgb_to_ycbcr(r: int, g: int, b: int) -> tuple[int, int, int]:
+    """
+    Convierte un color RGB a YCbCr BT.601 de rango limitado (Y 16-235, C 16-240).
+
+    Usa la aproximación entera habitual con coeficientes en 1/256.
+    """
+    y = ((66 * r + 129 * g + 25 * b + 128) >> 8) + 16
+    cb = ((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128
+    cr = ((112 * r - 94 * g - 18 * b + 128) >> 8) + 128
+    return y, cb, cr
+
+
+class VideoRecorder:
+    """
+    Graba frames RGB de 160x144 en un archivo Y4M o RGB crudo desde un hilo escritor.
+    """
+
+    def __init__(self, path: str | Path, fmt: str | None = None,
+                 max_queue: int = DEFAULT_QUEUE_FRAMES) -> None:
+        """
+        Args:
+            path: Archivo de salida
+            fmt: "y4m" o "raw" (None = según la extensión: .y4m -> y4m, resto -> raw)
+            max_queue: Frames que pueden esperar al escritor antes de frenar la emulación
+
+        Raises:
+            ValueError: Si el formato no es conocido
+            OSError: Si no se puede crear el archivo
+        """
+        self.path = Path(path)
+        if fmt is None:
+            fmt = "y4m" if self.path.suffix.lower() == ".y4m" else "raw"
+        if fmt not in ("y4m", "raw"):
+            raise ValueError(f"Formato de vídeo desconocido: {fmt}")
+        self.format = fmt
+        self.frames = 0
+
+        self._file = open(self.path, "wb")
+        if fmt == "y4m":
+            self._file.write(Y4M_HEADER)
+
+        # Caché de conversión color -> (Y, Cb, Cr) para el camino sin NumPy
+        # (la DMG solo produce 4 colores, así que se llena enseguida)
+        self._ycbcr_cache: dict[tuple[int, int, int], tuple[int, int, int]] = {}
+
+        self._queue: queue.Queue[bytes | None] = queue.Queue(maxsize=max_queue)
+        self._error: BaseException | None = None
+        self._thread = threading.Thread(target=self._writer, name="viboy-recorder", daemon=True)
+        self._thread.start()
+        logger.info(f"Grabando vídeo {fmt} en {self.path}")
+
+    @property
+    def duration(self) -> float:
+        """Duración del vídeo grabado hasta ahora, en segundos de tiempo emulado."""
+        return self.frames * FRAME_RATE_DEN / FRAME_RATE_NUM
+
+    def push(self, frame: bytes | bytearray | memoryview) -> None:
+        """
+        Encola un frame (160*144*3 bytes RGB). Es la única parte que corre en el
+        hilo de emulación: una copia del buffer y un put() en la cola.
+
+        Args:
+            frame: Frame RGB fila a fila
+
+        Raises:
+            ValueError: Si el frame no tiene el tamaño esperado
+            RuntimeError: Si el grabador está cerrado
+            OSError: Si el hilo escritor falló (se propaga su error)
+        """
+        if self._file is None:
+            raise RuntimeError("El grabador está cerrado")
+        if self._error is not None:
+            raise self._error
+        if len(frame) != FRAME_SIZE:
+            raise ValueError(f"Frame de {len(frame)} bytes, se esperaban {FRAME_SIZE}")
+        # bytes() de un objeto bytes no copia: el llamante no puede modificarlo
+        self._queue.put(bytes(frame))
+        self.frames += 1
+
+    def close(self) -> None:
+        """Espera a que se escriban los frames pendientes y cierra el archivo."""
+        if self._file is None:
+            return
+        self._queue.put(None)
+        self._thread.join()
+        self._file.close()
+        self._file = None  # type: ignore[assignment]
+        logger.info(f"Vídeo cerrado: {self.frames} frames ({self.duration:.2f} s)")
+        if self._error is not None:
+            raise self._error
+
+    def _writer(self) -> None:
+        """Hilo escritor: convierte (si es Y4M) y escribe cada frame encolado."""
+        while True:
+            frame = self._queue.get()
+            if frame is None:
+                return
+            if self._error is not None:
+                # Tras un error se vacía la cola para no bloquear al hilo de emulación
+                continue
+            try:
+                if self.format == "y4m":
+                    self._file.write(Y4M_FRAME_HEADER)
+                    self._file.write(self._to_ycbcr_planes(frame))
+                else:
+                    self._file.write(frame)
+            except OSError as e:
+                logger.error(f"Error escribiendo vídeo: {e}")
+                self._error = e
+
+    def _to_ycbcr_planes(self, frame: bytes) -> bytes:
+        """Convierte un frame RGB empaquetado en los planos Y, Cb y Cr concatenados."""
+        if np is not None:
+            rgb = np.frombuffer(frame, dtype=np.uint8).reshape(-1, 3).astype(np.int32)
+            r, g, b = rgb[:, 0], rgb[:, 1], rgb[:, 2]
+            y = ((66 * r + 129 * g + 25 * b + 128) >> 8) + 16
+            cb = ((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128
+            cr = ((112 * r - 94 * g - 18 * b + 128) >> 8) + 128
+            return np.concatenate((y, cb, cr)).astype(np.uint8).tobytes()
+
+        cache = self._ycbcr_cache
+        colors = list(zip(frame[0::3], frame[1::3], frame[2::3]))
+        for color in set(colors).difference(cache):
+            cache[color] = rgb_to_ycbcr(*color)
+        pixels = [cache[color] for color in colors]
+        return bytes(p[0] for p in pixels) + bytes(p[1] for p in pixels) + bytes(p[2] for p in pixels)
@@ -29,13 +29,20 @@ except ImportError:
     pygame = None  # type: ignore
 
 if TYPE_CHECKING:
+    from collections.abc import Sequence
+
     from ..memory.mmu import MMU
 
 # Importar constantes de MMU para acceso a registros I/O
+from ..memory.cartridge import MODEL_DMG
 from ..memory.mmu import IO_LCDC, IO_BGP, IO_SCX, IO_SCY, IO_OBP0, IO_OBP1, IO_WX, IO_WY
+from .frame_blend import DEFAULT_PERSISTENCE, FRAME_BLEND_MODES, FrameBlender
+from .presenter import SurfacePresenter, TexturePresenter
 
 logger = logging.getLogger(__name__)
 
+WINDOW_TITLE = "Viboy Color"
+
 # Constantes de la Game Boy
 GB_WIDTH = 160  # Ancho de la pantalla en píxeles
 GB_HEIGHT = 144  # Alto de la pantalla en píxeles
@@ -45,6 +52,19 @@ VRAM_START = 0x8000  # Inicio de VRAM
 VRAM_END = 0x9FFF  # Fin de VRAM (8KB = 8192 bytes)
 VRAM_SIZE = VRAM_END - VRAM_START + 1  # 8192 bytes
 
+# Caché de tiles: 384 tiles por banco de VRAM (0x8000-0x97FF), 2 bancos (CGB)
+TILES_PER_BANK = 384
+TILE_CACHE_SLOTS = 2 * TILES_PER_BANK
+
+# Tablas Tile ID -> slot de caché (banco 0) según LCDC.4
+# - Unsigned (LCDC.4 = 1): tile ID 0-255 en 0x8000 + id * 16 -> slots 0-255
+# - Signed (LCDC.4 = 0): tile ID como int8 relativo a 0x9000 -> IDs 0-127 en los
+#   slots 256-383 (0x9000-0x97FF) e IDs 128-255 en los slots 128-255 (0x8800-0x8FFF)
+# Un tile del banco 1 (atributo CGB bit 3) usa el mismo slot + TILES_PER_BANK.
+# Fuente: Pan Docs - VRAM Tile Data
+TILE_SLOT_UNSIGNED: tuple[int, ...] = tuple(range(256))
+TILE_SLOT_SIGNED: tuple[int, ...] = tuple(256 + tile_id if tile_id < 128 else tile_id for tile_id in range(256))
+
 # Paleta de grises fija (para modo debug)
 # Color 0: Blanco (más claro)
 # Color 1: Gris claro
@@ -57,6 +77,25 @@ PALETTE_GREYSCALE = [
     (0, 0, 0),        # Color 3: Negro
 ]
 
+# Paletas de grises ya decodificadas para cada valor de BGP/OBP0/OBP1 (256 entradas).
+# Cada par de bits del registro elige el tono de un índice de color (bits 0-1 ->
+# índice 0, ..., bits 6-7 -> índice 3). Indexar la tabla evita construir una lista
+# de 4 colores por frame.
+# Fuente: Pan Docs - LCD Monochrome Palettes
+PALETTES_BY_REGISTER: tuple[tuple[tuple[int, int, int], ...], ...] = tuple(
+    tuple(PALETTE_GREYSCALE[(value >> shift) & 0x03] for shift in (0, 2, 4, 6))
+    for value in range(256)
+)
+
+# Tablas de decodificación 2bpp: para cada byte de una línea de tile, un entero
+# cuyos 8 bytes (big-endian, píxel 0 en el byte alto) valen el bit de cada píxel.
+# Una línea completa es TILE_ROW_LOW[byte1] | TILE_ROW_HIGH[byte2]: un índice de
+# color (0-3) por byte, sin recorrer los bits uno a uno.
+TILE_ROW_LOW: tuple[int, ...] = tuple(
+    sum(((value >> bit) & 0x01) << (8 * bit) for bit in range(8)) for value in range(256)
+)
+TILE_ROW_HIGH: tuple[int, ...] = tuple(row << 1 for row in TILE_ROW_LOW)
+
 
 def decode_tile_line(byte1: int, byte2: int) -> list[int]:
     """
@@ -85,26 +124,10 @@ def decode_tile_line(byte1: int, byte2: int) -> list[int]:
         Píxel 2: bit 5 = 1, 1 -> Color 3
         ...
     """
-    # Enmascarar valores a 8 bits
-    byte1 = byte1 & 0xFF
-    byte2 = byte2 & 0xFF
-    
-    pixels: list[int] = []
-    
-    # Recorrer cada bit de izquierda a derecha (bit 7 a bit 0)
-    for bit_pos in range(7, -1, -1):
-        # Extraer bit bajo (de byte1)
-        bit_low = (byte1 >> bit_pos) & 0x01
-        
-        # Extraer bit alto (de byte2)
-        bit_high = (byte2 >> bit_pos) & 0x01
-        
-        # Calcular color: (bit_alto << 1) | bit_bajo
-        # Esto produce: 0 (00), 1 (01), 2 (10), o 3 (11)
-        color = (bit_high << 1) | bit_low
-        pixels.append(color)
-    
-    return pixels
+    # Enmascarar valores a 8 bits y combinar las dos tablas:
+    # cada byte del resultado es (bit_alto << 1) | bit_bajo del píxel
+    row = TILE_ROW_LOW[byte1 & 0xFF] | TILE_ROW_HIGH[byte2 & 0xFF]
+    return list(row.to_bytes(TILE_SIZE, "big"))
 
 
 class Renderer:
@@ -134,6 +157,27 @@ class Renderer:
         self.mmu = mmu
         self.scale = scale
         
+        # OPTIMIZACIÓN: Vistas directas de VRAM (banco 0), OAM y tilemaps
+        # Las lecturas de tilemap, datos de tile y OAM indexan estas vistas en lugar
+        # de pasar por mmu.read_byte(): miles de llamadas menos por frame. Los
+        # registros I/O (LCDC, paletas, scroll) sí se siguen leyendo con read_byte().
+        # Índices: vram[addr - 0x8000], oam[sprite * 4 + byte], tile_maps[LCDC.3][fila * 32 + col]
+        self.vram = mmu.get_vram_view(0)
+        self.vram_banks = (self.vram, mmu.get_vram_view(1))
+        self.oam = mmu.get_oam_view()
+        self.tile_maps = (mmu.get_tile_map_view(0), mmu.get_tile_map_view(1))
+        # Atributos CGB de los tilemaps (mismas posiciones en el banco 1).
+        # None en DMG: el bucle de tiles no consulta el banco de cada tile
+        self.tile_attr_maps = None
+        if getattr(mmu, "MODEL", None) != MODEL_DMG:
+            self.tile_attr_maps = (self.vram_banks[1][0x1800:0x1C00], self.vram_banks[1][0x1C00:0x2000])
+        
+        # Backend de composición: None = pygame (ver set_compositor)
+        self._numpy_compositor = None
+        
+        # Mezcla de frames antes de presentar: None = desactivada (ver set_frame_blending)
+        self._frame_blender: FrameBlender | None = None
+        
         # Dimensiones de la ventana (GB_WIDTH x GB_HEIGHT escalado)
         self.window_width = GB_WIDTH * scale
         self.window_height = GB_HEIGHT * scale
@@ -141,18 +185,33 @@ class Renderer:
         # Inicializar Pygame
         pygame.init()
         
-        # Crear ventana
-        self.screen = pygame.display.set_mode((self.window_width, self.window_height))
-        pygame.display.set_caption("Viboy Color")
+        # Crear ventana (presentación por software por defecto, ver set_presenter)
+        self._presenter: SurfacePresenter | TexturePresenter = SurfacePresenter(
+            self.window_width, self.window_height, WINDOW_TITLE
+        )
+        self.screen = self._presenter.screen
+        self._icon: pygame.Surface | None = None
         
         # OPTIMIZACIÓN: Tile Caching
-        # La Game Boy tiene 384 tiles únicos en VRAM (0x8000-0x97FF = 6KB = 384 tiles * 16 bytes)
+        # Cada banco de VRAM tiene 384 tiles únicos (0x8000-0x97FF = 6KB = 384 tiles * 16 bytes).
         # En lugar de decodificar cada tile píxel a píxel en cada frame, los cacheamos
         # como superficies pygame de 8x8 y solo los actualizamos cuando cambian.
         # Esto reduce el trabajo de ~23k píxeles a ~360 blits (mucho más rápido).
+        # Una sola caché de 768 slots (banco * 384 + tile) cubre los dos bancos y ambos
+        # modos de direccionamiento (ver TILE_SLOT_UNSIGNED/TILE_SLOT_SIGNED).
+        # Las superficies son indexadas (8 bits, colores 0-3): la paleta BGP se aplica
+        # con set_palette() y un cambio de BGP no obliga a decodificar de nuevo.
         # Fuente: Pan Docs - VRAM Tile Data
-        self.tile_cache: dict[int, pygame.Surface] = {}  # tile_id -> Surface(8x8)
-        self.tile_dirty = [True] * 384  # Flags para tiles 0-383 (0x8000-0x97FF)
+        self.tile_cache: list[pygame.Surface | None] = [None] * TILE_CACHE_SLOTS  # slot -> Surface(8x8)
+        self.tile_dirty = [True] * TILE_CACHE_SLOTS  # Flags por slot
+        self._tile_palette: Sequence[tuple[int, int, int]] = PALETTE_GREYSCALE  # Paleta aplicada a la caché
+        
+        # Caché de sprites: por slot, sus 4 variantes de flip ya decodificadas
+        # (None = hay que decodificar). Comparte la invalidación con la caché de fondo.
+        # Las superficies de cada slot se crean una vez (_sprite_surfaces) y al
+        # invalidarse se reescriben sus píxeles: mover o animar sprites no crea objetos.
+        self.sprite_tile_cache: list[list[pygame.Surface] | None] = [None] * TILE_CACHE_SLOTS
+        self._sprite_surfaces: list[list[pygame.Surface] | None] = [None] * TILE_CACHE_SLOTS
         
         # BIG BLIT OPTIMIZACIÓN: Buffer persistente para el tilemap completo (256x256 píxeles = 32x32 tiles)
         # Este buffer se construye una vez y solo se actualiza cuando cambian tiles o paleta.
@@ -167,7 +226,8 @@ class Renderer:
         if icon_path.exists():
             try:
                 icon_surface = pygame.image.load(str(icon_path))
-                pygame.display.set_icon(icon_surface)
+                self._presenter.set_icon(icon_surface)
+                self._icon = icon_surface
                 logger.info(f"Icono de aplicación cargado: {icon_path}")
             except Exception as e:
                 logger.warning(f"No se pudo cargar el icono {icon_path}: {e}")
@@ -276,76 +336,96 @@ class Renderer:
             self.screen.blit(text_surface, (text_x, text_y))
             
             # Actualizar pantalla
-            pygame.display.flip()
+            self._presenter.present_screen()
             
             # Controlar FPS (60 FPS para animación suave)
             clock.tick(60)
         
         # Limpiar pantalla al finalizar
         self.screen.fill((0, 0, 0))
-        pygame.display.flip()
+        self._presenter.present_screen()
     
     def mark_tile_dirty(self, tile_index: int) -> None:
         """
         Marca un tile como "dirty" (sucio) para que se actualice en la caché.
         
-        Este método se llama desde la MMU cuando se escribe en VRAM (0x8000-0x97FF).
-        Solo los tiles en este rango se cachean (384 tiles = 6KB).
+        Este método se llama desde la MMU cuando se escribe en VRAM (0x8000-0x97FF)
+        de cualquiera de los dos bancos.
         
         Args:
-            tile_index: Índice del tile (0-383) correspondiente a VRAM 0x8000-0x97FF
+            tile_index: Slot de caché (0-767): banco * 384 + índice del tile en 0x8000-0x97FF
         """
-        if 0 <= tile_index < 384:
+        if 0 <= tile_index < TILE_CACHE_SLOTS:
             self.tile_dirty[tile_index] = True
+            self.sprite_tile_cache[tile_index] = None
             # Marcar bg_buffer como dirty para que se reconstruya en el siguiente frame
             self.bg_buffer_dirty = True
     
-    def update_tile_cache(self, palette: list[tuple[int, int, int]]) -> None:
+    def _decode_tile(self, slot: int, flip_y: bool = False) -> int:
+        """
+        Decodifica las 8 filas de un tile a índices de color (0-3).
+        
+        El resultado es un entero de 64 bytes, un índice de color por píxel:
+        to_bytes(64, "big") da las filas de arriba abajo y to_bytes(64, "little")
+        el tile girado 180° (X-Flip + Y-Flip). Lee directamente de la vista de VRAM.
+        
+        Args:
+            slot: Slot de caché (banco * 384 + índice del tile)
+            flip_y: Si True, las filas van de abajo arriba (Y-Flip)
+            
+        Returns:
+            Píxeles del tile empaquetados en un entero
+        """
+        bank, tile_index = divmod(slot, TILES_PER_BANK)
+        vram = self.vram_banks[bank]
+        base = tile_index * BYTES_PER_TILE
+        row_low = TILE_ROW_LOW
+        row_high = TILE_ROW_HIGH
+        pixels = 0
+        for line in (range(TILE_SIZE - 1, -1, -1) if flip_y else range(TILE_SIZE)):
+            addr = base + line * 2
+            pixels = (pixels << 64) | row_low[vram[addr]] | row_high[vram[addr + 1]]
+        return pixels
+    
+    def update_tile_cache(self, palette: Sequence[tuple[int, int, int]]) -> None:
         """
         Actualiza la caché de tiles marcados como "dirty".
         
-        Decodifica los tiles sucios desde VRAM y los guarda como superficies pygame
-        de 8x8 píxeles. Esto permite usar blits rápidos en lugar de decodificar
-        píxel a píxel en cada frame.
+        Decodifica los tiles sucios desde VRAM (ambos bancos) y los guarda como
+        superficies indexadas de 8x8 píxeles. Tras esta llamada todos los slots
+        están poblados: ningún camino de renderizado decodifica píxeles en línea.
+        Si la paleta cambió, se reasigna a las superficies ya cacheadas.
+        
+        La superficie de cada slot se crea la primera vez; después un tile sucio
+        solo reescribe sus 64 bytes de píxeles.
         
         Args:
-            palette: Paleta de 4 colores RGB para decodificar los tiles
+            palette: Paleta de 4 colores RGB para los índices 0-3
         """
-        # Recorrer todos los tiles (0-383)
-        for tile_index in range(384):
-            if not self.tile_dirty[tile_index]:
+        tile_cache = self.tile_cache
+        
+        # Cambio de paleta: solo hay que reasignarla, los índices no cambian
+        if palette != self._tile_palette:
+            self._tile_palette = palette
+            for tile_surface in tile_cache:
+                if tile_surface is not None:
+                    tile_surface.set_palette(palette)
+        
+        tile_dirty = self.tile_dirty
+        for slot in range(TILE_CACHE_SLOTS):
+            if not tile_dirty[slot]:
                 continue  # Tile no ha cambiado, saltar
             
-            # Calcular dirección base del tile en VRAM
-            # Tiles 0-383 están en 0x8000-0x97FF (6KB)
-            tile_addr = VRAM_START + (tile_index * BYTES_PER_TILE)
-            
-            # Crear superficie de 8x8 píxeles para este tile
-            tile_surface = pygame.Surface((TILE_SIZE, TILE_SIZE))
-            
-            # Decodificar el tile línea por línea
-            for line in range(TILE_SIZE):
-                # Cada línea ocupa 2 bytes
-                byte1_addr = tile_addr + (line * 2)
-                byte2_addr = tile_addr + (line * 2) + 1
-                
-                # Leer bytes de VRAM
-                byte1 = self.mmu.read_byte(byte1_addr) & 0xFF
-                byte2 = self.mmu.read_byte(byte2_addr) & 0xFF
-                
-                # Decodificar la línea de 8 píxeles
-                pixels = decode_tile_line(byte1, byte2)
-                
-                # Dibujar cada píxel en la superficie
-                for pixel_x, color_index in enumerate(pixels):
-                    color = palette[color_index]
-                    tile_surface.set_at((pixel_x, line), color)
-            
-            # Guardar en caché
-            self.tile_cache[tile_index] = tile_surface
+            # Superficie indexada de 8x8 píxeles para este slot (8 bits, pitch 8)
+            tile_surface = tile_cache[slot]
+            if tile_surface is None:
+                tile_surface = pygame.Surface((TILE_SIZE, TILE_SIZE), depth=8)
+                tile_surface.set_palette(palette)
+                tile_cache[slot] = tile_surface
+            tile_surface.get_buffer().write(self._decode_tile(slot).to_bytes(64, "big"))
             
             # Marcar como limpio
-            self.tile_dirty[tile_index] = False
+            tile_dirty[slot] = False
 
     def render_vram_debug(self) -> None:
         """
@@ -388,7 +468,7 @@ class Renderer:
                 break
         
         # Actualizar la pantalla
-        pygame.display.flip()
+        self._presenter.present_screen()
 
     def render_frame(self) -> None:
         """
@@ -411,6 +491,12 @@ class Renderer:
         
         Fuente: Pan Docs - LCD Control Register, Background Tile Map, Window
         """
+        # Backend NumPy (opcional): compone el frame completo de forma vectorizada
+        if self._numpy_compositor is not None:
+            pygame.surfarray.blit_array(self.buffer, self._numpy_compositor.compose().swapaxes(0, 1))
+            self._present_buffer()
+            return
+        
         # Leer registro LCDC
         lcdc = self.mmu.read_byte(IO_LCDC) & 0xFF
         lcdc_bit7 = (lcdc & 0x80) != 0
@@ -427,9 +513,7 @@ class Renderer:
         if not lcdc_bit7:
             # Pantalla blanca cuando LCD está apagado (comportamiento real del hardware)
             self.buffer.fill((255, 255, 255))
-            scaled_buffer = pygame.transform.scale(self.buffer, (self.window_width, self.window_height))
-            self.screen.blit(scaled_buffer, (0, 0))
-            pygame.display.flip()
+            self._present_buffer()
             return
         
         # HACK EDUCATIVO: Ignorar Bit 0 de LCDC (BG Display)
@@ -462,19 +546,13 @@ class Renderer:
         
         # Bit 3: Tile Map Area
         # 0 = 0x9800, 1 = 0x9C00
-        if (lcdc & 0x08) == 0:
-            map_base = 0x9800
-        else:
-            map_base = 0x9C00
+        bg_tile_map = self.tile_maps[(lcdc >> 3) & 0x01]
         
         # Bit 4: Tile Data Area
         # 1 = 0x8000 (unsigned: tile IDs 0-255)
         # 0 = 0x8800 (signed: tile IDs -128 a 127, donde 0 está en 0x9000)
         unsigned_addressing = (lcdc & 0x10) != 0
-        if unsigned_addressing:
-            data_base = 0x8000
-        else:
-            data_base = 0x8800  # Signed addressing: tile ID 0 está en 0x9000
+        tile_slots = TILE_SLOT_UNSIGNED if unsigned_addressing else TILE_SLOT_SIGNED
         
         # Decodificar paleta BGP
         # BGP es un byte donde cada par de bits representa el color para el índice 0-3:
@@ -483,12 +561,8 @@ class Renderer:
         # Bits 4-5: Color para índice 2
         # Bits 6-7: Color para índice 3
         # Cada par de bits puede ser 0-3, pero en Game Boy original solo hay 4 tonos de gris
-        palette = [
-            PALETTE_GREYSCALE[(bgp >> 0) & 0x03],
-            PALETTE_GREYSCALE[(bgp >> 2) & 0x03],
-            PALETTE_GREYSCALE[(bgp >> 4) & 0x03],
-            PALETTE_GREYSCALE[(bgp >> 6) & 0x03],
-        ]
+        # (tabla precalculada: no se construye una lista por frame)
+        palette = PALETTES_BY_REGISTER[bgp]
         
         # Logs de paleta desactivados para mejorar rendimiento
         
@@ -512,11 +586,8 @@ class Renderer:
         lcdc_bit5 = (lcdc & 0x20) != 0  # Bit 5: Window Enable
         lcdc_bit6 = (lcdc & 0x40) != 0  # Bit 6: Window Tile Map Area (0=0x9800, 1=0x9C00)
         
-        # Determinar tilemap base para Window
-        if lcdc_bit6:
-            window_map_base = 0x9C00
-        else:
-            window_map_base = 0x9800
+        # Determinar tilemap para Window
+        window_tile_map = self.tile_maps[1 if lcdc_bit6 else 0]
         
         # Logs de window desactivados para mejorar rendimiento
         
@@ -545,78 +616,32 @@ class Renderer:
         offset_x = scx % TILE_SIZE  # Offset en píxeles dentro del primer tile
         offset_y = scy % TILE_SIZE  # Offset en píxeles dentro del primer tile
         
+        buffer_blit = self.buffer.blit
+        tile_cache = self.tile_cache
+        
         # Renderizar los tiles visibles del fondo
+        tile_attr_maps = self.tile_attr_maps
+        bg_attr_map = tile_attr_maps[(lcdc >> 3) & 0x01] if tile_attr_maps is not None else None
         for screen_tile_y in range(tiles_visible_y + 1):  # +1 para cubrir el offset
+            # Fila del tilemap (con wrap-around de 32x32) y posición en pantalla
+            row_base = ((start_tile_y + screen_tile_y) % 32) * 32
+            screen_y = (screen_tile_y * TILE_SIZE) - offset_y
+            if bg_attr_map is None:
+                # DMG: todos los tiles están en el banco 0
+                for screen_tile_x in range(tiles_visible_x + 1):
+                    buffer_blit(tile_cache[tile_slots[bg_tile_map[row_base + (start_tile_x + screen_tile_x) % 32]]],
+                                ((screen_tile_x * TILE_SIZE) - offset_x, screen_y))
+                continue
             for screen_tile_x in range(tiles_visible_x + 1):  # +1 para cubrir el offset
-                # Calcular posición del tile en el tilemap (con wrap-around de 32x32)
-                tile_map_x = (start_tile_x + screen_tile_x) % 32
-                tile_map_y = (start_tile_y + screen_tile_y) % 32
-                
-                # Leer Tile ID del tilemap
-                map_addr = map_base + (tile_map_y * 32) + tile_map_x
-                tile_id = self.mmu.read_byte(map_addr) & 0xFF
-                
-                # Calcular índice del tile en la caché según el modo de direccionamiento
-                if unsigned_addressing:
-                    # Modo unsigned: tile_id es 0-255, pero solo cacheamos 0-383 (0x8000-0x97FF)
-                    if tile_id < 384:
-                        cached_tile_id = tile_id
-                    else:
-                        # Tile fuera del rango cacheado, decodificar directamente
-                        cached_tile_id = None
-                        tile_addr = data_base + (tile_id * BYTES_PER_TILE)
-                else:
-                    # Modo signed: tile_id es -128 a 127, donde 0 está en 0x9000
-                    if tile_id >= 128:
-                        signed_id = tile_id - 256
-                    else:
-                        signed_id = tile_id
-                    tile_addr = 0x9000 + (signed_id * BYTES_PER_TILE)
-                    # Convertir dirección a índice de caché (0x8000-0x97FF)
-                    if VRAM_START <= tile_addr <= 0x97FF:
-                        cached_tile_id = (tile_addr - VRAM_START) // BYTES_PER_TILE
-                    else:
-                        cached_tile_id = None
-                
-                # Calcular posición en pantalla (aplicar offset de scroll)
-                screen_x = (screen_tile_x * TILE_SIZE) - offset_x
-                screen_y = (screen_tile_y * TILE_SIZE) - offset_y
+                map_index = row_base + (start_tile_x + screen_tile_x) % 32
                 
-                # Verificar si el tile está visible en pantalla
-                if screen_x < -TILE_SIZE or screen_x >= GB_WIDTH:
-                    continue
-                if screen_y < -TILE_SIZE or screen_y >= GB_HEIGHT:
-                    continue
+                # Tile ID -> slot de caché (bit 3 del atributo CGB = banco 1)
+                slot = tile_slots[bg_tile_map[map_index]]
+                if bg_attr_map[map_index] & 0x08:
+                    slot += TILES_PER_BANK
                 
-                # Dibujar tile usando caché o decodificar directamente
-                if cached_tile_id is not None and cached_tile_id in self.tile_cache:
-                    # Blit rápido desde caché
-                    self.buffer.blit(self.tile_cache[cached_tile_id], (screen_x, screen_y))
-                else:
-                    # Tile fuera de caché, decodificar directamente (raro, pero posible)
-                    if unsigned_addressing:
-                        tile_addr = data_base + (tile_id * BYTES_PER_TILE)
-                    else:
-                        if tile_id >= 128:
-                            signed_id = tile_id - 256
-                        else:
-                            signed_id = tile_id
-                        tile_addr = 0x9000 + (signed_id * BYTES_PER_TILE)
-                    
-                    if VRAM_START <= tile_addr <= VRAM_END:
-                        # Decodificar tile directamente (fallback)
-                        for line in range(TILE_SIZE):
-                            byte1_addr = tile_addr + (line * 2)
-                            byte2_addr = tile_addr + (line * 2) + 1
-                            byte1 = self.mmu.read_byte(byte1_addr) & 0xFF
-                            byte2 = self.mmu.read_byte(byte2_addr) & 0xFF
-                            pixels = decode_tile_line(byte1, byte2)
-                            for pixel_x, color_index in enumerate(pixels):
-                                color = palette[color_index]
-                                final_x = screen_x + pixel_x
-                                final_y = screen_y + line
-                                if 0 <= final_x < GB_WIDTH and 0 <= final_y < GB_HEIGHT:
-                                    self.buffer.set_at((final_x, final_y), color)
+                # Blit rápido desde caché (siempre poblada tras update_tile_cache)
+                buffer_blit(tile_cache[slot], ((screen_tile_x * TILE_SIZE) - offset_x, screen_y))
         
         # Renderizar Window encima del fondo (si está habilitada)
         if lcdc_bit5:
@@ -629,84 +654,159 @@ class Renderer:
             # La Window puede extenderse más allá de la pantalla, así que limitamos
             win_tiles_x = min(32, (GB_WIDTH - max(0, win_screen_x) + TILE_SIZE - 1) // TILE_SIZE)
             win_tiles_y = min(32, (GB_HEIGHT - max(0, win_screen_y) + TILE_SIZE - 1) // TILE_SIZE)
+            window_attr_map = tile_attr_maps[1 if lcdc_bit6 else 0] if tile_attr_maps is not None else None
             
             for tile_map_y in range(win_tiles_y):
+                tile_screen_y = win_screen_y + (tile_map_y * TILE_SIZE)
+                if tile_screen_y < -TILE_SIZE or tile_screen_y >= GB_HEIGHT:
+                    continue
                 for tile_map_x in range(win_tiles_x):
-                    # Leer Tile ID del tilemap de Window
-                    window_map_addr = window_map_base + (tile_map_y * 32) + tile_map_x
-                    tile_id = self.mmu.read_byte(window_map_addr) & 0xFF
-                    
                     # Calcular posición en pantalla
                     tile_screen_x = win_screen_x + (tile_map_x * TILE_SIZE)
-                    tile_screen_y = win_screen_y + (tile_map_y * TILE_SIZE)
                     
                     # Verificar si el tile está visible en pantalla
                     if tile_screen_x < -TILE_SIZE or tile_screen_x >= GB_WIDTH:
                         continue
-                    if tile_screen_y < -TILE_SIZE or tile_screen_y >= GB_HEIGHT:
-                        continue
                     
-                    # Calcular índice del tile en la caché
-                    if unsigned_addressing:
-                        if tile_id < 384:
-                            cached_tile_id = tile_id
-                        else:
-                            cached_tile_id = None
-                            tile_addr = data_base + (tile_id * BYTES_PER_TILE)
-                    else:
-                        if tile_id >= 128:
-                            signed_id = tile_id - 256
-                        else:
-                            signed_id = tile_id
-                        tile_addr = 0x9000 + (signed_id * BYTES_PER_TILE)
-                        if VRAM_START <= tile_addr <= 0x97FF:
-                            cached_tile_id = (tile_addr - VRAM_START) // BYTES_PER_TILE
-                        else:
-                            cached_tile_id = None
+                    # Leer Tile ID del tilemap de Window y resolver su slot de caché
+                    map_index = (tile_map_y * 32) + tile_map_x
+                    slot = tile_slots[window_tile_map[map_index]]
+                    if window_attr_map is not None and window_attr_map[map_index] & 0x08:
+                        slot += TILES_PER_BANK
                     
-                    # Dibujar tile usando caché o decodificar directamente
-                    if cached_tile_id is not None and cached_tile_id in self.tile_cache:
-                        # Blit rápido desde caché
-                        self.buffer.blit(self.tile_cache[cached_tile_id], (tile_screen_x, tile_screen_y))
-                    else:
-                        # Tile fuera de caché, decodificar directamente
-                        if unsigned_addressing:
-                            tile_addr = data_base + (tile_id * BYTES_PER_TILE)
-                        else:
-                            if tile_id >= 128:
-                                signed_id = tile_id - 256
-                            else:
-                                signed_id = tile_id
-                            tile_addr = 0x9000 + (signed_id * BYTES_PER_TILE)
-                        
-                        if VRAM_START <= tile_addr <= VRAM_END:
-                            # Decodificar tile directamente (fallback)
-                            for line in range(TILE_SIZE):
-                                byte1_addr = tile_addr + (line * 2)
-                                byte2_addr = tile_addr + (line * 2) + 1
-                                byte1 = self.mmu.read_byte(byte1_addr) & 0xFF
-                                byte2 = self.mmu.read_byte(byte2_addr) & 0xFF
-                                pixels = decode_tile_line(byte1, byte2)
-                                for pixel_x, color_index in enumerate(pixels):
-                                    color = palette[color_index]
-                                    final_x = tile_screen_x + pixel_x
-                                    final_y = tile_screen_y + line
-                                    if 0 <= final_x < GB_WIDTH and 0 <= final_y < GB_HEIGHT:
-                                        self.buffer.set_at((final_x, final_y), color)
+                    buffer_blit(tile_cache[slot], (tile_screen_x, tile_screen_y))
         
         # Renderizar sprites (OBJ) encima del fondo
         # Los sprites se dibujan después del fondo para que aparezcan por encima
         sprites_drawn = self.render_sprites()
         
-        # Escalar el framebuffer a la ventana y hacer blit
-        # pygame.transform.scale es rápido porque opera sobre una superficie completa
-        scaled_buffer = pygame.transform.scale(self.buffer, (self.window_width, self.window_height))
-        self.screen.blit(scaled_buffer, (0, 0))
-        
-        # Actualizar la pantalla
-        pygame.display.flip()
+        self._present_buffer()
         # Logs de frame desactivados para mejorar rendimiento
 
+    def _present_buffer(self) -> None:
+        """Lleva el framebuffer (160x144) a la ventana a través del presentador activo."""
+        if self._frame_blender is not None:
+            self._presenter.present(self._frame_blender.apply(self.buffer))
+        else:
+            self._presenter.present(self.buffer)
+
+    def set_frame_blending(self, mode: str | None, persistence: float = DEFAULT_PERSISTENCE) -> None:
+        """
+        Activa o desactiva la mezcla de frames (simula la persistencia del LCD).
+        
+        La mezcla solo afecta a lo que se presenta: get_framebuffer_rgb() sigue
+        devolviendo el frame sin mezclar.
+        
+        Args:
+            mode: None (desactivada), "mix" (50/50 con el frame anterior) o
+                  "persistence" (exponencial)
+            persistence: Peso de la salida anterior en modo "persistence" (0.0-1.0)
+            
+        Raises:
+            ValueError: Si el modo o la persistencia no son válidos
+        """
+        if mode is None:
+            self._frame_blender = None
+        else:
+            self._frame_blender = FrameBlender((GB_WIDTH, GB_HEIGHT), mode, persistence)
+        logger.info(f"Mezcla de frames: {mode or 'desactivada'}")
+
+    def get_frame_blending(self) -> str | None:
+        """Modo de mezcla de frames activo (None = desactivada)."""
+        return self._frame_blender.mode if self._frame_blender is not None else None
+
+    def cycle_frame_blending(self) -> str | None:
+        """Pasa al siguiente modo de mezcla (desactivada -> mix -> persistence -> ...)."""
+        current = FRAME_BLEND_MODES.index(self.get_frame_blending())
+        mode = FRAME_BLEND_MODES[(current + 1) % len(FRAME_BLEND_MODES)]
+        self.set_frame_blending(mode)
+        return mode
+
+    def set_presenter(self, name: str) -> str:
+        """
+        Selecciona cómo se presenta el framebuffer en la ventana.
+        
+        - "surface": escalado por software con transform.scale + display.flip() (por defecto)
+        - "texture": textura SDL2 en streaming escalada por el renderer de SDL; si
+          pygame._sdl2 no está disponible o SDL falla se vuelve a "surface"
+        
+        Cambiar de presentador recrea la ventana.
+        
+        Args:
+            name: "surface" o "texture"
+            
+        Returns:
+            Nombre del presentador que queda activo
+            
+        Raises:
+            ValueError: Si el nombre no es un presentador conocido
+        """
+        if name not in ("surface", "texture"):
+            raise ValueError(f"Presentador desconocido: {name}")
+        if name == self._presenter.name:
+            return name
+        
+        self._presenter.close()
+        if name == "texture":
+            try:
+                self._presenter = TexturePresenter(
+                    self.window_width, self.window_height, WINDOW_TITLE, (GB_WIDTH, GB_HEIGHT)
+                )
+            except (ImportError, pygame.error) as e:
+                logger.warning(f"Presentación por textura no disponible ({e}), usando surface")
+                name = "surface"
+        if name == "surface":
+            self._presenter = SurfacePresenter(self.window_width, self.window_height, WINDOW_TITLE)
+        
+        if self._icon is not None:
+            self._presenter.set_icon(self._icon)
+        self.screen = self._presenter.screen
+        logger.info(f"Presentador de frames: {name}")
+        return name
+
+    def get_presenter(self) -> str:
+        """Nombre del presentador activo ("surface" o "texture")."""
+        return self._presenter.name
+
+    def set_title(self, title: str) -> None:
+        """Cambia el título de la ventana."""
+        self._presenter.set_title(title)
+
+    def set_compositor(self, name: str) -> str:
+        """
+        Selecciona el backend que compone cada frame.
+        
+        - "pygame": blits de tiles cacheados (por defecto, sin dependencias extra)
+        - "numpy": composición vectorizada (src/gpu/numpy_compositor.py); si NumPy
+          no está instalado se vuelve automáticamente a "pygame"
+        
+        Args:
+            name: "pygame" o "numpy"
+            
+        Returns:
+            Nombre del backend que queda activo
+            
+        Raises:
+            ValueError: Si el nombre no es un backend conocido
+        """
+        if name not in ("pygame", "numpy"):
+            raise ValueError(f"Compositor desconocido: {name}")
+        
+        self._numpy_compositor = None
+        if name == "numpy":
+            try:
+                from .numpy_compositor import NumpyCompositor
+                self._numpy_compositor = NumpyCompositor(self.mmu)
+            except ImportError as e:
+                logger.warning(f"Compositor NumPy no disponible ({e}), usando pygame")
+                return "pygame"
+        logger.info(f"Compositor de frames: {name}")
+        return name
+
+    def get_compositor(self) -> str:
+        """Nombre del backend de composición activo ("pygame" o "numpy")."""
+        return "numpy" if self._numpy_compositor is not None else "pygame"
+
     def _draw_tile_with_palette(self, x: int, y: int, tile_addr: int, palette: list[tuple[int, int, int]]) -> None:
         """
         Dibuja un tile de 8x8 píxeles en la posición (x, y) usando una paleta específica.
@@ -720,12 +820,11 @@ class Renderer:
         # Recorrer cada línea del tile (8 líneas)
         for line in range(TILE_SIZE):
             # Cada línea ocupa 2 bytes
-            byte1_addr = tile_addr + (line * 2)
-            byte2_addr = tile_addr + (line * 2) + 1
+            offset = tile_addr - VRAM_START + (line * 2)
             
             # Leer bytes de VRAM
-            byte1 = self.mmu.read_byte(byte1_addr)
-            byte2 = self.mmu.read_byte(byte2_addr)
+            byte1 = self.vram[offset]
+            byte2 = self.vram[offset + 1]
             
             # Decodificar la línea
             pixels = decode_tile_line(byte1, byte2)
@@ -746,6 +845,49 @@ class Renderer:
                     (screen_x, screen_y, self.scale, self.scale)
                 )
 
+    def _get_sprite_tile(self, tile_index: int) -> list[pygame.Surface]:
+        """
+        Devuelve las 4 variantes de flip de un tile de sprite, decodificándolas si hace falta.
+        
+        Cada variante es una superficie indexada de 8 bits (8x8) cuyos píxeles son
+        los índices de color 0-3 del tile. El índice 0 es el colorkey: actúa como
+        máscara de transparencia, de modo que un único blit compone las 8 filas del
+        tile sin tocar los píxeles transparentes. La paleta (OBP0/OBP1) se asigna
+        justo antes del blit, así que la caché no depende de la paleta.
+        
+        Las entradas se invalidan en mark_tile_dirty(), igual que la caché de fondo.
+        
+        Args:
+            tile_index: Slot de caché del tile (banco 0: índice 0-255 a partir de 0x8000)
+            
+        Returns:
+            Lista [normal, X-Flip, Y-Flip, X+Y-Flip]
+        """
+        variants = self.sprite_tile_cache[tile_index]
+        if variants is not None:
+            return variants
+        
+        variants = self._sprite_surfaces[tile_index]
+        if variants is None:
+            variants = []
+            for _ in range(4):
+                surface = pygame.Surface((TILE_SIZE, TILE_SIZE), depth=8)
+                surface.set_colorkey(0)
+                variants.append(surface)
+            self._sprite_surfaces[tile_index] = variants
+        
+        # Filas de arriba abajo y de abajo arriba; el orden de bytes little-endian
+        # invierte además cada fila (X-Flip)
+        pixels = self._decode_tile(tile_index)
+        flipped = self._decode_tile(tile_index, flip_y=True)
+        variants[0].get_buffer().write(pixels.to_bytes(64, "big"))
+        variants[1].get_buffer().write(flipped.to_bytes(64, "little"))
+        variants[2].get_buffer().write(flipped.to_bytes(64, "big"))
+        variants[3].get_buffer().write(pixels.to_bytes(64, "little"))
+        
+        self.sprite_tile_cache[tile_index] = variants
+        return variants
+
     def render_sprites(self) -> int:
         """
         Renderiza los sprites (OBJ - Objects) desde OAM (Object Attribute Memory).
@@ -777,19 +919,9 @@ class Renderer:
         obp0 = self.mmu.read_byte(IO_OBP0) & 0xFF  # Object Palette 0
         obp1 = self.mmu.read_byte(IO_OBP1) & 0xFF  # Object Palette 1
         
-        # Decodificar paletas (igual que BGP)
-        palette0 = [
-            PALETTE_GREYSCALE[(obp0 >> 0) & 0x03],
-            PALETTE_GREYSCALE[(obp0 >> 2) & 0x03],
-            PALETTE_GREYSCALE[(obp0 >> 4) & 0x03],
-            PALETTE_GREYSCALE[(obp0 >> 6) & 0x03],
-        ]
-        palette1 = [
-            PALETTE_GREYSCALE[(obp1 >> 0) & 0x03],
-            PALETTE_GREYSCALE[(obp1 >> 2) & 0x03],
-            PALETTE_GREYSCALE[(obp1 >> 4) & 0x03],
-            PALETTE_GREYSCALE[(obp1 >> 6) & 0x03],
-        ]
+        # Decodificar paletas (igual que BGP, con la tabla precalculada)
+        palette0 = PALETTES_BY_REGISTER[obp0]
+        palette1 = PALETTES_BY_REGISTER[obp1]
         
         # Si las paletas están en 0x00 (todo blanco), usar paleta por defecto
         if obp0 == 0x00:
@@ -797,106 +929,64 @@ class Renderer:
         if obp1 == 0x00:
             palette1 = PALETTE_GREYSCALE
         
-        oam_base = 0xFE00  # OAM comienza en 0xFE00
-        sprites_per_oam = 40  # 40 sprites máximo
-        bytes_per_sprite = 4  # Cada sprite ocupa 4 bytes
+        # Bit 2 de LCDC: altura de los sprites (0 = 8x8, 1 = 8x16)
+        sprite_height = 16 if (lcdc & 0x04) != 0 else TILE_SIZE
+        
+        # OAM: 160 bytes = 40 sprites * 4 bytes (vista directa)
+        oam = self.oam
         
+        buffer_blit = self.buffer.blit
+        get_tile = self._get_sprite_tile
         sprites_drawn = 0
         
         # Recorrer todos los sprites en OAM
-        for sprite_index in range(sprites_per_oam):
-            sprite_addr = oam_base + (sprite_index * bytes_per_sprite)
-            
-            # Leer atributos del sprite
-            sprite_y = self.mmu.read_byte(sprite_addr + 0) & 0xFF
-            sprite_x = self.mmu.read_byte(sprite_addr + 1) & 0xFF
-            tile_id = self.mmu.read_byte(sprite_addr + 2) & 0xFF
-            attributes = self.mmu.read_byte(sprite_addr + 3) & 0xFF
-            
-            # Decodificar atributos
-            priority = (attributes & 0x80) != 0  # Bit 7: Prioridad (0 = encima de fondo, 1 = detrás)
-            y_flip = (attributes & 0x40) != 0     # Bit 6: Y-Flip (voltear verticalmente)
-            x_flip = (attributes & 0x20) != 0     # Bit 5: X-Flip (voltear horizontalmente)
-            palette_num = (attributes >> 4) & 0x01  # Bit 4: Paleta (0 = OBP0, 1 = OBP1)
+        for sprite_addr in range(0, 160, 4):
+            sprite_y = oam[sprite_addr]
+            sprite_x = oam[sprite_addr + 1]
             
-            # Seleccionar paleta según bit 4
-            palette = palette0 if palette_num == 0 else palette1
+            # Un sprite está oculto si Y=0 o X=0
+            if sprite_y == 0 or sprite_x == 0:
+                continue  # Sprite oculto, saltar
             
             # Calcular posición en pantalla
             # Y e X tienen offset: Y = sprite_y - 16, X = sprite_x - 8
-            # Si Y o X son 0, el sprite está oculto
             screen_y = sprite_y - 16
             screen_x = sprite_x - 8
             
-            # Verificar si el sprite está visible en pantalla
-            # Un sprite está oculto si Y=0 o X=0 (o fuera de los límites)
-            if sprite_y == 0 or sprite_x == 0:
-                continue  # Sprite oculto, saltar
-            
             # Verificar si el sprite está dentro de los límites de la pantalla
-            if screen_y < -7 or screen_y >= GB_HEIGHT or screen_x < -7 or screen_x >= GB_WIDTH:
+            if screen_y <= -sprite_height or screen_y >= GB_HEIGHT or screen_x < -7 or screen_x >= GB_WIDTH:
                 continue  # Sprite fuera de pantalla, saltar
             
-            # Calcular dirección del tile en VRAM
-            # Los sprites siempre usan direccionamiento unsigned desde 0x8000
-            tile_addr = VRAM_START + (tile_id * BYTES_PER_TILE)
-            
-            # Verificar que el tile esté en VRAM
-            if tile_addr < VRAM_START or tile_addr > VRAM_END:
-                continue  # Tile fuera de VRAM, saltar
-            
-            # Dibujar el sprite tile por tile (8x8 píxeles)
-            # NOTA: Por ahora solo soportamos sprites de 8x8. Los sprites de 8x16
-            # requieren leer 2 tiles consecutivos, pero eso se implementará más adelante.
-            with pygame.PixelArray(self.buffer) as pixels:
-                for tile_y in range(TILE_SIZE):
-                    for tile_x in range(TILE_SIZE):
-                        # Calcular posición del píxel dentro del tile
-                        # Aplicar flip si es necesario
-                        if y_flip:
-                            pixel_tile_y = TILE_SIZE - 1 - tile_y
-                        else:
-                            pixel_tile_y = tile_y
-                        
-                        if x_flip:
-                            pixel_tile_x = TILE_SIZE - 1 - tile_x
-                        else:
-                            pixel_tile_x = tile_x
-                        
-                        # Calcular posición final en pantalla
-                        final_y = screen_y + tile_y
-                        final_x = screen_x + tile_x
-                        
-                        # Verificar si el píxel está dentro de los límites
-                        if final_y < 0 or final_y >= GB_HEIGHT or final_x < 0 or final_x >= GB_WIDTH:
-                            continue  # Píxel fuera de pantalla
-                        
-                        # Leer el píxel del tile
-                        tile_line_addr = tile_addr + (pixel_tile_y * 2)
-                        byte1 = self.mmu.read_byte(tile_line_addr) & 0xFF
-                        byte2 = self.mmu.read_byte(tile_line_addr + 1) & 0xFF
-                        
-                        # Decodificar el píxel específico
-                        bit_pos = 7 - pixel_tile_x
-                        bit_low = (byte1 >> bit_pos) & 0x01
-                        bit_high = (byte2 >> bit_pos) & 0x01
-                        color_index = (bit_high << 1) | bit_low
-                        
-                        # CRÍTICO: El color 0 en sprites es transparente
-                        # No dibujar si color_index == 0
-                        if color_index == 0:
-                            continue
-                        
-                        # NOTA: Por ahora ignoramos la prioridad (bit 7 de atributos)
-                        # En el futuro, si priority=True, el sprite debe dibujarse detrás
-                        # del fondo (excepto color 0 del fondo). Por ahora, todos los sprites
-                        # se dibujan encima del fondo.
-                        
-                        # Obtener color de la paleta
-                        color = palette[color_index]
-                        
-                        # Dibujar píxel en el framebuffer
-                        pixels[final_x, final_y] = color
+            tile_id = oam[sprite_addr + 2]
+            attributes = oam[sprite_addr + 3]
+            
+            # Decodificar atributos
+            # Bit 7: Prioridad (por ahora ignorada: todos los sprites se dibujan encima
+            # del fondo). Bit 6: Y-Flip. Bit 5: X-Flip. Bit 4: Paleta (0 = OBP0, 1 = OBP1)
+            y_flip = (attributes & 0x40) != 0
+            palette = palette1 if (attributes & 0x10) else palette0
+            # Índice de variante en la caché: bit 0 = X-Flip, bit 1 = Y-Flip
+            variant = ((attributes >> 5) & 0x01) | ((attributes >> 5) & 0x02)
+            
+            # Los sprites siempre usan direccionamiento unsigned desde 0x8000.
+            # En modo 8x16 el bit 0 del Tile ID se ignora: arriba va el tile par y
+            # abajo el impar. Con Y-Flip se invierte el sprite completo (16 líneas),
+            # así que además de voltear cada mitad se intercambian.
+            if sprite_height == 16:
+                top_id = tile_id & 0xFE
+                bottom_id = tile_id | 0x01
+                if y_flip:
+                    top_id, bottom_id = bottom_id, top_id
+                top = get_tile(top_id)[variant]
+                bottom = get_tile(bottom_id)[variant]
+                top.set_palette(palette)
+                bottom.set_palette(palette)
+                buffer_blit(top, (screen_x, screen_y))
+                buffer_blit(bottom, (screen_x, screen_y + TILE_SIZE))
+            else:
+                surface = get_tile(tile_id)[variant]
+                surface.set_palette(palette)
+                buffer_blit(surface, (screen_x, screen_y))
             
             sprites_drawn += 1
         
@@ -914,12 +1004,11 @@ class Renderer:
         # Recorrer cada línea del tile (8 líneas)
         for line in range(TILE_SIZE):
             # Cada línea ocupa 2 bytes
-            byte1_addr = tile_addr + (line * 2)
-            byte2_addr = tile_addr + (line * 2) + 1
+            offset = tile_addr - VRAM_START + (line * 2)
             
             # Leer bytes de VRAM
-            byte1 = self.mmu.read_byte(byte1_addr)
-            byte2 = self.mmu.read_byte(byte2_addr)
+            byte1 = self.vram[offset]
+            byte2 = self.vram[offset + 1]
             
             # Decodificar la línea
             pixels = decode_tile_line(byte1, byte2)
@@ -964,9 +1053,19 @@ class Renderer:
         
         return True
 
+    def get_framebuffer_rgb(self) -> bytes:
+        """
+        Devuelve el último frame compuesto (160x144) como bytes RGB empaquetados.
+        
+        Returns:
+            160 * 144 * 3 bytes, fila a fila (R, G, B por píxel)
+        """
+        return pygame.image.tobytes(self.buffer, "RGB")
+
     def quit(self) -> None:
         """Cierra Pygame limpiamente."""
         if pygame is not None:
+            self._presenter.close()
             pygame.quit()
             logger.info("Renderer cerrado")
 
@@ -0,0 +1,248 @@
+"""
+Pantalla en Terminal - Framebuffer con semibloques Unicode y color de 24 bits
+
+En máquinas sin pantalla a las que se accede por SSH no hay ventana donde ver
+la emulación. Este backend dibuja el framebuffer de 160x144 en la terminal:
+
+- Cada celda de texto muestra dos píxeles verticales con el carácter "▀"
+  (semibloque superior): el color de primer plano pinta el píxel de arriba y el
+  de fondo el de abajo. 160x144 píxeles -> 160 columnas x 72 filas.
+- Colores con secuencias SGR de 24 bits: ESC[38;2;R;G;Bm (primer plano) y
+  ESC[48;2;R;G;Bm (fondo).
+
+Para que un frame típico cueste pocos KB de salida:
+- Codificación delta: solo se emiten las celdas que cambiaron desde el último
+  frame dibujado. Un par de filas idéntico se descarta con una sola comparación.
+- Agrupación por tramos: las celdas cambiadas consecutivas comparten un único
+  movimiento de cursor (ESC[fila;columnaH) y el color solo se vuelve a emitir
+  cuando cambia respecto a la celda anterior (en la DMG hay 4 colores).
+
+La frecuencia de refresco es independiente de la velocidad de emulación: el
+bucle principal entrega frames con submit() solo cuando wants_frame() indica
+que toca, y un hilo propio los codifica y escribe a la frecuencia configurada.
+
+Fuente: ECMA-48 (CSI CUP y SGR); ITU-T T.416 / xterm (color directo 38;2 y 48;2);
+Unicode U+2580 UPPER HALF BLOCK
+"""
+
+from __future__ import annotations
+
+import logging
+import sys
+import threading
+import time
+from typing import TextIO
+
+logger = logging.getLogger(__name__)
+
+FRAME_WIDTH = 160
+FRAME_HEIGHT = 144
+ROW_BYTES = FRAME_WIDTH * 3
+CELL_ROWS = FRAME_HEIGHT // 2
+
+UPPER_HALF_BLOCK = "▀"
+
+CSI = "\x1b["
+RESET = CSI + "0m"
+HIDE_CURSOR = CSI + "?25l"
+SHOW_CURSOR = CSI + "?25h"
+ALT_SCREEN_ON = CSI + "?1049h"
+ALT_SCREEN_OFF = CSI + "?1049l"
+CLEAR_SCREEN = CSI + "2J"
+
+DEFAULT_TERMINAL_FPS = 15
+
+
+class TerminalFrameEncoder:
+    """
+    Convierte frames RGB (160x144) en secuencias ANSI con codificación delta.
+
+    Recuerda el último frame codificado y el color activo de la terminal entre
+    llamadas, así que cada encode() solo describe lo que cambió.
+    """
+
+    def __init__(self, origin: tuple[int, int] = (1, 1)) -> None:
+        """
+        Args:
+            origin: (fila, columna) de la terminal, base 1, de la esquina superior izquierda
+        """
+        self.origin_row, self.origin_col = origin
+        self._previous: bytes | None = None
+        # Color activo de la terminal (None = desconocido)
+        self._fg: bytes | None = None
+        self._bg: bytes | None = None
+        # Cachés de secuencias SGR por color (bytes RGB -> texto)
+        self._fg_codes: dict[bytes, str] = {}
+        self._bg_codes: dict[bytes, str] = {}
+
+    def reset(self) -> None:
+        """Olvida el frame anterior: el siguiente encode() redibuja todo."""
+        self._previous = None
+        self._fg = self._bg = None
+
+    def _fg_code(self, color: bytes) -> str:
+        code = self._fg_codes.get(color)
+        if code is None:
+            code = f"38;2;{color[0]};{color[1]};{color[2]}"
+            self._fg_codes[color] = code
+        return code
+
+    def _bg_code(self, color: bytes) -> str:
+        code = self._bg_codes.get(color)
+        if code is None:
+            code = f"48;2;{color[0]};{color[1]};{color[2]}"
+            self._bg_codes[color] = code
+        return code
+
+    def encode(self, frame: bytes) -> str:
+        """
+        Codifica un frame respecto al anterior.
+
+        Args:
+            frame: 160 * 144 * 3 bytes RGB, fila a fila
+
+        Returns:
+            Secuencias ANSI y caracteres a escribir en la terminal ("" si no hay cambios)
+        """
+        previous = self._previous
+        out: list[str] = []
+        fg, bg = self._fg, self._bg
+
+        for cell_row in range(CELL_ROWS):
+            top_start = cell_row * 2 * ROW_BYTES
+            bottom_start = top_start + ROW_BYTES
+            pair_end = bottom_start + ROW_BYTES
+            if previous is not None and previous[top_start:pair_end] == frame[top_start:pair_end]:
+                continue
+
+            top = frame[top_start:bottom_start]
+            bottom = frame[bottom_start:pair_end]
+            if previous is not None:
+                prev_top = previous[top_start:bottom_start]
+                prev_bottom = previous[bottom_start:pair_end]
+            # Columna en la que está el cursor (-1 = hay que posicionarlo)
+            cursor = -1
+            row_code = f"{CSI}{self.origin_row + cell_row};"
+
+            for x in range(FRAME_WIDTH):
+                i = x * 3
+                t = top[i:i + 3]
+                b = bottom[i:i + 3]
+                if previous is not None and t == prev_top[i:i + 3] and b == prev_bottom[i:i + 3]:
+                    continue
+                if cursor != x:
+                    out.append(f"{row_code}{self.origin_col + x}H")
+                # Una sola secuencia SGR con los colores que cambian
+                if t != fg and b != bg:
+                    out.append(f"{CSI}{self._fg_code(t)};{self._bg_code(b)}m")
+                    fg, bg = t, b
+                elif t != fg:
+                    out.append(f"{CSI}{self._fg_code(t)}m")
+                    fg = t
+                elif b != bg:
+                    out.append(f"{CSI}{self._bg_code(b)}m")
+                    bg = b
+                out.append(UPPER_HALF_BLOCK)
+                cursor = x + 1
+
+        self._previous = bytes(frame)
+        self._fg, self._bg = fg, bg
+        return "".join(out)
+
+
+class TerminalDisplay:
+    """
+    Muestra frames en una terminal a una frecuencia fija, desde un hilo propio.
+    """
+
+    def __init__(self, stream: TextIO | None = None, fps: float = DEFAULT_TERMINAL_FPS,
+                 alternate_screen: bool = True) -> None:
+        """
+        Args:
+            stream: Salida (None = sys.stdout)
+            fps: Frecuencia de refresco de la terminal (independiente de la emulación)
+            alternate_screen: Usar la pantalla alternativa (se restaura al cerrar)
+
+        Raises:
+            ValueError: Si fps no es positivo
+        """
+        if fps <= 0:
+            raise ValueError(f"Frecuencia de refresco inválida: {fps}")
+        self.stream = stream if stream is not None else sys.stdout
+        self.interval = 1.0 / fps
+        self.alternate_screen = alternate_screen
+        self.bytes_written = 0
+        self.frames_drawn = 0
+        self._encoder = TerminalFrameEncoder()
+        self._pending: bytes | None = None
+        self._next_frame_time = 0.0
+        self._lock = threading.Lock()
+        self._wake = threading.Event()
+        self._stop = False
+        self._broken = False
+
+        self._write((ALT_SCREEN_ON if alternate_screen else "") + HIDE_CURSOR + CLEAR_SCREEN)
+        self._thread = threading.Thread(target=self._draw_loop, name="viboy-terminal", daemon=True)
+        self._thread.start()
+
+    def wants_frame(self) -> bool:
+        """Indica si toca entregar un frame (evita capturarlo en cada frame emulado)."""
+        return time.monotonic() >= self._next_frame_time
+
+    def submit(self, frame: bytes) -> None:
+        """
+        Entrega el frame más reciente. Si el hilo aún no dibujó el anterior, se sustituye.
+
+        Args:
+            frame: 160 * 144 * 3 bytes RGB (el objeto no debe modificarse después)
+        """
+        self._next_frame_time = time.monotonic() + self.interval
+        with self._lock:
+            self._pending = frame
+        self._wake.set()
+
+    def _draw_loop(self) -> None:
+        """Hilo de dibujo: codifica y escribe el último frame entregado."""
+        while True:
+            with self._lock:
+                frame, self._pending = self._pending, None
+                if frame is None:
+                    # Solo se sale con la cola vacía: un frame entregado mientras
+                    # se dibujaba el anterior también se dibuja antes de cerrar
+                    if self._stop:
+                        return
+                    self._wake.clear()
+            if frame is None:
+                self._wake.wait()
+                continue
+            self._draw(frame)
+            if self._broken:
+                return
+
+    def _draw(self, frame: bytes) -> None:
+        data = self._encoder.encode(frame)
+        if data:
+            self._write(data)
+        self.frames_drawn += 1
+
+    def _write(self, data: str) -> None:
+        try:
+            self.stream.write(data)
+            self.stream.flush()
+        except (OSError, ValueError) as e:
+            # Terminal cerrada (p. ej. sesión SSH caída): dejar de dibujar sin parar la emulación
+            logger.warning(f"Salida de terminal no disponible: {e}")
+            self._broken = True
+            return
+        self.bytes_written += len(data.encode("utf-8"))
+
+    def close(self) -> None:
+        """Dibuja el último frame pendiente, detiene el hilo y restaura la terminal."""
+        if self._thread is None:
+            return
+        with self._lock:
+            self._stop = True
+        self._wake.set()
+        self._thread.join()
+        self._thread = None  # type: ignore[assignment]
+        self._write(RESET + SHOW_CURSOR + (ALT_SCREEN_OFF if self.alternate_screen else "\n"))
@@ -0,0 +1,282 @@
+"""
+Entrada - Teclado y Mandos SDL hacia el Joypad
+
+Traduce eventos de pygame (teclado y mandos del API GameController de SDL) al
+estado del Joypad. Diseño:
+
+- Tabla de asignaciones precalculada: al cargar la configuración, cada tecla y
+  cada botón de mando se resuelve una sola vez a un bit de la máscara
+  empaquetada. En el bucle solo queda un dict.get() por evento.
+- Máscara empaquetada de 8 bits (1 = pulsado): bits 0-3 = Right, Left, Up, Down;
+  bits 4-7 = A, B, Select, Start (mismo orden que P1 en cada grupo). Tras
+  procesar todos los eventos de un sondeo, la máscara se entrega al Joypad con
+  una sola llamada, y solo si cambió.
+- Cada fuente (teclado, cada mando) guarda su propio estado y la máscara final
+  es su OR: soltar Z no suelta A si la tecla A sigue pulsada.
+- Sticks analógicos con zona muerta: el stick izquierdo actúa como cruceta
+  cuando su valor absoluto supera el umbral (rango SDL: -32768..32767).
+
+Los eventos se procesan desde una lista, así que los tests pueden usar eventos
+sintéticos (pygame.event.Event) sin ventana ni mando.
+
+Fuente: SDL2 Wiki - SDL_GameController (SDL_CONTROLLERBUTTONDOWN,
+SDL_CONTROLLERAXISMOTION, SDL_CONTROLLERDEVICEADDED); Pan Docs - Joypad Input
+"""
+
+from __future__ import annotations
+
+import json
+import logging
+from pathlib import Path
+from typing import TYPE_CHECKING, Any, Iterable
+
+from .joypad import BUTTON_BITS
+
+try:
+    import pygame
+except ImportError:
+    pygame = None  # type: ignore
+
+try:
+    from pygame._sdl2 import controller as sdl_controller
+except ImportError:
+    sdl_controller = None  # type: ignore
+
+if TYPE_CHECKING:
+    from .joypad import Joypad
+
+logger = logging.getLogger(__name__)
+
+# Botón -> bit de la máscara empaquetada (direcciones en el nibble bajo, botones en el alto)
+PACKED_BITS: dict[str, int] = {
+    name: bit << (4 * group) for name, (group, bit) in BUTTON_BITS.items()
+}
+
+# Asignaciones por defecto. Teclas: sufijo de las constantes pygame.K_*;
+# mando: sufijo de pygame.CONTROLLER_BUTTON_*
+DEFAULT_KEYBOARD: dict[str, list[str]] = {
+    "up": ["UP"],
+    "down": ["DOWN"],
+    "left": ["LEFT"],
+    "right": ["RIGHT"],
+    "a": ["z", "a"],
+    "b": ["x", "s"],
+    "start": ["RETURN"],
+    "select": ["RSHIFT"],
+}
+DEFAULT_CONTROLLER: dict[str, list[str]] = {
+    "up": ["DPAD_UP"],
+    "down": ["DPAD_DOWN"],
+    "left": ["DPAD_LEFT"],
+    "right": ["DPAD_RIGHT"],
+    "a": ["A"],
+    "b": ["B", "X"],
+    "start": ["START"],
+    "select": ["BACK"],
+}
+
+# Zona muerta por defecto de los sticks (~25% del recorrido)
+DEFAULT_DEADZONE = 8000
+
+
+def _constant(prefix: str, name: str) -> int:
+    """Resuelve el nombre de una tecla/botón a su constante de pygame."""
+    for candidate in (name, name.upper(), name.lower()):
+        value = getattr(pygame, prefix + candidate, None)
+        if isinstance(value, int):
+            return value
+    raise ValueError(f"Entrada desconocida: {prefix}{name}")
+
+
+class InputBindings:
+    """
+    Tabla de asignaciones resuelta: código de tecla / botón de mando -> bit empaquetado.
+    """
+
+    def __init__(self, keyboard: dict[str, list[str]] | None = None,
+                 controller: dict[str, list[str]] | None = None,
+                 deadzone: int = DEFAULT_DEADZONE) -> None:
+        """
+        Args:
+            keyboard: Botón -> nombres de tecla (sustituyen a los de por defecto de ese botón)
+            controller: Botón -> nombres de botón de mando (ídem)
+            deadzone: Umbral de los sticks analógicos (0-32767)
+
+        Raises:
+            ValueError: Si un botón, tecla o zona muerta no es válido
+        """
+        if pygame is None:
+            raise ImportError("pygame es necesario para la entrada")
+        if not 0 <= deadzone < 32767:
+            raise ValueError(f"Zona muerta fuera de rango: {deadzone}")
+        self.deadzone = deadzone
+        self.keys = self._resolve("K_", {**DEFAULT_KEYBOARD, **(keyboard or {})})
+        self.buttons = self._resolve("CONTROLLER_BUTTON_", {**DEFAULT_CONTROLLER, **(controller or {})})
+
+    @staticmethod
+    def _resolve(prefix: str, table: dict[str, list[str]]) -> dict[int, int]:
+        resolved: dict[int, int] = {}
+        for button, names in table.items():
+            bit = PACKED_BITS.get(button)
+            if bit is None:
+                raise ValueError(f"Botón de Game Boy desconocido: {button}")
+            for name in names:
+                resolved[_constant(prefix, name)] = bit
+        return resolved
+
+    @classmethod
+    def from_dict(cls, config: dict[str, Any]) -> InputBindings:
+        """Crea la tabla desde un dict con las claves keyboard, controller y deadzone."""
+        return cls(config.get("keyboard"), config.get("controller"),
+                   config.get("deadzone", DEFAULT_DEADZONE))
+
+    @classmethod
+    def load(cls, path: str | Path) -> InputBindings:
+        """
+        Carga la tabla desde un archivo JSON, por ejemplo:
+
+            {"keyboard": {"a": ["k"], "b": ["j"]}, "controller": {"b": ["B"]}, "deadzone": 12000}
+        """
+        with open(path, "r", encoding="utf-8") as f:
+            return cls.from_dict(json.load(f))
+
+
+class InputManager:
+    """
+    Procesa eventos de pygame y mantiene la máscara empaquetada del Joypad.
+    """
+
+    def __init__(self, joypad: Joypad | None, bindings: InputBindings | None = None) -> None:
+        """
+        Args:
+            joypad: Joypad que recibe la máscara (None = solo calcularla)
+            bindings: Tabla de asignaciones (None = por defecto)
+        """
+        self.joypad = joypad
+        self.bindings = bindings if bindings is not None else InputBindings()
+        self.mask = 0
+        # Teclas pulsadas -> bit (las no asignadas no se guardan)
+        self._held_keys: dict[int, int] = {}
+        # Por mando (instance_id): [botones, bits del eje X, bits del eje Y]
+        self._pads: dict[int, list[int]] = {}
+        # Mandos abiertos (hay que mantener la referencia para que SDL envíe eventos)
+        self._controllers: dict[int, Any] = {}
+
+    def set_bindings(self, bindings: InputBindings) -> None:
+        """Sustituye la tabla de asignaciones y olvida el estado actual."""
+        self.bindings = bindings
+        self._held_keys.clear()
+        for pad in self._pads.values():
+            pad[0] = pad[1] = pad[2] = 0
+        self._commit()
+
+    def init_controllers(self) -> int:
+        """
+        Inicializa el API GameController de SDL y abre los mandos conectados.
+        Los que se conecten después llegan como CONTROLLERDEVICEADDED.
+
+        Returns:
+            Número de mandos abiertos
+        """
+        if sdl_controller is None:
+            return 0
+        try:
+            sdl_controller.init()
+            for index in range(sdl_controller.get_count()):
+                self._open_controller(index)
+        except pygame.error as e:
+            logger.warning(f"Mandos no disponibles: {e}")
+        return len(self._controllers)
+
+    def _open_controller(self, device_index: int) -> None:
+        if sdl_controller is None or not sdl_controller.is_controller(device_index):
+            return
+        pad = sdl_controller.Controller(device_index)
+        instance_id = pad.as_joystick().get_instance_id()
+        self._controllers[instance_id] = pad
+        self._pads[instance_id] = [0, 0, 0]
+        logger.info(f"Mando conectado: {pad.name}")
+
+    def process(self, events: Iterable[Any]) -> None:
+        """
+        Procesa una tanda de eventos y entrega la máscara resultante al Joypad.
+
+        Args:
+            events: Eventos de pygame (los no relacionados con la entrada se ignoran)
+        """
+        keys = self.bindings.keys
+        held = self._held_keys
+        changed = False
+        for event in events:
+            etype = event.type
+            if etype == pygame.KEYDOWN:
+                bit = keys.get(event.key)
+                if bit is not None:
+                    held[event.key] = bit
+                    changed = True
+            elif etype == pygame.KEYUP:
+                if held.pop(event.key, None) is not None:
+                    changed = True
+            elif etype == pygame.CONTROLLERBUTTONDOWN or etype == pygame.CONTROLLERBUTTONUP:
+                bit = self.bindings.buttons.get(event.button)
+                if bit is not None:
+                    pad = self._pad(event.instance_id)
+                    if etype == pygame.CONTROLLERBUTTONDOWN:
+                        pad[0] |= bit
+                    else:
+                        pad[0] &= ~bit
+                    changed = True
+            elif etype == pygame.CONTROLLERAXISMOTION:
+                changed |= self._axis(event.instance_id, event.axis, event.value)
+            elif etype == pygame.CONTROLLERDEVICEADDED:
+                self._open_controller(event.device_index)
+            elif etype == pygame.CONTROLLERDEVICEREMOVED:
+                self._controllers.pop(event.instance_id, None)
+                if self._pads.pop(event.instance_id, None) is not None:
+                    changed = True
+        if changed:
+            self._commit()
+
+    def _pad(self, instance_id: int) -> list[int]:
+        pad = self._pads.get(instance_id)
+        if pad is None:
+            pad = self._pads[instance_id] = [0, 0, 0]
+        return pad
+
+    def _axis(self, instance_id: int, axis: int, value: int) -> bool:
+        """Convierte el stick izquierdo en cruceta según la zona muerta."""
+        deadzone = self.bindings.deadzone
+        if axis == pygame.CONTROLLER_AXIS_LEFTX:
+            slot = 1
+            bits = PACKED_BITS["left"] if value < -deadzone else PACKED_BITS["right"] if value > deadzone else 0
+        elif axis == pygame.CONTROLLER_AXIS_LEFTY:
+            slot = 2
+            bits = PACKED_BITS["up"] if value < -deadzone else PACKED_BITS["down"] if value > deadzone else 0
+        else:
+            return False
+        pad = self._pad(instance_id)
+        if pad[slot] == bits:
+            return False
+        pad[slot] = bits
+        return True
+
+    def _commit(self) -> None:
+        """Recalcula la máscara como OR de todas las fuentes y la entrega si cambió."""
+        mask = 0
+        for bit in self._held_keys.values():
+            mask |= bit
+        for buttons, x_bits, y_bits in self._pads.values():
+            mask |= buttons | x_bits | y_bits
+        if mask != self.mask:
+            self.mask = mask
+            if self.joypad is not None:
+                self.joypad.set_masks(mask & 0x0F, mask >> 4)
+
+    def close(self) -> None:
+        """Cierra los mandos abiertos."""
+        for pad in self._controllers.values():
+            try:
+                pad.quit()
+            except Exception:
+                pass
+        self._controllers.clear()
@@ -48,6 +48,18 @@ P1_BIT_B = 0x02       # Bit 1 (cuando se seleccionan botones)
 P1_BIT_SELECT = 0x04  # Bit 2 (cuando se seleccionan botones)
 P1_BIT_START = 0x08   # Bit 3 (cuando se seleccionan botones)
 
+# Nombre de botón -> (grupo, bit). Grupo 0 = direcciones, 1 = botones
+BUTTON_BITS: dict[str, tuple[int, int]] = {
+    "right": (0, P1_BIT_RIGHT),
+    "left": (0, P1_BIT_LEFT),
+    "up": (0, P1_BIT_UP),
+    "down": (0, P1_BIT_DOWN),
+    "a": (1, P1_BIT_A),
+    "b": (1, P1_BIT_B),
+    "select": (1, P1_BIT_SELECT),
+    "start": (1, P1_BIT_START),
+}
+
 
 class Joypad:
     """
@@ -56,6 +68,11 @@ class Joypad:
     Implementa la lógica Active Low donde 0 = pulsado y 1 = soltado.
     Maneja el selector de bits 4-5 del registro P1 y solicita interrupciones
     cuando un botón se pulsa.
+    
+    El estado se guarda como dos máscaras de 4 bits (1 = pulsado), una por grupo,
+    con el mismo orden de bits que P1. El valor de P1 se recalcula solo cuando
+    cambia algo (pulsación, liberación o escritura del selector): los juegos leen
+    P1 muchas veces por frame y cada lectura es devolver un entero.
     """
     
     def __init__(self, mmu: MMU | None = None) -> None:
@@ -65,31 +82,37 @@ class Joypad:
         Args:
             mmu: Referencia opcional a la MMU para solicitar interrupciones
         """
-        # Estado de los botones (True = pulsado, False = soltado)
-        # Por defecto, todos los botones están soltados (False)
-        self._state: dict[str, bool] = {
-            "right": False,
-            "left": False,
-            "up": False,
-            "down": False,
-            "a": False,
-            "b": False,
-            "select": False,
-            "start": False,
-        }
-        
-        # Estado anterior (para detectar transiciones)
-        self._prev_state: dict[str, bool] = self._state.copy()
+        # Máscaras de pulsación (1 = pulsado). Por defecto, todo soltado
+        self._directions: int = 0
+        self._buttons: int = 0
         
         # Selector actual (bits 4-5 del registro P1)
         # Por defecto, ningún selector está activo (0xCF = 11001111)
         # Bits 4-5 = 1 significa que NO queremos leer ese grupo
         self._selector: int = 0xCF  # 0xCF = 11001111 (bits 4-5 = 1, bits 0-3 = 1)
         
+        # Valor de P1 precalculado (ver _update_p1)
+        self._p1: int = 0xFF
+        
         # Referencia a la MMU para solicitar interrupciones
         self._mmu = mmu
         
-        logger.debug("Joypad inicializado: todos los botones soltados")
+        self._update_p1()
+    
+    def _update_p1(self) -> None:
+        """
+        Recalcula P1 a partir del selector y las máscaras.
+        
+        Los bits 0-3 empiezan a 1 y se ponen a 0 los botones pulsados de cada grupo
+        seleccionado (bit 4 = 0: direcciones; bit 5 = 0: botones). Si ambos grupos
+        están seleccionados, sus pulsaciones se combinan (AND de líneas activas a 0).
+        """
+        pressed = 0
+        if (self._selector & P1_SELECT_DIRECTIONS) == 0:
+            pressed |= self._directions
+        if (self._selector & P1_SELECT_BUTTONS) == 0:
+            pressed |= self._buttons
+        self._p1 = 0xFF & ~pressed
     
     def write(self, value: int) -> None:
         """
@@ -104,99 +127,89 @@ class Joypad:
         Args:
             value: Valor a escribir (se enmascara a 8 bits)
         """
-        # Enmascarar a 8 bits
-        value = value & 0xFF
-        
         # Solo los bits 4-5 son significativos para la escritura
-        # Los bits 0-3 son de solo lectura (estado de los botones)
         # Guardamos el selector completo (pero solo usaremos bits 4-5)
-        self._selector = value
-        
-        logger.debug(f"Joypad: Selector actualizado a 0x{self._selector:02X}")
+        self._selector = value & 0xFF
+        self._update_p1()
     
     def read(self) -> int:
         """
         Lee el registro P1 (estado de los botones según el selector).
         
-        Retorna el estado de los botones según el selector actual:
         - Si bit 4 = 0 (selecciona direcciones): bits 0-3 = Right, Left, Up, Down
         - Si bit 5 = 0 (selecciona botones): bits 0-3 = A, B, Select, Start
         
-        La lógica es Active Low:
-        - 0 = Botón pulsado
-        - 1 = Botón soltado
+        La lógica es Active Low (0 = pulsado, 1 = soltado).
         
         Returns:
-            Valor del registro P1 (8 bits) con el estado de los botones
+            Valor del registro P1 (8 bits), precalculado
+        """
+        return self._p1
+    
+    def set_masks(self, directions: int, buttons: int) -> None:
         """
-        # Empezar con todos los bits a 1 (todos los botones sueltos)
-        result = 0xFF
+        Establece el estado completo de una vez (API de bajo nivel).
         
-        # Si el bit 4 es 0, el juego quiere leer direcciones
-        if (self._selector & P1_SELECT_DIRECTIONS) == 0:
-            # Bits 0-3 contienen el estado de las direcciones
-            if self._state["right"]:
-                result &= ~P1_BIT_RIGHT  # Clear bit 0
-            if self._state["left"]:
-                result &= ~P1_BIT_LEFT   # Clear bit 1
-            if self._state["up"]:
-                result &= ~P1_BIT_UP     # Clear bit 2
-            if self._state["down"]:
-                result &= ~P1_BIT_DOWN   # Clear bit 3
-        
-        # Si el bit 5 es 0, el juego quiere leer botones
-        if (self._selector & P1_SELECT_BUTTONS) == 0:
-            # Bits 0-3 contienen el estado de los botones
-            if self._state["a"]:
-                result &= ~P1_BIT_A      # Clear bit 0
-            if self._state["b"]:
-                result &= ~P1_BIT_B      # Clear bit 1
-            if self._state["select"]:
-                result &= ~P1_BIT_SELECT # Clear bit 2
-            if self._state["start"]:
-                result &= ~P1_BIT_START  # Clear bit 3
-        
-        # Los bits 4-5 siempre reflejan el selector (lo que escribió el juego)
-        # Pero en lectura, el hardware los pone a 1 si no están seleccionados
-        # Por ahora, los mantenemos como están en el selector
-        
-        return result & 0xFF
+        Si algún botón pasa de soltado a pulsado, solicita la interrupción
+        Joypad (Bit 4 en IF, 0xFF0F).
+        
+        Args:
+            directions: Máscara de 4 bits (1 = pulsado): Right, Left, Up, Down
+            buttons: Máscara de 4 bits (1 = pulsado): A, B, Select, Start
+        """
+        directions &= 0x0F
+        buttons &= 0x0F
+        newly_pressed = (directions & ~self._directions) | (buttons & ~self._buttons)
+        if directions == self._directions and buttons == self._buttons:
+            return
+        self._directions = directions
+        self._buttons = buttons
+        self._update_p1()
+        
+        # Algún botón pasó de soltado a pulsado: solicitar interrupción
+        if newly_pressed and self._mmu is not None:
+            self._mmu.write_byte(IO_IF, self._mmu.read_byte(IO_IF) | 0x10)
+    
+    def save_state(self) -> bytes:
+        """
+        Serializa el selector de P1. Las máscaras de botones no se guardan: reflejan
+        la entrada actual del usuario, no el estado de la máquina.
+        """
+        return bytes((self._selector,))
+    
+    def state_size(self) -> int:
+        """Tamaño en bytes de save_state() (snapshot lo comprueba antes de restaurar)."""
+        return 1
+    
+    def load_state(self, data: bytes) -> None:
+        """Restaura un estado de save_state()."""
+        self.write(data[0])
+    
+    def get_masks(self) -> tuple[int, int]:
+        """
+        Returns:
+            (direcciones, botones): máscaras de 4 bits (1 = pulsado)
+        """
+        return self._directions, self._buttons
     
     def press(self, button: str) -> None:
         """
         Marca un botón como pulsado.
         
-        Si el botón estaba soltado y ahora está pulsado, solicita la interrupción
-        Joypad (Bit 4 en IF, 0xFF0F).
+        Si el botón estaba soltado, solicita la interrupción Joypad (Bit 4 en IF).
         
         Args:
             button: Nombre del botón ("right", "left", "up", "down", "a", "b", "select", "start")
         """
-        if button not in self._state:
+        entry = BUTTON_BITS.get(button)
+        if entry is None:
             logger.warning(f"Joypad: Botón desconocido '{button}', ignorando")
             return
-        
-        # Guardar estado anterior
-        was_pressed = self._state[button]
-        
-        # Si ya estaba pulsado, no hacer nada (evitar interrupciones duplicadas)
-        if was_pressed:
-            return
-        
-        # Marcar como pulsado
-        self._state[button] = True
-        
-        # El botón pasó de soltado a pulsado, solicitar interrupción
-        if self._mmu is not None:
-            # Leer IF actual
-            if_val = self._mmu.read_byte(IO_IF)
-            # Activar bit 4 (Joypad interrupt)
-            if_val |= 0x10
-            # Escribir de vuelta
-            self._mmu.write_byte(IO_IF, if_val)
-            logger.debug(f"Joypad: Interrupción solicitada por '{button}' (IF=0x{if_val:02X})")
-        
-        logger.debug(f"Joypad: '{button}' pulsado")
+        group, bit = entry
+        if group == 0:
+            self.set_masks(self._directions | bit, self._buttons)
+        else:
+            self.set_masks(self._directions, self._buttons | bit)
     
     def release(self, button: str) -> None:
         """
@@ -205,12 +218,15 @@ class Joypad:
         Args:
             button: Nombre del botón ("right", "left", "up", "down", "a", "b", "select", "start")
         """
-        if button not in self._state:
+        entry = BUTTON_BITS.get(button)
+        if entry is None:
             logger.warning(f"Joypad: Botón desconocido '{button}', ignorando")
             return
-        
-        self._state[button] = False
-        logger.debug(f"Joypad: '{button}' soltado")
+        group, bit = entry
+        if group == 0:
+            self.set_masks(self._directions & ~bit, self._buttons)
+        else:
+            self.set_masks(self._directions, self._buttons & ~bit)
     
     def get_state(self, button: str) -> bool:
         """
@@ -222,5 +238,8 @@ class Joypad:
         Returns:
             True si el botón está pulsado, False si está soltado
         """
-        return self._state.get(button, False)
-
+        entry = BUTTON_BITS.get(button)
+        if entry is None:
+            return False
+        group, bit = entry
+        return bool((self._buttons if group else self._directions) & bit)
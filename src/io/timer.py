@@ -36,6 +36,7 @@ Fuente: Pan Docs - Timer and Divider Registers
 from __future__ import annotations
 
 import logging
+import struct
 from typing import TYPE_CHECKING
 
 if TYPE_CHECKING:
@@ -304,6 +305,24 @@ class Timer:
         self._tac = value & 0x07
         logger.debug(f"Timer: TAC escrito = 0x{self._tac:02X} (Enable={bool(self._tac & TAC_ENABLE_MASK)}, Freq={self._tac & TAC_FREQ_MASK})")
     
+    # Estado para snapshots (src/snapshot.py): contador DIV, TIMA, TMA, TAC, acumulador
+    _STATE_FORMAT = struct.Struct("<H3BI")
+    
+    def save_state(self) -> bytes:
+        """Serializa el contador interno y los registros del Timer."""
+        return self._STATE_FORMAT.pack(
+            self._div_counter, self._tima, self._tma, self._tac, self._tima_accumulator
+        )
+    
+    def state_size(self) -> int:
+        """Tamaño en bytes de save_state() (snapshot lo comprueba antes de restaurar)."""
+        return self._STATE_FORMAT.size
+    
+    def load_state(self, data: bytes) -> None:
+        """Restaura un estado de save_state()."""
+        (self._div_counter, self._tima, self._tma, self._tac,
+         self._tima_accumulator) = self._STATE_FORMAT.unpack(data)
+    
     def set_mmu(self, mmu: MMU) -> None:
         """
         Establece la referencia a la MMU para permitir solicitar interrupciones.
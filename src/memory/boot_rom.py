@@ -0,0 +1,175 @@
+"""
+Boot ROM - Arranque real con caché del estado post-arranque
+
+Al encender la Game Boy se ejecuta una Boot ROM interna que inicializa el
+hardware, muestra el logo y salta a 0x0100. Sin ella, Viboy simula el
+"Post-Boot State" fijando los registros (ver Viboy._initialize_post_boot_state),
+pero algunos juegos dependen de otros efectos del arranque: valores de los
+registros I/O, el contenido de VRAM o las paletas de compatibilidad CGB.
+
+La Boot ROM la aporta el usuario (no se distribuye con el emulador):
+- DMG: 256 bytes, mapeados en 0x0000-0x00FF
+- CGB: 2304 bytes, mapeados en 0x0000-0x00FF y 0x0200-0x08FF (0x0100-0x01FF es
+  la cabecera del cartucho)
+
+Mientras está mapeada, BootROMOverlay se interpone entre la MMU y el cartucho.
+Escribir un valor distinto de cero en 0xFF50 la desmapea y la MMU vuelve a leer
+el cartucho directamente (sin coste en el resto de la ejecución).
+
+Ejecutar el arranque cuesta ~2,5 s de tiempo emulado en cada inicio. Como el
+resultado solo depende de la Boot ROM y de la cabecera del cartucho, el estado
+completo de la máquina tras el arranque se guarda en una caché en disco con
+clave (hash de la Boot ROM, hash de la cabecera, modelo): los siguientes inicios
+lo restauran directamente.
+
+Fuente: Pan Docs - Power Up Sequence, Memory Map (FF50 - Boot ROM disable)
+"""
+
+from __future__ import annotations
+
+import hashlib
+import logging
+import os
+from pathlib import Path
+from typing import TYPE_CHECKING
+
+from ..snapshot import write_atomic
+
+if TYPE_CHECKING:
+    from .cartridge import Cartridge
+
+logger = logging.getLogger(__name__)
+
+DMG_BOOT_SIZE = 0x100
+CGB_BOOT_SIZE = 0x900
+
+# Cabecera del cartucho (la Boot ROM lee el logo, el título y el flag CGB)
+HEADER_START = 0x0100
+HEADER_END = 0x0150
+
+
+class BootROM:
+    """Imagen de una Boot ROM DMG (256 bytes) o CGB (2304 bytes)."""
+
+    def __init__(self, data: bytes) -> None:
+        """
+        Args:
+            data: Contenido de la Boot ROM
+
+        Raises:
+            ValueError: Si el tamaño no es el de una Boot ROM DMG o CGB
+        """
+        if len(data) not in (DMG_BOOT_SIZE, CGB_BOOT_SIZE):
+            raise ValueError(
+                f"Tamaño de Boot ROM inválido: {len(data)} bytes "
+                f"(se esperan {DMG_BOOT_SIZE} o {CGB_BOOT_SIZE})"
+            )
+        self.data = bytes(data)
+        self.sha256 = hashlib.sha256(self.data).hexdigest()
+
+    @classmethod
+    def load(cls, path: str | Path) -> BootROM:
+        """Carga una Boot ROM desde un archivo."""
+        return cls(Path(path).read_bytes())
+
+    @property
+    def is_cgb(self) -> bool:
+        return len(self.data) == CGB_BOOT_SIZE
+
+    def maps(self, addr: int) -> bool:
+        """Indica si la dirección la sirve la Boot ROM mientras está mapeada."""
+        return addr < DMG_BOOT_SIZE or (self.is_cgb and 0x0200 <= addr < CGB_BOOT_SIZE)
+
+
+class BootROMOverlay:
+    """
+    Sustituye al cartucho en la MMU mientras la Boot ROM está mapeada.
+
+    Las lecturas de las zonas de la Boot ROM salen de ella; el resto, y todas las
+    escrituras (comandos MBC), van al cartucho.
+    """
+
+    __slots__ = ("boot_rom", "cartridge", "_data", "_cgb")
+
+    def __init__(self, boot_rom: BootROM, cartridge: Cartridge) -> None:
+        self.boot_rom = boot_rom
+        self.cartridge = cartridge
+        self._data = boot_rom.data
+        self._cgb = boot_rom.is_cgb
+
+    def read_byte(self, addr: int) -> int:
+        if addr < DMG_BOOT_SIZE or (self._cgb and 0x0200 <= addr < CGB_BOOT_SIZE):
+            return self._data[addr]
+        return self.cartridge.read_byte(addr)
+
+    def write_byte(self, addr: int, value: int) -> None:
+        self.cartridge.write_byte(addr, value)
+
+    def __getattr__(self, name: str):
+        # Resto de la interfaz del cartucho (get_rom_bank, get_header_info...)
+        return getattr(self.cartridge, name)
+
+
+def boot_cache_key(boot_rom: BootROM, cartridge: Cartridge, model: str) -> str:
+    """
+    Clave de caché del estado post-arranque.
+
+    Args:
+        boot_rom: Boot ROM ejecutada
+        cartridge: Cartucho (se usa su cabecera, 0x0100-0x014F)
+        model: Modelo de máquina emulado
+
+    Returns:
+        Hash hexadecimal de (Boot ROM, cabecera, modelo)
+    """
+    header = bytes(cartridge.read_byte(addr) for addr in range(HEADER_START, HEADER_END))
+    digest = hashlib.sha256()
+    digest.update(boot_rom.sha256.encode("ascii"))
+    digest.update(hashlib.sha256(header).digest())
+    digest.update(model.encode("ascii"))
+    return digest.hexdigest()
+
+
+def default_cache_dir() -> Path:
+    """Directorio por defecto de la caché ($XDG_CACHE_HOME/viboy/boot o ~/.cache/viboy/boot)."""
+    base = os.environ.get("XDG_CACHE_HOME") or Path.home() / ".cache"
+    return Path(base) / "viboy" / "boot"
+
+
+class BootCache:
+    """Caché en disco de estados post-arranque (un archivo por clave)."""
+
+    def __init__(self, directory: str | Path | None = None) -> None:
+        """
+        Args:
+            directory: Directorio de la caché (None = default_cache_dir())
+        """
+        self.directory = Path(directory) if directory is not None else default_cache_dir()
+
+    def _path(self, key: str) -> Path:
+        return self.directory / f"{key}.state"
+
+    def load(self, key: str) -> bytes | None:
+        """Devuelve el estado guardado para la clave, o None si no existe."""
+        try:
+            return self._path(key).read_bytes()
+        except OSError:
+            return None
+
+    def store(self, key: str, state: bytes) -> None:
+        """
+        Guarda un estado con snapshot.write_atomic(): un inicio concurrente o un
+        corte a mitad de escritura nunca deja un archivo a medias ni temporales.
+        """
+        try:
+            write_atomic(self._path(key), state)
+        except OSError as e:
+            # Sin caché solo se pierde velocidad en el siguiente inicio
+            logger.warning(f"No se pudo guardar el estado post-arranque en caché: {e}")
+
+    def discard(self, key: str) -> None:
+        """Elimina una entrada (p. ej. si no se pudo restaurar)."""
+        try:
+            self._path(key).unlink()
+        except OSError:
+            pass
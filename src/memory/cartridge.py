@@ -11,6 +11,7 @@ El Header contiene información crítica sobre el cartucho:
 - Tamaño de ROM (0x0148)
 - Tamaño de RAM (0x0149)
 - Checksum (0x014D - 0x014E)
+- Flag CGB (0x0143): 0x80 = compatible con CGB, 0xC0 = solo CGB; otro valor = DMG
 
 En un Game Boy real, al encender la consola, se ejecuta una **Boot ROM** interna
 de 256 bytes (0x0000 - 0x00FF) que inicializa el hardware y luego salta a 0x0100
@@ -25,11 +26,21 @@ Fuente: Pan Docs - Cartridge Header
 
 from __future__ import annotations
 
+import hashlib
 import logging
+import mmap
+import struct
 from pathlib import Path
+from typing import Iterable, Sequence
+
+from .rom_patch import apply_patch_files
 
 logger = logging.getLogger(__name__)
 
+# Modelos de máquina (ver Cartridge.get_model)
+MODEL_DMG = "dmg"
+MODEL_CGB = "cgb"
+
 
 class Cartridge:
     """
@@ -49,37 +60,63 @@ class Cartridge:
     # Tamaño de un banco ROM (16KB = 16384 bytes)
     ROM_BANK_SIZE = 0x4000  # 16384 bytes
     
+    # Banco fuera de la ROM: bus abierto (0xFF). Compartido por todos los cartuchos
+    _OPEN_BUS = b"\xFF" * ROM_BANK_SIZE
+    
     # Campos específicos del Header
     TITLE_START = 0x0134
     TITLE_END = 0x0143  # 16 bytes (incluye terminador 0x00)
     CARTRIDGE_TYPE = 0x0147
     ROM_SIZE = 0x0148
     RAM_SIZE = 0x0149
+    CGB_FLAG = 0x0143
 
-    def __init__(self, rom_path: str | Path) -> None:
+    def __init__(self, rom_path: str | Path, patches: Sequence[str | Path] = ()) -> None:
         """
         Inicializa el cartucho cargando la ROM desde el archivo especificado.
         
+        Sin parches, la ROM se mapea con mmap de solo lectura: no se copia y el
+        sistema comparte las páginas con otros procesos que abran el mismo archivo.
+        Con parches, se aplican en orden sobre una copia privada (el archivo original
+        no se modifica) y la cabecera se parsea sobre el resultado.
+        
         Args:
             rom_path: Ruta al archivo ROM (`.gb` o `.gbc`)
+            patches: Archivos de parche IPS, UPS o BPS a aplicar en orden
             
         Raises:
             FileNotFoundError: Si el archivo no existe
             IOError: Si hay un error al leer el archivo
+            ValueError: Si la ROM es demasiado pequeña o un parche no es válido
         """
         # Convertir a Path para portabilidad (Windows/Linux/macOS)
         path = Path(rom_path)
         
         if not path.exists():
             raise FileNotFoundError(f"ROM no encontrada: {rom_path}")
+        patch_paths = [Path(patch) for patch in patches]
+        for patch_path in patch_paths:
+            if not patch_path.exists():
+                raise FileNotFoundError(f"Parche no encontrado: {patch_path}")
         
-        # Leer el archivo completo en modo binario
+        # Mapear el archivo en modo de solo lectura
         try:
             with open(path, "rb") as f:
-                self._rom_data = bytearray(f.read())
-        except IOError as e:
+                size = path.stat().st_size
+                # mmap no admite archivos vacíos: la validación de tamaño los rechaza
+                rom_data: bytes | mmap.mmap = (
+                    mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) if size else b""
+                )
+        except (IOError, ValueError) as e:
             raise IOError(f"Error al leer ROM: {rom_path}") from e
         
+        # Parches: copia privada solo si hay alguno
+        self._rom_data: bytes | bytearray | mmap.mmap = rom_data
+        if patch_paths:
+            self._rom_data = apply_patch_files(rom_data, patch_paths)
+            if isinstance(rom_data, mmap.mmap):
+                rom_data.close()
+        
         # Validar tamaño mínimo (debe tener al menos el Header)
         if len(self._rom_data) < self.HEADER_END + 1:
             raise ValueError(
@@ -87,7 +124,10 @@ class Cartridge:
                 f"(mínimo esperado: {self.HEADER_END + 1} bytes)"
             )
         
-        logger.info(f"Cartucho cargado: {path.name} ({len(self._rom_data)} bytes)")
+        logger.info(
+            f"Cartucho cargado: {path.name} ({len(self._rom_data)} bytes"
+            f"{f', {len(patch_paths)} parche(s)' if patch_paths else ''})"
+        )
         
         # Parsear información del Header
         self._header_info = self._parse_header()
@@ -95,6 +135,82 @@ class Cartridge:
         # Inicializar MBC1: banco ROM inicial es 1 (no puede ser 0 en zona switchable)
         # Fuente: Pan Docs - MBC1: "Writing 0x00 to 0x2000-0x3FFF selects ROM bank 1"
         self._rom_bank: int = 1
+        
+        # Páginas de 16 KB por banco: read_byte() indexa la página mapeada sin
+        # calcular offsets. _base_pages son vistas de la ROM original; _pages son
+        # las efectivas (copias solo en los bancos con parches Game Genie)
+        self._build_pages()
+
+    def _build_pages(self) -> None:
+        """Divide la ROM en páginas de 16 KB (la última se rellena con 0xFF)."""
+        rom = memoryview(self._rom_data).toreadonly()
+        size = self.ROM_BANK_SIZE
+        pages: list[bytes | memoryview] = []
+        for start in range(0, len(self._rom_data), size):
+            page = rom[start:start + size]
+            if len(page) < size:
+                page = bytes(page) + b"\xFF" * (size - len(page))
+            pages.append(page)
+        self._base_pages = pages
+        self._pages: list[bytes | memoryview | bytearray] = list(pages)
+        self._rom_patches: dict[int, dict[int, int]] = {}
+        self._map_pages()
+
+    def _page(self, bank: int) -> bytes | memoryview | bytearray:
+        return self._pages[bank] if bank < len(self._pages) else self._OPEN_BUS
+
+    def _map_pages(self) -> None:
+        """Mapea las páginas efectivas del banco 0 y del banco seleccionado."""
+        self._bank0 = self._pages[0]
+        self._bank_n = self._page(self._rom_bank)
+
+    def set_rom_patches(self, patches: Iterable[tuple[int, int, int | None]]) -> set[int]:
+        """
+        Sustituye el conjunto de parches de ROM activos (códigos Game Genie).
+        
+        Cada parche se aplica como copia de la página del banco afectado (copy-on-write):
+        la ruta de lectura no tiene ninguna comprobación y un cambio de banco solo
+        selecciona otra página. Solo se reconstruyen los bancos cuyo conjunto de
+        parches cambia.
+        
+        Args:
+            patches: (dirección 0x0000-0x7FFF, valor, comparación o None). En
+                0x4000-0x7FFF el parche se aplica en cada banco cuyo byte original
+                coincide con la comparación (en todos si es None), como el Game Genie,
+                que compara el dato del bus
+                
+        Returns:
+            Bancos reconstruidos
+            
+        Fuente: Pan Docs - Game Genie/Shark Cheats
+        """
+        size = self.ROM_BANK_SIZE
+        by_bank: dict[int, dict[int, int]] = {}
+        for address, value, compare in patches:
+            if address < size:
+                banks: Iterable[int] = (0,)
+                offset = address
+            else:
+                banks = range(1, len(self._base_pages))
+                offset = address - size
+            for bank in banks:
+                if compare is None or self._base_pages[bank][offset] == compare:
+                    by_bank.setdefault(bank, {})[offset] = value
+        
+        changed = {bank for bank in by_bank.keys() | self._rom_patches.keys()
+                   if by_bank.get(bank) != self._rom_patches.get(bank)}
+        self._rom_patches = by_bank
+        for bank in changed:
+            bank_patches = by_bank.get(bank)
+            if bank_patches is None:
+                self._pages[bank] = self._base_pages[bank]
+            else:
+                page = bytearray(self._base_pages[bank])
+                for offset, value in bank_patches.items():
+                    page[offset] = value
+                self._pages[bank] = page
+        self._map_pages()
+        return changed
 
     def read_byte(self, addr: int) -> int:
         """
@@ -119,21 +235,12 @@ class Cartridge:
         
         # Banco 0 (fijo): 0x0000 - 0x3FFF siempre apunta a los primeros 16KB
         if addr < 0x4000:
-            offset = addr
-            if offset >= len(self._rom_data):
-                return 0xFF
-            return self._rom_data[offset] & 0xFF
-        
-        # Banco switchable: 0x4000 - 0x7FFF apunta al banco seleccionado
-        if 0x4000 <= addr < 0x8000:
-            # Calcular offset: (banco * 16384) + (addr - 0x4000)
-            bank_offset = self._rom_bank * self.ROM_BANK_SIZE
-            relative_offset = addr - 0x4000
-            offset = bank_offset + relative_offset
-            
-            if offset >= len(self._rom_data):
-                return 0xFF
-            return self._rom_data[offset] & 0xFF
+            return self._bank0[addr]
+        
+        # Banco switchable: 0x4000 - 0x7FFF apunta a la página del banco seleccionado
+        # (los bytes fuera de la ROM son 0xFF: ver _build_pages())
+        if addr < 0x8000:
+            return self._bank_n[addr - 0x4000]
         
         # Fuera del rango de ROM
         return 0xFF
@@ -170,6 +277,7 @@ class Cartridge:
                 bank = 1
             
             self._rom_bank = bank
+            self._bank_n = self._page(bank)
             # Obtener tipo de cartucho para el mensaje - COMENTADO para rendimiento
             # cart_type = self._header_info.get("cartridge_type", "0x??")
             # logger.info(f"🏦 MBC: Cambio de Banco ROM a {bank:02X} (tipo {cart_type}, escritura 0x{value:02X} en 0x{addr:04X})")
@@ -253,6 +361,22 @@ class Cartridge:
         
         return header_info
 
+    def get_model(self) -> str:
+        """
+        Devuelve el modelo de máquina que pide el cartucho según el flag CGB (0x0143).
+        
+        Bit 7 activo (0x80 compatible, 0xC0 solo CGB): MODEL_CGB. En otro caso el
+        byte es parte del título de un cartucho DMG: MODEL_DMG.
+        
+        Returns:
+            MODEL_DMG o MODEL_CGB
+        
+        Fuente: Pan Docs - Cartridge Header (0143 - CGB Flag)
+        """
+        if len(self._rom_data) > self.CGB_FLAG and self._rom_data[self.CGB_FLAG] & 0x80:
+            return MODEL_CGB
+        return MODEL_DMG
+
     def get_rom_size(self) -> int:
         """
         Devuelve el tamaño total de la ROM en bytes.
@@ -262,3 +386,38 @@ class Cartridge:
         """
         return len(self._rom_data)
 
+
+    def get_rom_sha256(self) -> str:
+        """
+        Devuelve el hash SHA-256 de la ROM completa (identifica el juego en los
+        slots de guardado aunque se renombre el archivo).
+        
+        Returns:
+            Hash en hexadecimal
+        """
+        return hashlib.sha256(self._rom_data).hexdigest()
+
+    def get_rom_bank(self) -> int:
+        """
+        Devuelve el banco ROM mapeado actualmente en 0x4000-0x7FFF.
+        
+        Returns:
+            Número de banco ROM seleccionado (1-31 en MBC1)
+        """
+        return self._rom_bank
+
+    # Estado para snapshots (src/snapshot.py): banco ROM seleccionado
+    _STATE_FORMAT = struct.Struct("<H")
+
+    def save_state(self) -> bytes:
+        """Serializa el estado del MBC (la ROM no forma parte del estado)."""
+        return self._STATE_FORMAT.pack(self._rom_bank)
+
+    def state_size(self) -> int:
+        """Tamaño en bytes de save_state() (snapshot lo comprueba antes de restaurar)."""
+        return self._STATE_FORMAT.size
+
+    def load_state(self, data: bytes) -> None:
+        """Restaura un estado de save_state()."""
+        (self._rom_bank,) = self._STATE_FORMAT.unpack(data)
+        self._map_pages()
@@ -0,0 +1,166 @@
+"""
+Cheats - Códigos Game Genie y GameShark sin coste en la ruta de lectura
+
+Hay dos familias de trucos para Game Boy, con mecanismos distintos:
+
+- Game Genie (ABC-DEF-GHI o ABC-DEF): se conecta entre la consola y el cartucho
+  y sustituye el byte leído de una dirección de ROM, opcionalmente solo si el
+  original coincide con un valor de comparación (así solo afecta a un banco).
+    AB   = valor nuevo
+    FCDE = dirección, con el nibble alto XOR 0xF
+    GI   = comparación, rotada 2 bits a la izquierda y XOR 0xBA
+    H    = no usado (comprobación del propio dispositivo)
+
+- GameShark (ABCDEFGH): escribe un valor en RAM en cada V-Blank.
+    AB   = banco de RAM externa (01 = sin banco)
+    CD   = valor
+    GHEF = dirección (little-endian)
+
+Comprobar los trucos en cada lectura de memoria penalizaría todas las
+instrucciones. En su lugar, los Game Genie se aplican como páginas de ROM
+parcheadas en el cartucho (Cartridge.set_rom_patches): activar o desactivar un
+código reconstruye solo los bancos afectados, y leer la ROM cuesta lo mismo con
+o sin trucos. Los GameShark se aplican una vez por frame desde el bucle
+principal, como hace el dispositivo real desde la interrupción V-Blank.
+
+Fuente: Pan Docs - Game Genie/Shark Cheats
+"""
+
+from __future__ import annotations
+
+import logging
+import re
+from dataclasses import dataclass
+from typing import TYPE_CHECKING
+
+if TYPE_CHECKING:
+    from .cartridge import Cartridge
+    from .mmu import MMU
+
+logger = logging.getLogger(__name__)
+
+KIND_GAME_GENIE = "gamegenie"
+KIND_GAMESHARK = "gameshark"
+
+_HEX = re.compile(r"^[0-9A-F]+$")
+
+
+@dataclass
+class Cheat:
+    """Código de truco decodificado."""
+
+    code: str
+    kind: str
+    address: int
+    value: int
+    compare: int | None = None  # Game Genie de 9 dígitos
+    bank: int = 0x01  # GameShark
+    enabled: bool = True
+
+
+def parse_cheat(code: str) -> Cheat:
+    """
+    Decodifica un código Game Genie o GameShark.
+
+    Args:
+        code: "ABC-DEF-GHI" / "ABC-DEF" (Game Genie) o "ABCDEFGH" (GameShark)
+
+    Returns:
+        Truco decodificado (activado)
+
+    Raises:
+        ValueError: Si el código no tiene un formato válido
+    """
+    normalized = code.strip().upper()
+    digits = normalized.replace("-", "")
+    if not digits or not _HEX.match(digits):
+        raise ValueError(f"Código de truco inválido: {code!r}")
+
+    if "-" not in normalized and len(digits) == 8:
+        bank = int(digits[0:2], 16)
+        value = int(digits[2:4], 16)
+        address = int(digits[6:8] + digits[4:6], 16)
+        if address < 0x8000:
+            raise ValueError(f"GameShark fuera de la RAM (0x{address:04X}): {code!r}")
+        return Cheat(normalized, KIND_GAMESHARK, address, value, bank=bank)
+
+    if len(digits) in (6, 9):
+        value = int(digits[0:2], 16)
+        address = int(digits[5] + digits[2:5], 16) ^ 0xF000
+        compare = None
+        if len(digits) == 9:
+            encoded = int(digits[6] + digits[8], 16)
+            compare = (((encoded >> 2) | (encoded << 6)) & 0xFF) ^ 0xBA
+        if address >= 0x8000:
+            raise ValueError(f"Game Genie fuera de la ROM (0x{address:04X}): {code!r}")
+        return Cheat(normalized, KIND_GAME_GENIE, address, value, compare)
+
+    raise ValueError(f"Código de truco inválido: {code!r}")
+
+
+class CheatEngine:
+    """Lista de trucos activos de un cartucho."""
+
+    def __init__(self, cartridge: Cartridge, mmu: MMU) -> None:
+        """
+        Args:
+            cartridge: Cartucho (recibe los parches Game Genie)
+            mmu: MMU (recibe las escrituras GameShark)
+        """
+        self._cartridge = cartridge
+        self._mmu = mmu
+        self._cheats: dict[str, Cheat] = {}
+        # Escrituras GameShark activas, precalculadas para el bucle de frames
+        self._ram_writes: tuple[tuple[int, int], ...] = ()
+
+    @property
+    def cheats(self) -> list[Cheat]:
+        return list(self._cheats.values())
+
+    def add(self, code: str, enabled: bool = True) -> Cheat:
+        """
+        Añade (o reemplaza) un código.
+
+        Raises:
+            ValueError: Si el código no es válido
+        """
+        cheat = parse_cheat(code)
+        cheat.enabled = enabled
+        self._cheats[cheat.code] = cheat
+        self._sync(cheat.kind)
+        logger.info(f"Truco {cheat.code}: {cheat.kind} 0x{cheat.address:04X} = 0x{cheat.value:02X}")
+        return cheat
+
+    def remove(self, code: str) -> None:
+        """Quita un código (no hace nada si no existe)."""
+        cheat = self._cheats.pop(parse_cheat(code).code, None)
+        if cheat is not None:
+            self._sync(cheat.kind)
+
+    def set_enabled(self, code: str, enabled: bool) -> None:
+        """
+        Activa o desactiva un código sin quitarlo.
+
+        Raises:
+            KeyError: Si el código no está añadido
+        """
+        cheat = self._cheats[parse_cheat(code).code]
+        if cheat.enabled != enabled:
+            cheat.enabled = enabled
+            self._sync(cheat.kind)
+
+    def _sync(self, kind: str) -> None:
+        """Recalcula solo la familia de trucos que cambió."""
+        active = [cheat for cheat in self._cheats.values() if cheat.enabled and cheat.kind == kind]
+        if kind == KIND_GAME_GENIE:
+            self._cartridge.set_rom_patches(
+                (cheat.address, cheat.value, cheat.compare) for cheat in active
+            )
+        else:
+            self._ram_writes = tuple((cheat.address, cheat.value) for cheat in active)
+
+    def apply_ram(self) -> None:
+        """Aplica las escrituras GameShark (una vez por frame, en V-Blank)."""
+        write_byte = self._mmu.write_byte
+        for address, value in self._ram_writes:
+            write_byte(address, value)
@@ -29,13 +29,18 @@ Fuente: Pan Docs - Memory Map
 from __future__ import annotations
 
 import logging
+import struct
 from typing import TYPE_CHECKING
 
+from .cartridge import MODEL_CGB, MODEL_DMG
+
 if TYPE_CHECKING:
     from .cartridge import Cartridge
     from ..gpu.ppu import PPU
+    from ..gpu.ppu_log import PPUWriteLog
     from ..io.joypad import Joypad
     from ..io.timer import Timer
+    from .boot_rom import BootROM
 
 logger = logging.getLogger(__name__)
 # OPTIMIZACIÓN: Desactivar logging a nivel CRITICAL para máximo rendimiento
@@ -96,6 +101,7 @@ IO_NR52 = 0xFF26  # Sound On/Off
 
 # Registros de Joypad
 IO_P1 = 0xFF00    # Joypad Input - Estado de botones y direcciones
+IO_BOOT = 0xFF50  # Boot ROM disable - Escribir un valor distinto de 0 desmapea la Boot ROM
 
 # Registros CGB (Game Boy Color) - Soporte básico
 IO_KEY1 = 0xFF4D  # Speed Switch - Control de velocidad doble (CGB)
@@ -166,11 +172,15 @@ class MMU:
         '_memory', '_cartridge', '_ppu', '_joypad', '_timer', 'vram_write_count', '_renderer',
         '_vram_bank', '_vram_banks', '_bg_palette_index', '_bg_palette_autoinc',
         '_obj_palette_index', '_obj_palette_autoinc', '_bg_palette_data', '_obj_palette_data',
-        '_key1_speed_switch'
+        '_key1_speed_switch', 'double_speed', '_vram_views', '_oam_view', '_tile_map_views',
+        '_write_log', '_boot_cartridge'
     ]
 
     # Tamaño total del espacio de direcciones (16 bits = 65536 bytes)
     MEMORY_SIZE = 0x10000  # 65536 bytes
+    
+    # Modelo de máquina: esta MMU implementa los registros CGB (ver DMGMMU)
+    MODEL = MODEL_CGB
 
     def __init__(self, cartridge: Cartridge | None = None) -> None:
         """
@@ -204,12 +214,28 @@ class MMU:
         # Bit 0 de 0xFF4F selecciona el banco (0 o 1)
         # Fuente: Pan Docs - CGB Registers, VRAM Banking
         self._vram_bank: int = 0  # Banco actual (0 o 1)
-        self._vram_banks: list[bytearray] = [
-            bytearray(0x2000),  # Banco 0: 8KB
+        # El banco 0 es directamente _memory[0x8000:0xA000] (compatibilidad DMG): solo
+        # el banco 1 tiene buffer propio
+        self._vram_banks: list[bytearray | memoryview] = [
+            memoryview(self._memory)[0x8000:0xA000],  # Banco 0: 8KB (vista de _memory)
             bytearray(0x2000),  # Banco 1: 8KB
         ]
-        # Inicializar banco 0 con la memoria principal (para compatibilidad DMG)
-        # El banco 0 se mapea directamente a _memory[0x8000:0xA000]
+        
+        # Vistas de solo lectura para el renderer: indexar un memoryview evita
+        # pasar por read_byte() (y su decodificación de direcciones) en cada
+        # lectura de tilemap, tile u OAM. Son vistas, no copias: reflejan cada
+        # escritura sin sincronización. Los bytearrays nunca se redimensionan.
+        # Fuente: Python docs - memoryview.toreadonly()
+        memory_view = memoryview(self._memory)
+        self._vram_views: tuple[memoryview, memoryview] = (
+            memory_view[0x8000:0xA000].toreadonly(),
+            memoryview(self._vram_banks[1]).toreadonly(),
+        )
+        self._oam_view: memoryview = memory_view[0xFE00:0xFEA0].toreadonly()
+        self._tile_map_views: tuple[memoryview, memoryview] = (
+            memory_view[0x9800:0x9C00].toreadonly(),
+            memory_view[0x9C00:0xA000].toreadonly(),
+        )
         
         # CGB: Paletas de Color (0xFF68-0xFF6B)
         # Background Palette: 8 paletas de 4 colores cada una (32 bytes total)
@@ -226,13 +252,19 @@ class MMU:
         
         # CGB: Speed Switch (0xFF4D)
         # Permite cambiar entre velocidad normal (1x) y doble (2x)
-        # Bit 7: Preparado para cambio (read-only)
-        # Bit 0: Velocidad actual (0=normal, 1=doble)
+        # Bit 7: Velocidad actual (0=normal, 1=doble) (read-only)
+        # Bit 0: Cambio preparado (lo escribe el juego; STOP lo ejecuta)
         # Fuente: Pan Docs - CGB Registers, Speed Switch
-        self._key1_speed_switch: int = 0  # Por defecto, velocidad normal
+        self._key1_speed_switch: int = 0  # Bit 0 de KEY1 (cambio preparado)
+        # Doble velocidad activa: la CPU y el Timer van a 8 MHz, la PPU sigue a 4 MHz.
+        # El bucle principal lo tiene en cuenta al contar ciclos (ver Viboy.run)
+        self.double_speed: bool = False
         
         # Referencia al cartucho (si está insertado)
         self._cartridge: Cartridge | None = cartridge
+        # Cartucho real mientras la Boot ROM está mapeada (_cartridge es entonces el
+        # BootROMOverlay); None el resto del tiempo. Ver map_boot_rom()
+        self._boot_cartridge: Cartridge | None = None
         
         # Referencia a la PPU (se establece después de crear ambas para evitar dependencia circular)
         # La PPU necesita la MMU para solicitar interrupciones, y la MMU necesita la PPU
@@ -252,6 +284,9 @@ class MMU:
         # para marcar tiles como "dirty" cuando se escribe en VRAM (Tile Caching)
         self._renderer = None  # type: ignore
         
+        # Registro opcional de escrituras de la PPU (src/gpu/ppu_log.py); None = desactivado
+        self._write_log: PPUWriteLog | None = None
+        
         # Contador temporal para diagnóstico de escrituras en VRAM
         # Se usa para limitar el logging a las primeras 10 escrituras
         self.vram_write_count = 0
@@ -308,7 +343,7 @@ class MMU:
                 return 0
             if addr == IO_P1:
                 if self._joypad is not None:
-                    return self._joypad.read() & 0xFF
+                    return self._joypad.read()
                 return 0xFF
             if addr == IO_DIV:
                 if self._timer is not None:
@@ -332,10 +367,10 @@ class MMU:
                 # Bits 1-7: Siempre 0 (read-only)
                 return self._vram_bank & 0x01
             if addr == IO_KEY1:
-                # Bit 7: Preparado para cambio (read-only, siempre 0 por ahora)
-                # Bit 0: Velocidad actual (0=normal, 1=doble)
-                # Bits 1-6: Siempre 0
-                return self._key1_speed_switch & 0x01
+                # Bit 7: Velocidad actual (0=normal, 1=doble)
+                # Bit 0: Cambio preparado
+                # Bits 1-6: No usados (se leen a 1)
+                return (0x80 if self.double_speed else 0x00) | 0x7E | (self._key1_speed_switch & 0x01)
             if addr == IO_BCPS:
                 # Bit 0-5: Índice de paleta (0-63)
                 # Bit 6: No usado
@@ -536,17 +571,22 @@ class MMU:
                 self._timer.write_tac(value)
                 return  # No escribir en memoria, el Timer maneja su propio estado
         
+        # Boot ROM disable (0xFF50): la última instrucción de la Boot ROM escribe aquí
+        if addr == IO_BOOT and value and self._boot_cartridge is not None:
+            self.unmap_boot_rom()
+        
         # CGB: Interceptar escritura a registros CGB
         if addr == IO_VBK:
             # Bit 0: Seleccionar banco VRAM (0 o 1)
             # Bits 1-7: Ignorados (solo bit 0 es válido)
             self._vram_bank = value & 0x01
+            if self._write_log is not None:
+                self._write_log.record(addr, value)
             # No escribir en memoria, el estado se guarda en _vram_bank
             return
         if addr == IO_KEY1:
-            # Bit 0: Velocidad deseada (0=normal, 1=doble)
-            # El cambio real requiere una secuencia especial (no implementada aún)
-            # Por ahora, solo guardamos el valor
+            # Bit 0: Preparar el cambio de velocidad (se ejecuta con la instrucción STOP)
+            # Bit 7 es de solo lectura
             self._key1_speed_switch = value & 0x01
             # No escribir en memoria, el estado se guarda en _key1_speed_switch
             return
@@ -600,39 +640,7 @@ class MMU:
         # La transferencia es inmediata y bloquea el acceso a OAM durante la copia
         # Fuente: Pan Docs - DMA Transfer
         if addr == IO_DMA:
-            # El valor escrito (XX) forma la dirección fuente alta: XX00
-            source_base = (value << 8) & 0xFFFF  # XX00 (ej: 0xC0 -> 0xC000)
-            oam_base = 0xFE00  # OAM comienza en 0xFE00
-            oam_size = 160  # OAM tiene 160 bytes (40 sprites * 4 bytes)
-            
-            # DIAGNÓSTICO: Validación de fuente antes de copiar
-            # Leer el primer byte de la dirección fuente para verificar que hay datos
-            first_byte = self.read_byte(source_base)
-            
-            # Logging detallado del DMA (INFO para visibilidad) - COMENTADO para rendimiento
-            # logger.info(
-            #     f"💾 DMA START: Fuente=0x{source_base:04X} (Valor[0]=0x{first_byte:02X}) -> "
-            #     f"Dest=0x{oam_base:04X} (160 bytes)"
-            # )
-            
-            # Copiar 160 bytes desde la dirección fuente a OAM
-            # Usamos slice de bytearray para copia rápida
-            for i in range(oam_size):
-                source_addr = (source_base + i) & 0xFFFF
-                # Leer desde la dirección fuente (puede ser ROM, RAM, VRAM, etc.)
-                byte_value = self.read_byte(source_addr)
-                # Escribir en OAM
-                self._memory[oam_base + i] = byte_value
-            
-            # DIAGNÓSTICO: Verificar que se copió correctamente (muestra primeros 4 bytes de OAM) - COMENTADO para rendimiento
-            # oam_sample = [self._memory[oam_base + i] for i in range(4)]
-            # logger.info(
-            #     f"💾 DMA COMPLETE: OAM[0:4] = {[f'0x{b:02X}' for b in oam_sample]} "
-            #     f"(primer sprite: Y={oam_sample[0]}, X={oam_sample[1]}, Tile={oam_sample[2]}, Flags={oam_sample[3]:02X})"
-            # )
-            
-            # Escribir el valor en el registro DMA (se mantiene el valor escrito)
-            self._memory[addr] = value
+            self._oam_dma(value)
             return
         
         # DIAGNÓSTICO TEMPORAL: Logging de escrituras en VRAM (comentado para rendimiento)
@@ -666,15 +674,20 @@ class MMU:
                 # self._memory[addr] = value
             
             # OPTIMIZACIÓN: Marcar tile como "dirty" si se escribe en VRAM (Tile Caching)
-            # Solo los tiles en 0x8000-0x97FF (384 tiles) se cachean
-            # Si se escribe en este rango, calcular el índice del tile y marcarlo como dirty
+            # Solo los tiles en 0x8000-0x97FF (384 por banco) se cachean
+            # Si se escribe en este rango, calcular el slot del tile y marcarlo como dirty
             if 0x8000 <= addr <= 0x97FF:
-                # Calcular índice del tile (0-383)
+                # Calcular slot (0-767): banco * 384 + índice del tile
                 # Cada tile ocupa 16 bytes, así que: tile_index = (addr - 0x8000) // 16
                 tile_index = (addr - 0x8000) // 16
+                if self._vram_bank != 0:
+                    tile_index += 384
                 if self._renderer is not None:
                     self._renderer.mark_tile_dirty(tile_index)
             
+            if self._write_log is not None:
+                self._write_log.record(addr, value)
+            
             # Ya escribimos en VRAM, no continuar
             return
         
@@ -685,6 +698,143 @@ class MMU:
         # hacer polling de STAT para evitar escribir durante Pixel Transfer.
         # Fuente: Pan Docs - VRAM Access Restrictions
         self._memory[addr] = value
+        
+        # Registro de la PPU: OAM y registros LCD 0xFF40-0xFF4B
+        if self._write_log is not None and (0xFE00 <= addr < 0xFEA0 or 0xFF40 <= addr <= 0xFF4B):
+            self._write_log.record(addr, value)
+
+    def speed_switch(self) -> bool:
+        """
+        Ejecuta el cambio de velocidad CGB si KEY1 lo tiene preparado (lo llama STOP).
+        
+        Alterna entre velocidad normal y doble, limpia el bit 0 de KEY1 y reinicia
+        DIV, como el hardware. En DMGMMU KEY1 no existe y nunca se prepara.
+        
+        Returns:
+            True si se cambió de velocidad, False si STOP debe entrar en bajo consumo
+        
+        Fuente: Pan Docs - CGB Registers (FF4D - KEY1), Timer and Divider Registers
+        """
+        if not self._key1_speed_switch & 0x01:
+            return False
+        self.double_speed = not self.double_speed
+        self._key1_speed_switch = 0
+        if self._timer is not None:
+            self._timer.write_div(0)
+        return True
+    
+    def map_boot_rom(self, boot_rom: BootROM) -> None:
+        """
+        Mapea una Boot ROM sobre el cartucho hasta que se escriba en 0xFF50.
+        
+        Args:
+            boot_rom: Boot ROM a ejecutar
+            
+        Raises:
+            RuntimeError: Si no hay cartucho (la Boot ROM lee su cabecera)
+        """
+        from .boot_rom import BootROMOverlay
+        
+        if self._cartridge is None:
+            raise RuntimeError("La Boot ROM necesita un cartucho insertado")
+        if self._boot_cartridge is None:
+            self._boot_cartridge = self._cartridge
+        self._cartridge = BootROMOverlay(boot_rom, self._boot_cartridge)  # type: ignore[assignment]
+        self._memory[IO_BOOT] = 0x00
+    
+    def unmap_boot_rom(self) -> None:
+        """Desmapea la Boot ROM: la MMU vuelve a leer el cartucho directamente."""
+        if self._boot_cartridge is not None:
+            self._cartridge = self._boot_cartridge
+            self._boot_cartridge = None
+    
+    def is_boot_rom_mapped(self) -> bool:
+        """Indica si la Boot ROM está mapeada en 0x0000."""
+        return self._boot_cartridge is not None
+    
+    # Estado para snapshots (src/snapshot.py): índices de paleta, autoincrementos,
+    # banco VRAM, KEY1 y doble velocidad
+    _STATE_FORMAT = struct.Struct("<B?B?BBB")
+    
+    def save_state(self) -> bytes:
+        """
+        Serializa la memoria y los registros internos de la MMU.
+        
+        Returns:
+            Espacio de direcciones, banco 1 de VRAM, paletas CGB y registros internos
+        """
+        header = self._STATE_FORMAT.pack(
+            self._bg_palette_index, self._bg_palette_autoinc,
+            self._obj_palette_index, self._obj_palette_autoinc,
+            self._vram_bank, self._key1_speed_switch, self.double_speed,
+        )
+        return b"".join((
+            header, self._memory, self._vram_banks[1],
+            self._bg_palette_data, self._obj_palette_data,
+        ))
+    
+    def state_size(self) -> int:
+        """Tamaño en bytes de save_state() (snapshot lo comprueba antes de restaurar)."""
+        # Cabecera + espacio de direcciones + banco 1 de VRAM + paletas BG/OBJ
+        return self._STATE_FORMAT.size + self.MEMORY_SIZE + 0x2000 + 128
+    
+    def load_state(self, data: bytes) -> None:
+        """
+        Restaura un estado de save_state().
+        
+        Los bytearrays se sobrescriben en su sitio: las vistas del renderer siguen
+        apuntando a ellos. Toda la caché de tiles se invalida.
+        
+        Raises:
+            ValueError: Si el tamaño no corresponde a un estado de la MMU
+        """
+        header_size = self._STATE_FORMAT.size
+        if len(data) != self.state_size():
+            raise ValueError(f"Estado de MMU inválido ({len(data)} bytes)")
+        (self._bg_palette_index, self._bg_palette_autoinc,
+         self._obj_palette_index, self._obj_palette_autoinc,
+         self._vram_bank, self._key1_speed_switch, double_speed) = self._STATE_FORMAT.unpack_from(data)
+        self.double_speed = bool(double_speed)
+        offset = header_size
+        self._memory[:] = data[offset:offset + self.MEMORY_SIZE]
+        offset += self.MEMORY_SIZE
+        self._vram_banks[1][:] = data[offset:offset + 0x2000]
+        offset += 0x2000
+        self._bg_palette_data[:] = data[offset:offset + 64]
+        self._obj_palette_data[:] = data[offset + 64:offset + 128]
+        if self._renderer is not None:
+            for tile_index in range(768):
+                self._renderer.mark_tile_dirty(tile_index)
+    
+    def _oam_dma(self, value: int) -> None:
+        """
+        Transferencia DMA a OAM (escritura en 0xFF46).
+        
+        Args:
+            value: Byte alto de la dirección fuente (XX -> XX00)
+        
+        Fuente: Pan Docs - DMA Transfer
+        """
+        # El valor escrito (XX) forma la dirección fuente alta: XX00
+        source_base = (value << 8) & 0xFFFF  # XX00 (ej: 0xC0 -> 0xC000)
+        oam_base = 0xFE00  # OAM comienza en 0xFE00
+        oam_size = 160  # OAM tiene 160 bytes (40 sprites * 4 bytes)
+        
+        # Copiar 160 bytes desde la dirección fuente a OAM
+        # Usamos slice de bytearray para copia rápida
+        for i in range(oam_size):
+            source_addr = (source_base + i) & 0xFFFF
+            # Leer desde la dirección fuente (puede ser ROM, RAM, VRAM, etc.)
+            byte_value = self.read_byte(source_addr)
+            # Escribir en OAM
+            self._memory[oam_base + i] = byte_value
+        
+        # Registro de la PPU: la copia entera como un único bloque
+        if self._write_log is not None:
+            self._write_log.record_oam_dma()
+        
+        # Escribir el valor en el registro DMA (se mantiene el valor escrito)
+        self._memory[IO_DMA] = value
 
     def read_word(self, addr: int) -> int:
         """
@@ -811,6 +961,16 @@ class MMU:
         self._renderer = renderer
         # logger.debug("MMU: Renderer conectado para Tile Caching")
     
+    def set_write_log(self, write_log: PPUWriteLog | None) -> None:
+        """
+        Activa (o desactiva con None) el registro de escrituras que afectan a la imagen:
+        VRAM, OAM (incluidas las copias DMA), registros LCD 0xFF40-0xFF4B y VBK.
+        
+        Args:
+            write_log: Registro de escrituras, o None para desactivarlo
+        """
+        self._write_log = write_log
+    
     def get_vram_write_count(self) -> int:
         """
         Devuelve el número de escrituras en VRAM detectadas (para diagnóstico).
@@ -832,6 +992,59 @@ class MMU:
         """
         return sum(self._memory[0x8000:0xA000])
     
+    def read_block(self, addr: int, length: int) -> bytes:
+        """
+        Copia un bloque de la memoria interna sin pasar por read_byte().
+        
+        Pensado para volcados (exportación de estado, herramientas): no tiene
+        efectos secundarios ni consulta a los periféricos, así que los registros
+        I/O virtuales (LY, DIV, P1...) deben leerse con read_byte().
+        
+        Args:
+            addr: Dirección inicial
+            length: Número de bytes
+            
+        Returns:
+            Copia de los bytes en [addr, addr + length)
+        """
+        return bytes(self._memory[addr:addr + length])
+
+    def get_vram_view(self, bank: int = 0) -> memoryview:
+        """
+        Devuelve una vista de solo lectura de un banco de VRAM (8 KiB).
+        
+        El índice 0 de la vista corresponde a 0x8000. A diferencia de read_byte(),
+        no depende del banco seleccionado en VBK (0xFF4F).
+        
+        Args:
+            bank: Banco de VRAM (0 o 1)
+            
+        Returns:
+            memoryview de 0x2000 bytes
+        """
+        return self._vram_views[bank & 0x01]
+
+    def get_oam_view(self) -> memoryview:
+        """
+        Devuelve una vista de solo lectura de OAM (0xFE00-0xFE9F, 160 bytes).
+        
+        Returns:
+            memoryview de 40 sprites * 4 bytes
+        """
+        return self._oam_view
+
+    def get_tile_map_view(self, map_select: int) -> memoryview:
+        """
+        Devuelve una vista de solo lectura de uno de los dos tilemaps de 32x32 (banco 0).
+        
+        Args:
+            map_select: 0 = 0x9800-0x9BFF, 1 = 0x9C00-0x9FFF (valor de LCDC.3 o LCDC.6)
+            
+        Returns:
+            memoryview de 1024 bytes (índice = fila * 32 + columna)
+        """
+        return self._tile_map_views[map_select & 0x01]
+    
     def write_byte_internal(self, addr: int, value: int) -> None:
         """
         Escribe un byte directamente en memoria sin pasar por las restricciones
@@ -851,3 +1064,185 @@ class MMU:
         value = value & 0xFF
         self._memory[addr] = value
 
+
+class DMGMMU(MMU):
+    """
+    MMU especializada para cartuchos DMG (sin flag CGB en la cabecera).
+    
+    Un juego DMG nunca usa los bancos de VRAM, las paletas de color ni KEY1, así
+    que read_byte()/write_byte() no los comprueban: la VRAM se lee y escribe
+    directamente en el banco 0 y WRAM, OAM y HRAM no recorren la cadena de
+    registros I/O. Los registros CGB (0xFF4D, 0xFF4F, 0xFF68-0xFF6B) se tratan
+    como I/O sin implementar (memoria plana), como los demás registros no
+    emulados. Las vistas de VRAM siguen existiendo (el banco 1 queda a cero),
+    así que el renderer y las herramientas no cambian.
+    
+    Fuente: Pan Docs - Memory Map, CGB Registers (solo en modo CGB)
+    """
+    
+    __slots__ = ()
+    
+    MODEL = MODEL_DMG
+    
+    def read_byte(self, addr: int) -> int:
+        """
+        Lee un byte (8 bits). Mismo comportamiento que MMU.read_byte() sin registros CGB.
+        
+        Args:
+            addr: Dirección de memoria (0x0000 a 0xFFFF)
+            
+        Returns:
+            Valor del byte leído (0x00 a 0xFF)
+        """
+        addr = addr & 0xFFFF
+        
+        # ROM (0x0000-0x7FFF): fetch de instrucciones
+        if addr <= 0x7FFF:
+            if self._cartridge is not None:
+                return self._cartridge.read_byte(addr)
+            return self._memory[addr]
+        
+        # VRAM, RAM externa, WRAM, OAM (0x8000-0xFEFF) y HRAM/IE (0xFF80-0xFFFF): memoria plana
+        if addr < 0xFF00 or addr >= 0xFF80:
+            return self._memory[addr]
+        
+        # Registros I/O (0xFF00-0xFF7F)
+        if addr == IO_LY:
+            if self._ppu is not None:
+                return self._ppu.get_ly() & 0xFF
+            return 0
+        if addr == IO_STAT:
+            if self._ppu is not None:
+                return self._ppu.get_stat() & 0xFF
+            return self._memory[addr]
+        if addr == IO_LYC:
+            if self._ppu is not None:
+                return self._ppu.get_lyc() & 0xFF
+            return 0
+        if addr == IO_P1:
+            if self._joypad is not None:
+                return self._joypad.read()
+            return 0xFF
+        if addr == IO_DIV:
+            if self._timer is not None:
+                return self._timer.read_div() & 0xFF
+            return 0
+        if addr == IO_TIMA:
+            if self._timer is not None:
+                return self._timer.read_tima() & 0xFF
+            return 0
+        if addr == IO_TMA:
+            if self._timer is not None:
+                return self._timer.read_tma() & 0xFF
+            return 0
+        if addr == IO_TAC:
+            if self._timer is not None:
+                return self._timer.read_tac() & 0xFF
+            return 0
+        return self._memory[addr]
+    
+    def write_byte(self, addr: int, value: int) -> None:
+        """
+        Escribe un byte (8 bits). Mismo comportamiento que MMU.write_byte() sin registros CGB.
+        
+        Args:
+            addr: Dirección de memoria (0x0000 a 0xFFFF)
+            value: Valor a escribir (se enmascara a 8 bits)
+        """
+        addr = addr & 0xFFFF
+        value = value & 0xFF
+        
+        # ROM (0x0000-0x7FFF): comandos MBC
+        if addr <= 0x7FFF:
+            if self._cartridge is not None:
+                self._cartridge.write_byte(addr, value)
+                return
+            self._memory[addr] = value
+            return
+        
+        # VRAM (0x8000-0x9FFF): siempre banco 0
+        if addr <= 0x9FFF:
+            self._memory[addr] = value
+            # Tile Caching: los tiles de 0x8000-0x97FF ocupan los slots 0-383
+            if addr <= 0x97FF and self._renderer is not None:
+                self._renderer.mark_tile_dirty((addr - 0x8000) >> 4)
+            if self._write_log is not None:
+                self._write_log.record(addr, value)
+            return
+        
+        # RAM externa, WRAM, OAM (0xA000-0xFEFF) y HRAM/IE (0xFF80-0xFFFF)
+        if addr < 0xFF00 or addr >= 0xFF80:
+            self._memory[addr] = value
+            if self._write_log is not None and 0xFE00 <= addr < 0xFEA0:
+                self._write_log.record(addr, value)
+            return
+        
+        # Registros I/O (0xFF00-0xFF7F)
+        if addr == IO_LY:
+            return  # Solo lectura
+        if addr == IO_BGP:
+            # Mismo forzado de paleta visible que MMU.write_byte()
+            if value == 0x00:
+                value = 0xE4
+        elif addr == IO_STAT:
+            # Bits 0-2 de solo lectura
+            self._memory[addr] = value & 0xF8
+            return
+        elif addr == IO_LYC:
+            if self._ppu is not None:
+                self._ppu.set_lyc(value)
+            self._memory[addr] = value
+            return
+        elif addr == IO_P1:
+            if self._joypad is not None:
+                self._joypad.write(value)
+                return
+        elif addr == IO_DIV:
+            if self._timer is not None:
+                self._timer.write_div(value)
+                return
+        elif addr == IO_TIMA:
+            if self._timer is not None:
+                self._timer.write_tima(value)
+                return
+        elif addr == IO_TMA:
+            if self._timer is not None:
+                self._timer.write_tma(value)
+                return
+        elif addr == IO_TAC:
+            if self._timer is not None:
+                self._timer.write_tac(value)
+                return
+        elif addr == IO_DMA:
+            self._oam_dma(value)
+            return
+        elif addr == IO_BOOT:
+            if value and self._boot_cartridge is not None:
+                self.unmap_boot_rom()
+        
+        self._memory[addr] = value
+        
+        # Registro de la PPU: registros LCD 0xFF40-0xFF4B
+        if self._write_log is not None and 0xFF40 <= addr <= 0xFF4B:
+            self._write_log.record(addr, value)
+
+
+def create_mmu(cartridge: Cartridge | None = None, model: str = MODEL_CGB) -> MMU:
+    """
+    Crea la MMU especializada para un modelo de máquina.
+    
+    Args:
+        cartridge: Cartucho insertado (opcional)
+        model: MODEL_DMG o MODEL_CGB
+        
+    Returns:
+        DMGMMU para MODEL_DMG, MMU (con registros CGB) para MODEL_CGB
+        
+    Raises:
+        ValueError: Si el modelo no es válido
+    """
+    if model == MODEL_DMG:
+        return DMGMMU(cartridge)
+    if model == MODEL_CGB:
+        return MMU(cartridge)
+    raise ValueError(f"Modelo de máquina desconocido: {model}")
@@ -0,0 +1,245 @@
+"""
+ROM Patch - Aplicación de parches IPS, UPS y BPS al cargar la ROM
+
+Las traducciones y correcciones de juegos se distribuyen como parches binarios
+sobre la ROM original. Hay tres formatos habituales:
+
+- IPS ("PATCH" ... "EOF"): registros (offset de 3 bytes, tamaño de 2 bytes, datos).
+  Un tamaño 0 es un registro RLE (repetición, 2 bytes) y un valor. Tras "EOF"
+  puede venir un tamaño final de 3 bytes (truncado). No tiene checksum.
+- UPS ("UPS1"): tamaños de origen y destino, y bloques de (salto, bytes XOR
+  terminados en 0x00). Acaba con CRC-32 del origen, del destino y del parche.
+- BPS ("BPS1"): tamaños, metadatos y acciones SourceRead, TargetRead,
+  SourceCopy y TargetCopy. Acaba con los mismos tres CRC-32 que UPS.
+
+Los números de UPS/BPS son enteros de longitud variable: 7 bits por byte, con
+el bit 7 marcando el último byte, y cada byte de continuación suma el peso
+siguiente (así cada valor tiene una única codificación).
+
+Cada parche se recorre una sola vez, de principio a fin, aplicando cada
+registro según se lee. IPS y UPS escriben directamente en la copia de la ROM;
+BPS construye el destino en un buffer nuevo, porque sus copias leen del origen.
+
+Fuente: IPS (Zerosoft, 1993); UPS y BPS (byuu) - especificaciones de los formatos
+"""
+
+from __future__ import annotations
+
+import logging
+import zlib
+from pathlib import Path
+
+logger = logging.getLogger(__name__)
+
+IPS_MAGIC = b"PATCH"
+IPS_EOF = b"EOF"
+UPS_MAGIC = b"UPS1"
+BPS_MAGIC = b"BPS1"
+
+# CRC-32 de origen, destino y parche al final de UPS/BPS
+_FOOTER_SIZE = 12
+
+
+class _Reader:
+    """Cursor sobre los bytes del parche (lectura secuencial)."""
+
+    def __init__(self, data: bytes, end: int) -> None:
+        self.data = data
+        self.pos = 0
+        self.end = end
+
+    def take(self, count: int) -> bytes:
+        start = self.pos
+        if start + count > self.end:
+            raise ValueError("Parche truncado")
+        self.pos = start + count
+        return self.data[start:start + count]
+
+    def byte(self) -> int:
+        if self.pos >= self.end:
+            raise ValueError("Parche truncado")
+        value = self.data[self.pos]
+        self.pos += 1
+        return value
+
+    def number(self) -> int:
+        """Entero de longitud variable de UPS/BPS."""
+        value = 0
+        shift = 1
+        while True:
+            byte = self.byte()
+            value += (byte & 0x7F) * shift
+            if byte & 0x80:
+                return value
+            shift <<= 7
+            value += shift
+
+
+def _split_footer(patch: bytes, name: str) -> tuple[int, int]:
+    """Comprueba el CRC del propio parche y devuelve los CRC de origen y destino."""
+    if len(patch) < len(UPS_MAGIC) + _FOOTER_SIZE:
+        raise ValueError(f"Parche {name} truncado")
+    footer = patch[-_FOOTER_SIZE:]
+    source_crc = int.from_bytes(footer[0:4], "little")
+    target_crc = int.from_bytes(footer[4:8], "little")
+    patch_crc = int.from_bytes(footer[8:12], "little")
+    if zlib.crc32(patch[:-4]) != patch_crc:
+        raise ValueError(f"Parche {name} dañado (CRC del parche incorrecto)")
+    return source_crc, target_crc
+
+
+def _check_source(rom: bytearray, size: int, crc: int, name: str) -> None:
+    if len(rom) != size or zlib.crc32(rom) != crc:
+        raise ValueError(f"El parche {name} no corresponde a esta ROM (CRC de origen incorrecto)")
+
+
+def _check_target(rom: bytearray, size: int, crc: int, name: str) -> None:
+    if len(rom) != size or zlib.crc32(rom) != crc:
+        raise ValueError(f"Resultado del parche {name} incorrecto (CRC de destino)")
+
+
+def _apply_ips(rom: bytearray, patch: bytes) -> bytearray:
+    reader = _Reader(patch, len(patch))
+    reader.take(len(IPS_MAGIC))
+    while True:
+        header = reader.take(3)
+        if header == IPS_EOF:
+            break
+        offset = int.from_bytes(header, "big")
+        size = int.from_bytes(reader.take(2), "big")
+        if size:
+            data = reader.take(size)
+        else:
+            count = int.from_bytes(reader.take(2), "big")
+            data = bytes((reader.byte(),)) * count
+        end = offset + len(data)
+        if end > len(rom):
+            rom.extend(b"\x00" * (end - len(rom)))
+        rom[offset:end] = data
+    # Extensión: tamaño final tras "EOF"
+    if reader.end - reader.pos >= 3:
+        del rom[int.from_bytes(reader.take(3), "big"):]
+    return rom
+
+
+def _apply_ups(rom: bytearray, patch: bytes) -> bytearray:
+    source_crc, target_crc = _split_footer(patch, "UPS")
+    reader = _Reader(patch, len(patch) - _FOOTER_SIZE)
+    reader.take(len(UPS_MAGIC))
+    source_size = reader.number()
+    target_size = reader.number()
+    _check_source(rom, source_size, source_crc, "UPS")
+
+    if target_size > len(rom):
+        rom.extend(b"\x00" * (target_size - len(rom)))
+    pos = 0
+    while reader.pos < reader.end:
+        pos += reader.number()
+        while True:
+            xor = reader.byte()
+            if xor == 0:
+                break
+            if pos < target_size:
+                rom[pos] ^= xor
+            pos += 1
+        # El terminador 0x00 también ocupa una posición
+        pos += 1
+    del rom[target_size:]
+    _check_target(rom, target_size, target_crc, "UPS")
+    return rom
+
+
+def _apply_bps(rom: bytearray, patch: bytes) -> bytearray:
+    source_crc, target_crc = _split_footer(patch, "BPS")
+    reader = _Reader(patch, len(patch) - _FOOTER_SIZE)
+    reader.take(len(BPS_MAGIC))
+    source_size = reader.number()
+    target_size = reader.number()
+    reader.take(reader.number())  # Metadatos (no se usan)
+    _check_source(rom, source_size, source_crc, "BPS")
+
+    source = rom
+    target = bytearray(target_size)
+    out = 0
+    source_rel = 0
+    target_rel = 0
+    while reader.pos < reader.end:
+        data = reader.number()
+        action = data & 3
+        length = (data >> 2) + 1
+        if out + length > target_size:
+            raise ValueError("Parche BPS inválido (escribe fuera del destino)")
+        if action == 0:  # SourceRead: mismo offset en el origen
+            target[out:out + length] = source[out:out + length]
+        elif action == 1:  # TargetRead: bytes del parche
+            target[out:out + length] = reader.take(length)
+        else:
+            offset = reader.number()
+            delta = -(offset >> 1) if offset & 1 else offset >> 1
+            if action == 2:  # SourceCopy
+                source_rel += delta
+                if source_rel < 0 or source_rel + length > len(source):
+                    raise ValueError("Parche BPS inválido (copia fuera del origen)")
+                target[out:out + length] = source[source_rel:source_rel + length]
+                source_rel += length
+            else:  # TargetCopy: puede solaparse con lo que escribe (repeticiones)
+                target_rel += delta
+                if target_rel < 0 or target_rel >= out:
+                    raise ValueError("Parche BPS inválido (copia fuera del destino)")
+                if target_rel + length <= out:
+                    target[out:out + length] = target[target_rel:target_rel + length]
+                else:
+                    for i in range(length):
+                        target[out + i] = target[target_rel + i]
+                target_rel += length
+        out += length
+    _check_target(target, target_size, target_crc, "BPS")
+    return target
+
+
+def apply_patch(rom: bytearray, patch: bytes) -> bytearray:
+    """
+    Aplica un parche IPS, UPS o BPS (detectado por la cabecera).
+
+    Args:
+        rom: Copia privada de la ROM (IPS y UPS la modifican en el sitio)
+        patch: Contenido del parche
+
+    Returns:
+        ROM parcheada (la misma copia, o un buffer nuevo en BPS)
+
+    Raises:
+        ValueError: Si el formato no se reconoce, el parche está dañado o no
+            corresponde a la ROM (CRC de UPS/BPS)
+    """
+    if patch.startswith(IPS_MAGIC):
+        return _apply_ips(rom, patch)
+    if patch.startswith(UPS_MAGIC):
+        return _apply_ups(rom, patch)
+    if patch.startswith(BPS_MAGIC):
+        return _apply_bps(rom, patch)
+    raise ValueError("Formato de parche desconocido (se esperaba IPS, UPS o BPS)")
+
+
+def apply_patch_files(rom: bytes | memoryview, paths: list[Path]) -> bytearray:
+    """
+    Aplica varios parches en orden sobre una copia privada de la ROM.
+
+    Args:
+        rom: ROM original (no se modifica)
+        paths: Archivos de parche
+
+    Returns:
+        ROM parcheada
+
+    Raises:
+        ValueError: Si un parche no es válido (el mensaje incluye el archivo)
+    """
+    patched = bytearray(rom)
+    for path in paths:
+        try:
+            patched = apply_patch(patched, path.read_bytes())
+        except ValueError as e:
+            raise ValueError(f"{path.name}: {e}") from e
+        logger.info(f"Parche aplicado: {path.name} ({len(patched)} bytes)")
+    return patched
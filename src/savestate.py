@@ -0,0 +1,148 @@
+"""
+Save States - Slots de guardado numerados sin pausas en la emulación
+
+Guardar un estado de forma síncrona pararía el juego mientras se serializa, se
+comprime, se calcula el checksum y se hace fsync: decenas de milisegundos, varios
+frames perdidos. Aquí el trabajo se reparte entre dos hilos:
+
+- Hilo de emulación: snapshot.capture(), una copia en memoria de ~74 KB (~10 µs).
+- Hilo de guardado: compresión zlib, CRC-32 y escritura atómica
+  (snapshot.write_atomic) de cada petición, en orden.
+
+Cargar un slot recién guardado no espera al disco: mientras su escritura está
+pendiente se usa la copia en memoria. En otro caso el archivo se mapea en memoria
+(snapshot.read_file) y el snapshot descomprimido se copia directamente a los
+buffers existentes de cada componente. Guardar y cargar caben holgadamente en un
+frame (16,7 ms).
+
+Hay SLOT_COUNT slots por ROM, identificada por el hash de la ROM (como el slot
+de reanudación de src/autosave.py).
+
+Fuente: Python docs - mmap, zlib, threading
+"""
+
+from __future__ import annotations
+
+import logging
+import os
+import queue
+import threading
+from pathlib import Path
+from typing import TYPE_CHECKING
+
+from . import snapshot
+from .snapshot import write_atomic
+
+if TYPE_CHECKING:
+    from .memory.cartridge import Cartridge
+    from .viboy import Viboy
+
+logger = logging.getLogger(__name__)
+
+SLOT_COUNT = 10
+
+
+def default_state_dir() -> Path:
+    """Directorio por defecto ($XDG_DATA_HOME/viboy/states o ~/.local/share/viboy/states)."""
+    base = os.environ.get("XDG_DATA_HOME") or Path.home() / ".local" / "share"
+    return Path(base) / "viboy" / "states"
+
+
+class SaveSlots:
+    """Slots de guardado numerados de una ROM, con escritura en segundo plano."""
+
+    def __init__(self, cartridge: Cartridge, directory: str | Path | None = None) -> None:
+        """
+        Args:
+            cartridge: Cartucho cargado (identifica el juego)
+            directory: Directorio de los slots (None = default_state_dir())
+        """
+        self.directory = Path(directory) if directory is not None else default_state_dir()
+        self._prefix = cartridge.get_rom_sha256()[:32]
+        self.writes = 0
+        # Snapshots capturados cuya escritura aún no terminó (slot -> snapshot)
+        self._unwritten: dict[int, bytes] = {}
+        self._lock = threading.Lock()
+        self._queue: queue.Queue[tuple[int, bytes] | None] = queue.Queue()
+        self._thread: threading.Thread | None = threading.Thread(
+            target=self._write_loop, name="viboy-savestate", daemon=True
+        )
+        self._thread.start()
+
+    def path(self, slot: int) -> Path:
+        """
+        Archivo de un slot.
+
+        Raises:
+            ValueError: Si el slot está fuera de 0..SLOT_COUNT-1
+        """
+        if not 0 <= slot < SLOT_COUNT:
+            raise ValueError(f"Slot inválido: {slot} (0-{SLOT_COUNT - 1})")
+        return self.directory / f"{self._prefix}.s{slot}"
+
+    def save(self, viboy: Viboy, slot: int) -> None:
+        """
+        Guarda el estado actual en un slot. Solo la captura corre en el hilo
+        llamante; la compresión y la escritura se hacen en segundo plano.
+        """
+        path = self.path(slot)
+        data = snapshot.capture(viboy)
+        with self._lock:
+            self._unwritten[slot] = data
+        self._queue.put((slot, data))
+        logger.info(f"Estado guardado en el slot {slot} ({path.name})")
+
+    def load(self, viboy: Viboy, slot: int) -> bool:
+        """
+        Restaura el estado de un slot.
+
+        Returns:
+            True si se restauró; False si el slot está vacío, dañado o es de otro
+            modelo (se mantiene el estado actual)
+        """
+        path = self.path(slot)
+        with self._lock:
+            data = self._unwritten.get(slot)
+        try:
+            if data is None:
+                data = snapshot.read_file(path)
+            snapshot.restore(viboy, data)
+        except FileNotFoundError:
+            return False
+        except (OSError, ValueError) as e:
+            logger.warning(f"No se puede cargar el slot {slot}: {e}")
+            return False
+        logger.info(f"Estado cargado desde el slot {slot}")
+        return True
+
+    def occupied(self) -> list[int]:
+        """Slots con un estado guardado (en disco o pendiente de escribir)."""
+        with self._lock:
+            pending = set(self._unwritten)
+        return [slot for slot in range(SLOT_COUNT) if slot in pending or self.path(slot).exists()]
+
+    def _write_loop(self) -> None:
+        """Hilo de guardado: comprime y escribe cada petición en orden."""
+        while True:
+            item = self._queue.get()
+            if item is None:
+                return
+            slot, data = item
+            try:
+                write_atomic(self.path(slot), snapshot.compress(data))
+                self.writes += 1
+            except OSError as e:
+                logger.warning(f"No se pudo escribir el slot {slot}: {e}")
+            finally:
+                with self._lock:
+                    # Solo si no se guardó otro estado en el mismo slot mientras tanto
+                    if self._unwritten.get(slot) is data:
+                        del self._unwritten[slot]
+
+    def close(self) -> None:
+        """Espera a que se escriban los guardados pendientes y detiene el hilo."""
+        if self._thread is None:
+            return
+        self._queue.put(None)
+        self._thread.join()
+        self._thread = None
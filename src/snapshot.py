@@ -0,0 +1,246 @@
+"""
+Snapshot - Estado completo de la máquina en un bloque de bytes
+
+Un snapshot reúne el estado de cada componente (CPU, MMU, PPU, Timer, Joypad y
+MBC del cartucho) tal como lo serializa su propio save_state(). Cada componente
+sabe qué campos tiene; este módulo solo los agrupa en secciones etiquetadas:
+
+    MAGIC (4) | versión (1) | modelo (1 + n) | secciones: etiqueta (4) | tamaño (u32) | datos
+
+La ROM no forma parte del snapshot (se identifica por la cabecera del cartucho),
+así que ocupa ~74 KB, casi todo el espacio de direcciones de la MMU.
+
+En disco (slots de guardado y reanudación) el snapshot va en un contenedor con
+compresión zlib (LZ77 + Huffman, incluido en Python) y un CRC-32 de los datos
+guardados, que se comprueba antes de descomprimir:
+
+    CMAGIC (4) | versión (1) | códec (1) | CRC-32 (u32) | tamaño sin comprimir (u32) | datos
+
+La mayor parte del espacio de direcciones está a cero o repetido, así que con el
+nivel 1 (el más rápido) el snapshot baja a unos pocos KB en ~0,3 ms.
+
+Lo usan la caché del estado post-arranque (src/memory/boot_rom.py), la
+reanudación (src/autosave.py) y los slots de guardado (src/savestate.py). Los
+tres escriben sus archivos con write_atomic(): temporal en el mismo directorio +
+fsync + os.replace(), así que un corte a mitad de escritura deja el archivo
+anterior intacto, nunca uno a medias.
+
+Fuente: Pan Docs - Memory Map (qué estado tiene cada componente); RFC 1950/1951 (zlib, DEFLATE);
+POSIX rename() - sustitución atómica del archivo destino
+"""
+
+from __future__ import annotations
+
+import mmap
+import os
+import struct
+import tempfile
+import zlib
+from pathlib import Path
+from typing import TYPE_CHECKING
+
+if TYPE_CHECKING:
+    from .viboy import Viboy
+
+MAGIC = b"VBSS"
+VERSION = 1
+
+_SECTION_HEADER = struct.Struct("<4sI")
+_CYCLES_FORMAT = struct.Struct("<Q")
+
+# Contenedor en disco
+CMAGIC = b"VBSC"
+CONTAINER_VERSION = 1
+CODEC_RAW = 0
+CODEC_ZLIB = 1
+COMPRESSION_LEVEL = 1
+_CONTAINER_HEADER = struct.Struct("<4sBBII")
+
+
+def _components(viboy: Viboy) -> dict[bytes, object]:
+    """Componentes con save_state()/load_state(), por etiqueta de sección."""
+    return {
+        b"CPU ": viboy.get_cpu(),
+        b"MMU ": viboy.get_mmu(),
+        b"PPU ": viboy.get_ppu(),
+        b"TIMR": viboy.get_timer(),
+        b"JOYP": viboy.get_joypad(),
+        b"CART": viboy.get_cartridge(),
+    }
+
+
+def capture(viboy: Viboy) -> bytes:
+    """
+    Captura el estado completo de la máquina.
+
+    Args:
+        viboy: Sistema a capturar
+
+    Returns:
+        Snapshot serializado
+    """
+    model = viboy.get_model().encode("ascii")
+    parts = [MAGIC, bytes((VERSION, len(model))), model]
+    sections = {tag: component.save_state() for tag, component in _components(viboy).items()
+                if component is not None}
+    sections[b"SYS "] = _CYCLES_FORMAT.pack(viboy.get_total_cycles())
+    for tag, data in sections.items():
+        parts.append(_SECTION_HEADER.pack(tag, len(data)))
+        parts.append(data)
+    return b"".join(parts)
+
+
+def restore(viboy: Viboy, data: bytes) -> None:
+    """
+    Restaura un snapshot de capture() sobre un sistema con el mismo modelo.
+
+    Es atómico: todas las secciones se validan (presencia y tamaño) antes de
+    modificar ningún componente, así que si el snapshot no es válido la máquina
+    mantiene su estado actual.
+
+    Args:
+        viboy: Sistema destino (con el cartucho ya cargado)
+        data: Snapshot serializado
+
+    Raises:
+        ValueError: Si el snapshot está corrupto, es de otra versión o de otro modelo
+    """
+    view = memoryview(data)
+    if bytes(view[:4]) != MAGIC or len(view) < 6:
+        raise ValueError("No es un snapshot de Viboy")
+    if view[4] != VERSION:
+        raise ValueError(f"Versión de snapshot no soportada: {view[4]}")
+    model_end = 6 + view[5]
+    model = bytes(view[6:model_end]).decode("ascii", "replace")
+    if model != viboy.get_model():
+        raise ValueError(f"Snapshot de modelo {model}, el sistema es {viboy.get_model()}")
+
+    sections: dict[bytes, memoryview] = {}
+    offset = model_end
+    while offset < len(view):
+        if offset + _SECTION_HEADER.size > len(view):
+            raise ValueError("Snapshot truncado")
+        tag, size = _SECTION_HEADER.unpack_from(view, offset)
+        offset += _SECTION_HEADER.size
+        if offset + size > len(view):
+            raise ValueError("Snapshot truncado")
+        # Vistas, no copias: load_state() copia directamente a los buffers del componente
+        sections[tag] = view[offset:offset + size]
+        offset += size
+
+    components = {tag: component for tag, component in _components(viboy).items()
+                  if component is not None}
+    missing = [tag.decode().strip() for tag in components if tag not in sections]
+    if missing or b"SYS " not in sections:
+        raise ValueError(f"Faltan secciones en el snapshot: {missing or ['SYS']}")
+    invalid = [tag.decode().strip() for tag, component in components.items()
+               if len(sections[tag]) != component.state_size()]
+    if len(sections[b"SYS "]) != _CYCLES_FORMAT.size:
+        invalid.append("SYS")
+    if invalid:
+        raise ValueError(f"Secciones de snapshot inválidas: {invalid}")
+
+    for tag, component in components.items():
+        component.load_state(sections[tag])
+    mmu = viboy.get_mmu()
+    if mmu is not None:
+        mmu.unmap_boot_rom()
+    (viboy._total_cycles,) = _CYCLES_FORMAT.unpack(sections[b"SYS "])
+
+
+def compress(data: bytes, level: int = COMPRESSION_LEVEL) -> bytes:
+    """
+    Empaqueta un snapshot en el contenedor comprimido con checksum.
+
+    Args:
+        data: Snapshot de capture()
+        level: Nivel de zlib (1 = más rápido)
+
+    Returns:
+        Contenedor listo para escribir en disco
+    """
+    payload = zlib.compress(data, level)
+    header = _CONTAINER_HEADER.pack(CMAGIC, CONTAINER_VERSION, CODEC_ZLIB,
+                                    zlib.crc32(payload), len(data))
+    return header + payload
+
+
+def decompress(buffer: bytes | memoryview | mmap.mmap) -> bytes:
+    """
+    Extrae el snapshot de un contenedor (o lo devuelve tal cual si no está empaquetado).
+
+    Args:
+        buffer: Contenedor o snapshot sin empaquetar
+
+    Returns:
+        Snapshot para restore()
+
+    Raises:
+        ValueError: Si el checksum no coincide o el contenedor está corrupto
+    """
+    with memoryview(buffer) as view:
+        if bytes(view[:4]) == MAGIC:
+            return bytes(view)
+        if len(view) < _CONTAINER_HEADER.size or bytes(view[:4]) != CMAGIC:
+            raise ValueError("No es un snapshot de Viboy")
+        _, version, codec, crc, size = _CONTAINER_HEADER.unpack_from(view)
+        if version != CONTAINER_VERSION:
+            raise ValueError(f"Versión de contenedor no soportada: {version}")
+        with view[_CONTAINER_HEADER.size:] as payload:
+            if zlib.crc32(payload) != crc:
+                raise ValueError("Checksum incorrecto: el snapshot está dañado")
+            if codec == CODEC_ZLIB:
+                try:
+                    data = zlib.decompress(payload, bufsize=size)
+                except zlib.error as e:
+                    raise ValueError(f"Snapshot comprimido inválido: {e}") from e
+            elif codec == CODEC_RAW:
+                data = bytes(payload)
+            else:
+                raise ValueError(f"Códec de snapshot desconocido: {codec}")
+    if len(data) != size:
+        raise ValueError("Tamaño del snapshot incorrecto")
+    return data
+
+
+def read_file(path: str | Path) -> bytes:
+    """
+    Lee un snapshot de disco. El archivo se mapea en memoria (mmap): el checksum y
+    la descompresión leen directamente de la caché de páginas, sin copiar el
+    archivo a un buffer intermedio.
+
+    Raises:
+        OSError: Si no se puede leer el archivo
+        ValueError: Si está vacío, dañado o no es un snapshot
+    """
+    with open(path, "rb") as f:
+        try:
+            mapped = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        except ValueError as e:
+            raise ValueError(f"Snapshot vacío: {path}") from e
+        with mapped:
+            return decompress(mapped)
+
+
+def write_atomic(path: Path, data: bytes) -> None:
+    """
+    Escribe un archivo de forma atómica: temporal en el mismo directorio, fsync
+    y os.replace().
+
+    Raises:
+        OSError: Si no se puede escribir
+    """
+    path.parent.mkdir(parents=True, exist_ok=True)
+    fd, tmp = tempfile.mkstemp(dir=path.parent, prefix=path.name, suffix=".tmp")
+    try:
+        with os.fdopen(fd, "wb") as f:
+            f.write(data)
+            f.flush()
+            os.fsync(f.fileno())
+        os.replace(tmp, path)
+    except BaseException:
+        try:
+            os.unlink(tmp)
+        except OSError:
+            pass
+        raise
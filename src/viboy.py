@@ -24,19 +24,26 @@ Fuente: Pan Docs - System Clock, Timing
 
 from __future__ import annotations
 
+import gc
 import logging
 import sys
 import time
 from pathlib import Path
-from typing import TYPE_CHECKING
+from typing import TYPE_CHECKING, Any, Sequence, TextIO
 
 from .cpu.core import CPU
 from .cpu.registers import Registers
 from .gpu.ppu import PPU
+from .io.input import InputBindings, InputManager
 from .io.joypad import Joypad
 from .io.timer import Timer
-from .memory.cartridge import Cartridge
-from .memory.mmu import MMU
+from .memory.cartridge import MODEL_CGB, MODEL_DMG, Cartridge
+from .memory.cheats import Cheat, CheatEngine
+from .autosave import AutoSave, DEFAULT_AUTOSAVE_INTERVAL_FRAMES, resume_slot_path
+from .memory.boot_rom import BootCache, BootROM, boot_cache_key
+from .memory.mmu import MMU, create_mmu
+from .savestate import SLOT_COUNT, SaveSlots
+from . import snapshot
 
 # Importar Renderer condicionalmente (requiere pygame)
 try:
@@ -45,7 +52,11 @@ except ImportError:
     Renderer = None  # type: ignore
 
 if TYPE_CHECKING:
-    pass
+    from .debug.state_export import SharedStateExporter
+    from .gpu.numpy_compositor import NumpyCompositor
+    from .gpu.ppu_log import PPUWriteLog
+    from .gpu.recorder import VideoRecorder
+    from .gpu.terminal import TerminalDisplay
 
 logger = logging.getLogger(__name__)
 
@@ -70,8 +81,13 @@ class Viboy:
     # Ciclos por fotograma (frame) para mantener 59.7 FPS
     # 4.194.304 / 59.7 ≈ 70.224 ciclos por frame
     CYCLES_PER_FRAME = 70_224
+    
+    # Límite de M-Cycles para la Boot ROM (5 s emulados; el arranque real dura ~2,5 s).
+    # Una Boot ROM que no termina (p. ej. logo del cartucho inválido) se abandona
+    BOOT_CYCLE_LIMIT = 5 * SYSTEM_CLOCK_HZ // 4
 
-    def __init__(self, rom_path: str | Path | None = None) -> None:
+    def __init__(self, rom_path: str | Path | None = None, model: str | None = None,
+                 patches: Sequence[str | Path] = (), headless: bool = False) -> None:
         """
         Inicializa el sistema Viboy.
         
@@ -80,6 +96,11 @@ class Viboy:
         
         Args:
             rom_path: Ruta opcional al archivo ROM (.gb o .gbc)
+            model: MODEL_DMG o MODEL_CGB (None = según la cabecera del cartucho;
+                   sin cartucho, CGB)
+            patches: Parches IPS/UPS/BPS a aplicar a la ROM al cargarla
+            headless: Sin ventana ni Renderer (p. ej. muchas instancias en un
+                      servidor); run() no limita los FPS
             
         Raises:
             FileNotFoundError: Si el archivo ROM no existe
@@ -94,32 +115,64 @@ class Viboy:
         self._joypad: Joypad | None = None
         self._timer: Timer | None = None
         
+        # Modelo de máquina (DMG/CGB): decide la MMU especializada y el Post-Boot State
+        self._model: str = model or MODEL_CGB
+        
+        # Entrada (teclado y mandos). Se crea con el primer sondeo de eventos
+        self._input: InputManager | None = None
+        self._input_bindings: InputBindings | None = None
+        
         # Contador de ciclos totales ejecutados
         self._total_cycles: int = 0
         
         # Contador de ciclos desde el último render (para heartbeat visual)
         self._cycles_since_render: int = 0
         
+        # Exportación opcional del estado a memoria compartida (None = desactivada)
+        self._state_exporter: SharedStateExporter | None = None
+        
+        # Grabación opcional de vídeo (None = desactivada)
+        self._recorder: VideoRecorder | None = None
+        
+        # Pantalla opcional en la terminal (None = desactivada)
+        self._terminal_display: TerminalDisplay | None = None
+        
+        # Sin renderer, los frames para grabación/terminal se componen con NumPy
+        self._frame_compositor: NumpyCompositor | None = None
+        
+        # Registro opcional de escrituras de la PPU para re-renderizado offline
+        # (None = desactivado). Mientras está activo no se renderiza en el bucle
+        self._ppu_log: PPUWriteLog | None = None
+        
+        # Guardado automático en el slot de reanudación (None = desactivado)
+        self._autosave: AutoSave | None = None
+        
+        # Trucos Game Genie / GameShark del cartucho (None = ninguno añadido)
+        self._cheats: CheatEngine | None = None
+        
+        # Slots de guardado numerados (se crean con el primer guardado o carga)
+        self._save_slots: SaveSlots | None = None
+        self._save_slot: int = 0
+        
         # Sistema de trazado desactivado para rendimiento (comentado)
         # self._trace_active: bool = False
         # self._trace_counter: int = 0
         # self._prev_lcdc: int = 0  # Valor anterior de LCDC para detectar cambios
         
+        # Sin ventana: no se crean el Renderer ni el reloj de FPS
+        self._headless = headless
+        
         # Control de FPS (sincronización de tiempo)
-        # pygame.time.Clock permite limitar la velocidad del bucle a 60 FPS
-        try:
-            import pygame
-            self._clock = pygame.time.Clock()
-        except ImportError:
-            self._clock = None
-            logger.warning("Pygame no disponible. Control de FPS desactivado.")
+        # pygame.time.Clock permite limitar la velocidad del bucle a 60 FPS. Se crea
+        # con el primer run(): una instancia que solo se avanza desde fuera no lo usa
+        self._clock: Any = None
         
         # Si se proporciona ROM, cargarla
         if rom_path is not None:
-            self.load_cartridge(rom_path)
+            self.load_cartridge(rom_path, model, patches)
         else:
             # Inicializar sin cartucho (modo de prueba)
-            self._mmu = MMU(None)
+            self._mmu = create_mmu(None, self._model)
             # Inicializar Timer
             self._timer = Timer()
             # Conectar Timer a MMU para lectura/escritura de DIV/TIMA/TMA/TAC
@@ -135,7 +188,7 @@ class Viboy:
             # Conectar PPU a MMU para que pueda leer LY
             self._mmu.set_ppu(self._ppu)
             # Inicializar Renderer si está disponible
-            if Renderer is not None:
+            if Renderer is not None and not self._headless:
                 try:
                     self._renderer = Renderer(self._mmu, scale=3)
                     # Conectar Renderer a MMU para Tile Caching (marcado de tiles dirty)
@@ -149,22 +202,30 @@ class Viboy:
         
         logger.info("Sistema Viboy inicializado")
 
-    def load_cartridge(self, rom_path: str | Path) -> None:
+    def load_cartridge(self, rom_path: str | Path, model: str | None = None,
+                       patches: Sequence[str | Path] = ()) -> None:
         """
         Carga un cartucho (ROM) en el sistema.
         
+        El modelo de máquina se elige con el flag CGB de la cabecera (0x0143): los
+        cartuchos DMG usan DMGMMU, sin comprobaciones de registros CGB en cada acceso.
+        
         Args:
             rom_path: Ruta al archivo ROM (.gb o .gbc)
+            model: Forzar MODEL_DMG o MODEL_CGB (None = según la cabecera)
+            patches: Parches IPS/UPS/BPS a aplicar en orden (ver src/memory/rom_patch.py)
             
         Raises:
-            FileNotFoundError: Si el archivo ROM no existe
+            FileNotFoundError: Si el archivo ROM o un parche no existe
             IOError: Si hay un error al leer el archivo ROM
+            ValueError: Si un parche no es válido para la ROM
         """
-        # Cargar cartucho
-        self._cartridge = Cartridge(rom_path)
+        # Cargar cartucho (con los parches aplicados antes de parsear la cabecera)
+        self._cartridge = Cartridge(rom_path, patches)
         
-        # Inicializar MMU con el cartucho
-        self._mmu = MMU(self._cartridge)
+        # Inicializar la MMU especializada para el modelo con el cartucho
+        self._model = model or self._cartridge.get_model()
+        self._mmu = create_mmu(self._cartridge, self._model)
         
         # Inicializar Timer
         self._timer = Timer()
@@ -178,6 +239,8 @@ class Viboy:
         
         # Conectar Joypad a MMU para lectura/escritura de P1
         self._mmu.set_joypad(self._joypad)
+        if self._input is not None:
+            self._input.joypad = self._joypad
         
         # Inicializar CPU con la MMU
         self._cpu = CPU(self._mmu)
@@ -189,7 +252,7 @@ class Viboy:
         self._mmu.set_ppu(self._ppu)
         
         # Inicializar Renderer si está disponible
-        if Renderer is not None:
+        if Renderer is not None and not self._headless:
             try:
                 self._renderer = Renderer(self._mmu, scale=3)
                 # Conectar Renderer a MMU para Tile Caching (marcado de tiles dirty)
@@ -200,13 +263,16 @@ class Viboy:
         else:
             self._renderer = None
         
+        # Los trucos son del cartucho anterior
+        self._cheats = None
+        
         # Simular "Post-Boot State" (sin Boot ROM)
         self._initialize_post_boot_state()
         
         # Mostrar información del cartucho cargado
         header_info = self._cartridge.get_header_info()
         logger.info(
-            f"Cartucho cargado: {header_info['title']} | "
+            f"Cartucho cargado: {header_info['title']} ({self._model.upper()}) | "
             f"Tipo: {header_info['cartridge_type']} | "
             f"ROM: {header_info['rom_size']}KB | "
             f"RAM: {header_info['ram_size']}KB"
@@ -226,59 +292,111 @@ class Viboy:
         - A = 0x11: Game Boy Color (CGB)
         - A = 0xFF: Game Boy Pocket / Super Game Boy
         
-        VERSIÓN 0.0.1: Usamos valores CGB para compatibilidad máxima.
-        Los juegos Dual Mode (CGB/DMG) detectan CGB y pueden usar características
-        avanzadas (VRAM Banks, paletas CGB) que ahora están implementadas.
+        Se usan los valores del modelo elegido al cargar el cartucho (flag CGB de la
+        cabecera): un juego Dual Mode en una CGB ve A=0x11 y activa el color, y un
+        juego DMG ve A=0x01 como en su hardware original.
         
-        Valores exactos de Boot ROM CGB (según documentación):
-        - AF = 0x1180 (A=0x11, F=0x80: Z flag activo)
-        - BC = 0x0000
-        - DE = 0xFF56
-        - HL = 0x000D
-        - SP = 0xFFFE
-        - PC = 0x0100
+        Valores exactos tras la Boot ROM (según documentación):
+        - DMG: AF = 0x01B0, BC = 0x0013, DE = 0x00D8, HL = 0x014D
+        - CGB: AF = 0x1180, BC = 0x0000, DE = 0xFF56, HL = 0x000D
+        - Ambos: SP = 0xFFFE, PC = 0x0100
         
-        Fuente: Pan Docs - Boot ROM, Post-Boot State, Game Boy Color detection
+        Fuente: Pan Docs - Boot ROM, Power Up Sequence (CPU registers), Game Boy Color detection
         """
         if self._cpu is None:
             return
         
+        regs = self._cpu.registers
+        
         # PC inicializado a 0x0100 (inicio del código del cartucho)
-        self._cpu.registers.set_pc(0x0100)
+        regs.set_pc(0x0100)
         
         # SP inicializado a 0xFFFE (top de la pila)
-        self._cpu.registers.set_sp(0xFFFE)
-        
-        # VERSIÓN 0.0.1: Valores CGB exactos para compatibilidad máxima
-        # AF = 0x1180 (A=0x11 indica CGB, F=0x80 con Z flag activo)
-        self._cpu.registers.set_a(0x11)
-        self._cpu.registers.set_f(0x80)  # Z flag activo
+        regs.set_sp(0xFFFE)
+        
+        if self._model == MODEL_DMG:
+            # AF = 0x01B0 (A=0x01 indica DMG; F=0xB0: Z, H y C activos)
+            regs.set_a(0x01)
+            regs.set_f(0xB0)
+            regs.set_bc(0x0013)
+            regs.set_de(0x00D8)
+            regs.set_hl(0x014D)
+        else:
+            # AF = 0x1180 (A=0x11 indica CGB, F=0x80 con Z flag activo)
+            regs.set_a(0x11)
+            regs.set_f(0x80)
+            regs.set_bc(0x0000)
+            regs.set_de(0xFF56)
+            regs.set_hl(0x000D)
         
-        # BC = 0x0000
-        self._cpu.registers.set_b(0x00)
-        self._cpu.registers.set_c(0x00)
+        logger.info(
+            f"✅ Post-Boot State ({self._model.upper()}): PC=0x{regs.get_pc():04X}, "
+            f"SP=0x{regs.get_sp():04X}, A=0x{regs.get_a():02X}, "
+            f"BC=0x{regs.get_bc():04X}, DE=0x{regs.get_de():04X}, HL=0x{regs.get_hl():04X}"
+        )
+
+    def run_boot_rom(self, boot_rom: BootROM | str | Path, cache: BootCache | None = None) -> bool:
+        """
+        Arranca el cartucho cargado ejecutando una Boot ROM real en lugar del
+        Post-Boot State simulado.
         
-        # DE = 0xFF56
-        self._cpu.registers.set_d(0xFF)
-        self._cpu.registers.set_e(0x56)
+        El estado resultante solo depende de la Boot ROM, de la cabecera del cartucho
+        y del modelo, así que se guarda en la caché con esa clave: los siguientes
+        arranques lo restauran sin ejecutar ninguna instrucción.
         
-        # HL = 0x000D
-        self._cpu.registers.set_h(0x00)
-        self._cpu.registers.set_l(0x0D)
+        Si la Boot ROM no termina en BOOT_CYCLE_LIMIT M-Cycles (el logo del cartucho
+        no coincide y la Boot ROM se bloquea a propósito), se desmapea y se usa el
+        Post-Boot State simulado. Ese resultado no se guarda en caché.
         
-        # Verificar que se estableció correctamente
-        reg_a = self._cpu.registers.get_a()
-        if reg_a != 0x11:
-            logger.error(f"⚠️ ERROR: Registro A no se estableció correctamente. Esperado: 0x11, Obtenido: 0x{reg_a:02X}")
-        else:
-            logger.info(
-                f"✅ Post-Boot State (CGB): PC=0x{self._cpu.registers.get_pc():04X}, "
-                f"SP=0x{self._cpu.registers.get_sp():04X}, "
-                f"A=0x{reg_a:02X} (CGB mode), "
-                f"BC=0x{self._cpu.registers.get_bc():04X}, "
-                f"DE=0x{self._cpu.registers.get_de():04X}, "
-                f"HL=0x{self._cpu.registers.get_hl():04X}"
-            )
+        Args:
+            boot_rom: Boot ROM o ruta a su archivo
+            cache: Caché de estados post-arranque (None = ejecutar siempre)
+            
+        Returns:
+            True si el estado se restauró desde la caché
+            
+        Raises:
+            RuntimeError: Si no hay cartucho cargado
+            ValueError: Si el archivo no es una Boot ROM DMG o CGB
+            
+        Fuente: Pan Docs - Power Up Sequence
+        """
+        if self._cartridge is None or self._cpu is None or self._mmu is None:
+            raise RuntimeError("Carga un cartucho antes de ejecutar la Boot ROM.")
+        if not isinstance(boot_rom, BootROM):
+            boot_rom = BootROM.load(boot_rom)
+        
+        key = boot_cache_key(boot_rom, self._cartridge, self._model)
+        if cache is not None:
+            state = cache.load(key)
+            if state is not None:
+                try:
+                    snapshot.restore(self, state)
+                    logger.info(f"Estado post-arranque restaurado desde la caché ({key[:12]})")
+                    return True
+                except ValueError as e:
+                    logger.warning(f"Estado post-arranque en caché inválido, se descarta: {e}")
+                    cache.discard(key)
+        
+        # Encendido: registros a cero y la Boot ROM mapeada en 0x0000
+        regs = self._cpu.registers
+        for set_pair in (regs.set_af, regs.set_bc, regs.set_de, regs.set_hl, regs.set_sp, regs.set_pc):
+            set_pair(0)
+        self._mmu.map_boot_rom(boot_rom)
+        
+        limit = self._total_cycles + self.BOOT_CYCLE_LIMIT
+        while self._mmu.is_boot_rom_mapped():
+            if self._total_cycles >= limit:
+                logger.warning("La Boot ROM no terminó; se usa el Post-Boot State simulado")
+                self._mmu.unmap_boot_rom()
+                self._initialize_post_boot_state()
+                return False
+            self.tick()
+        
+        logger.info(f"Boot ROM ejecutada: PC=0x{regs.get_pc():04X}, A=0x{regs.get_a():02X}")
+        if cache is not None:
+            cache.store(key, snapshot.capture(self))
+        return False
 
     def _execute_cpu_only(self) -> int:
         """
@@ -407,9 +525,10 @@ class Viboy:
                 total_cycles += cycles
                 
                 # Convertir a T-Cycles y avanzar subsistemas
+                # (la PPU va a la mitad de ritmo de la CPU en doble velocidad)
                 t_cycles = cycles * 4
                 if self._ppu is not None:
-                    self._ppu.step(t_cycles)
+                    self._ppu.step(t_cycles >> self._mmu.double_speed)
                 if self._timer is not None:
                     self._timer.tick(t_cycles)
                 
@@ -438,13 +557,13 @@ class Viboy:
         
         # Avanzar la PPU (motor de timing)
         # La CPU devuelve M-Cycles, pero la PPU necesita T-Cycles
-        # Conversión: 1 M-Cycle = 4 T-Cycles
+        # Conversión: 1 M-Cycle = 4 T-Cycles (2 puntos de la PPU en doble velocidad CGB)
         t_cycles = cycles * 4
         if self._ppu is not None:
-            self._ppu.step(t_cycles)
+            self._ppu.step(t_cycles >> self._mmu.double_speed)
         
         # Avanzar el Timer
-        # El Timer también necesita T-Cycles
+        # El Timer también necesita T-Cycles (va al reloj de la CPU en ambas velocidades)
         if self._timer is not None:
             self._timer.tick(t_cycles)
         
@@ -487,17 +606,33 @@ class Viboy:
         if self._cpu is None:
             raise RuntimeError("Sistema no inicializado. Llama a load_cartridge() primero.")
         
-        # Constantes de timing
+        # Constantes de timing (en puntos de la PPU, reloj de 4 MHz)
         # Fuente: Pan Docs - LCD Timing
         CYCLES_PER_FRAME = 70_224  # T-Cycles por frame (154 líneas * 456 ciclos)
         CYCLES_PER_LINE = 456       # T-Cycles por scanline
         
+        mmu = self._mmu
+        
         # Configuración de rendimiento
         TARGET_FPS = 60
+        if self._clock is None and not self._headless:
+            self._clock = self._create_clock()
         
         # Contador de frames para título
         frame_count = 0
         
+        # Solo una salida limpia (ventana cerrada o Ctrl+C) guarda el estado al salir:
+        # tras un error, reanudar llevaría de nuevo al mismo error
+        clean_exit = False
+        
+        # Recolector cíclico: lo creado al arrancar (tablas, cachés, superficies) no
+        # cambia durante la partida. freeze() lo mueve a una generación permanente,
+        # así que las colecciones no lo recorren en cada pasada. En estado estable el
+        # bucle de frames no crea contenedores, y el GC prácticamente no se dispara.
+        # Fuente: Python docs - gc.freeze()
+        gc.collect()
+        gc.freeze()
+        
         try:
             # BUCLE PRINCIPAL: Por frame
             while True:
@@ -511,8 +646,13 @@ class Viboy:
                 frame_cycles = 0
                 while frame_cycles < CYCLES_PER_FRAME:
                     # --- BUCLE DE SCANLINE (456 ciclos) ---
+                    # Dominios de reloj: la CPU y el Timer cuentan T-Cycles de la CPU y
+                    # la PPU puntos a 4 MHz. En doble velocidad CGB (KEY1 + STOP) una
+                    # línea son 912 ciclos de CPU; la conversión se hace solo aquí, una
+                    # vez por línea (un cambio de velocidad se aplica en la siguiente)
+                    line_budget = CYCLES_PER_LINE << mmu.double_speed
                     line_cycles = 0
-                    while line_cycles < CYCLES_PER_LINE:
+                    while line_cycles < line_budget:
                         # A. Ejecutar CPU y Timer (cada instrucción)
                         # CRÍTICO: El Timer debe actualizarse cada instrucción
                         # para mantener la precisión del RNG (usado por Tetris)
@@ -536,13 +676,33 @@ class Viboy:
                 
                 # 3. Renderizado si es V-Blank
                 if self._ppu is not None and self._ppu.is_frame_ready():
-                    if self._renderer is not None:
+                    # GameShark: escrituras en RAM al inicio de V-Blank
+                    if self._cheats is not None:
+                        self._cheats.apply_ram()
+                    if self._renderer is not None and self._ppu_log is None:
+                        # render_frame() ya presenta el frame en la ventana
                         self._renderer.render_frame()
-                        try:
-                            import pygame
-                            pygame.display.flip()
-                        except ImportError:
-                            pass
+                
+                # 3b. Publicar estado para herramientas externas (frontera de frame)
+                if self._state_exporter is not None:
+                    self._state_exporter.publish(self)
+                
+                # 3c. Grabación: un frame de vídeo por frame emulado (aunque la PPU
+                # no haya completado uno nuevo, p. ej. con el LCD apagado)
+                if self._recorder is not None:
+                    self._record_frame()
+                
+                # 3d. Registro de la PPU: fin de frame (la imagen se compone offline)
+                if self._ppu_log is not None:
+                    self._ppu_log.end_frame()
+                
+                # 3e. Terminal: solo se captura un frame cuando toca refrescarla
+                if self._terminal_display is not None and self._terminal_display.wants_frame():
+                    self._terminal_display.submit(self._capture_frame())
+                
+                # 3f. Guardado automático periódico (la escritura va en otro hilo)
+                if self._autosave is not None:
+                    self._autosave.end_frame(self)
                 
                 # 4. Sincronización FPS
                 if self._clock is not None:
@@ -550,17 +710,15 @@ class Viboy:
                 
                 # 5. Título con FPS (cada 60 frames para no frenar)
                 frame_count += 1
-                if frame_count % 60 == 0 and self._clock is not None:
-                    try:
-                        import pygame
-                        fps = self._clock.get_fps()
-                        pygame.display.set_caption(f"Viboy Color v0.0.1 - FPS: {fps:.1f}")
-                    except ImportError:
-                        pass
+                if frame_count % 60 == 0 and self._clock is not None and self._renderer is not None:
+                    fps = self._clock.get_fps()
+                    self._renderer.set_title(f"Viboy Color v0.0.1 - FPS: {fps:.1f}")
+            
+            clean_exit = True
         
         except KeyboardInterrupt:
             # Salir limpiamente con Ctrl+C
-            pass
+            clean_exit = True
         
         except NotImplementedError as e:
             # Opcode no implementado
@@ -572,10 +730,319 @@ class Viboy:
             logger.error(f"Error inesperado: {e}", exc_info=True)
             raise
         finally:
-            # Cerrar renderer si está activo
+            gc.unfreeze()
+            # Cerrar mandos y renderer si están activos
+            if self._input is not None:
+                self._input.close()
             if self._renderer is not None:
                 self._renderer.quit()
+            self.disable_state_export()
+            self.disable_recording()
+            self.disable_ppu_log()
+            self.disable_terminal_display()
+            self.disable_autosave(save=clean_exit)
+            self.close_save_slots()
+
+    @staticmethod
+    def _create_clock() -> Any:
+        """Crea el reloj de pygame para limitar los FPS (None sin pygame)."""
+        try:
+            import pygame
+            return pygame.time.Clock()
+        except ImportError:
+            logger.warning("Pygame no disponible. Control de FPS desactivado.")
+            return None
+
+    def enable_state_export(self, name: str | None = None) -> str:
+        """
+        Activa la exportación del estado a un segmento de memoria compartida.
+        
+        El estado (framebuffer, WRAM, OAM, I/O, HRAM y registros) se publica una
+        vez por frame; otros procesos lo leen con SharedStateReader.
+        
+        Args:
+            name: Nombre del segmento (None = "viboy_<pid>")
+            
+        Returns:
+            Nombre del segmento creado
+        """
+        from .debug.state_export import SharedStateExporter
+        
+        self.disable_state_export()
+        self._state_exporter = SharedStateExporter(name)
+        return self._state_exporter.name
+
+    def disable_state_export(self) -> None:
+        """Desactiva la exportación y elimina el segmento de memoria compartida."""
+        if self._state_exporter is not None:
+            self._state_exporter.close()
+            self._state_exporter = None
+
+    def enable_recording(self, path: str | Path, fmt: str | None = None) -> Path:
+        """
+        Empieza a grabar la pantalla emulada en un archivo de vídeo.
+        
+        Se escribe un frame por cada frame emulado (59,73 Hz de tiempo emulado),
+        independientemente de la velocidad real de la emulación.
+        
+        Args:
+            path: Archivo de salida (.y4m para Y4M; cualquier otra extensión, RGB crudo)
+            fmt: "y4m" o "raw" para forzar el formato
+            
+        Returns:
+            Ruta del archivo de vídeo
+            
+        Raises:
+            RuntimeError: Si no hay renderer ni NumPy para obtener los frames
+        """
+        from .gpu.recorder import VideoRecorder
+        
+        self.disable_recording()
+        self._ensure_frame_source()
+        self._recorder = VideoRecorder(path, fmt)
+        return self._recorder.path
+
+    def disable_recording(self) -> None:
+        """Detiene la grabación (espera a que se escriban los frames pendientes)."""
+        if self._recorder is not None:
+            recorder = self._recorder
+            self._recorder = None
+            recorder.close()
+
+    def _record_frame(self) -> None:
+        """Envía el frame actual al grabador (una copia del framebuffer)."""
+        self._recorder.push(self._capture_frame())
+
+    def enable_terminal_display(self, fps: float | None = None, stream: TextIO | None = None) -> None:
+        """
+        Muestra la pantalla emulada en la terminal (semibloques y color de 24 bits).
+        
+        La terminal se refresca a `fps` independientemente de la velocidad de emulación.
+        
+        Args:
+            fps: Frecuencia de refresco (None = valor por defecto)
+            stream: Salida (None = sys.stdout, en la pantalla alternativa de la terminal)
+            
+        Raises:
+            RuntimeError: Si no hay renderer ni NumPy para obtener los frames
+        """
+        from .gpu.terminal import DEFAULT_TERMINAL_FPS, TerminalDisplay
+        
+        self.disable_terminal_display()
+        self._ensure_frame_source()
+        self._terminal_display = TerminalDisplay(
+            stream, fps or DEFAULT_TERMINAL_FPS, alternate_screen=stream is None
+        )
+
+    def disable_terminal_display(self) -> None:
+        """Deja de dibujar en la terminal y la restaura."""
+        if self._terminal_display is not None:
+            display = self._terminal_display
+            self._terminal_display = None
+            display.close()
+
+    def _ensure_frame_source(self) -> None:
+        """
+        Garantiza que _capture_frame() tiene de dónde sacar frames: el renderer o,
+        sin él, el compositor NumPy.
+        
+        Raises:
+            RuntimeError: Si el sistema no está inicializado o falta NumPy sin renderer
+        """
+        if self._mmu is None:
+            raise RuntimeError("Sistema no inicializado. Llama a load_cartridge() primero.")
+        if self._renderer is None and self._frame_compositor is None:
+            from .gpu.numpy_compositor import NumpyCompositor, numpy_available
+            if not numpy_available():
+                raise RuntimeError("Sin renderer hace falta NumPy para componer frames. Instala con: pip install numpy")
+            self._frame_compositor = NumpyCompositor(self._mmu)
+
+    def _capture_frame(self) -> bytes:
+        """Frame actual en RGB (160 * 144 * 3 bytes)."""
+        if self._renderer is not None:
+            return self._renderer.get_framebuffer_rgb()
+        return self._frame_compositor.compose().tobytes()
+
+    def enable_ppu_log(self, path: str | Path, keyframe_interval: int | None = None) -> Path:
+        """
+        Registra las escrituras de VRAM/OAM/registros LCD en un archivo binario en
+        lugar de renderizar. Los frames se reconstruyen después con
+        tools/rerender_ppu_log.py.
+        
+        Args:
+            path: Archivo del registro
+            keyframe_interval: Frames entre keyframes (None = valor por defecto)
+            
+        Returns:
+            Ruta del registro
+        """
+        from .gpu.ppu_log import DEFAULT_KEYFRAME_INTERVAL, PPUWriteLog
+        
+        if self._mmu is None:
+            raise RuntimeError("Sistema no inicializado. Llama a load_cartridge() primero.")
+        self.disable_ppu_log()
+        self._ppu_log = PPUWriteLog(
+            path, self._mmu, self._ppu, keyframe_interval or DEFAULT_KEYFRAME_INTERVAL
+        )
+        self._mmu.set_write_log(self._ppu_log)
+        return self._ppu_log.path
+
+    def disable_ppu_log(self) -> None:
+        """Cierra el registro de la PPU (escribe el índice de keyframes)."""
+        if self._ppu_log is not None:
+            self._mmu.set_write_log(None)
+            self._ppu_log.close()
+            self._ppu_log = None
 
+    def enable_autosave(self, path: str | Path | None = None,
+                        interval_frames: int = DEFAULT_AUTOSAVE_INTERVAL_FRAMES) -> Path:
+        """
+        Activa el guardado automático: periódico durante run() y al salir limpiamente.
+        
+        Args:
+            path: Archivo del slot (None = slot de reanudación de la ROM cargada)
+            interval_frames: Frames emulados entre guardados (0 = solo al salir)
+            
+        Returns:
+            Ruta del slot
+            
+        Raises:
+            RuntimeError: Si no hay cartucho cargado y no se indica ruta
+        """
+        if path is None:
+            if self._cartridge is None:
+                raise RuntimeError("El slot de reanudación necesita un cartucho cargado.")
+            path = resume_slot_path(self._cartridge)
+        self.disable_autosave(save=False)
+        self._autosave = AutoSave(path, interval_frames)
+        logger.info(f"Guardado automático en {self._autosave.path}")
+        return self._autosave.path
+    
+    def disable_autosave(self, save: bool = True) -> None:
+        """
+        Desactiva el guardado automático.
+        
+        Args:
+            save: Guardar el estado actual antes de cerrar
+        """
+        if self._autosave is not None:
+            if save:
+                self._autosave.save(self)
+            self._autosave.close()
+            self._autosave = None
+    
+    def resume(self, path: str | Path | None = None) -> bool:
+        """
+        Restaura el estado guardado en el slot de reanudación, si existe.
+        
+        Args:
+            path: Archivo del slot (None = slot de la ROM cargada)
+            
+        Returns:
+            True si se restauró; False si no hay slot o no es válido para este
+            cartucho y modelo (se mantiene el estado actual)
+        """
+        if path is None:
+            if self._cartridge is None:
+                return False
+            path = resume_slot_path(self._cartridge)
+        try:
+            snapshot.restore(self, snapshot.read_file(path))
+        except FileNotFoundError:
+            return False
+        except (OSError, ValueError) as e:
+            logger.warning(f"No se puede reanudar desde {path}: {e}")
+            return False
+        logger.info(f"Partida reanudada desde {path}")
+        return True
+    
+    def add_cheat(self, code: str, enabled: bool = True) -> Cheat:
+        """
+        Añade un código Game Genie (parche de ROM) o GameShark (escritura en RAM por frame).
+        
+        Raises:
+            RuntimeError: Si no hay cartucho cargado
+            ValueError: Si el código no es válido
+        """
+        if self._cartridge is None or self._mmu is None:
+            raise RuntimeError("Los trucos necesitan un cartucho cargado.")
+        if self._cheats is None:
+            self._cheats = CheatEngine(self._cartridge, self._mmu)
+        return self._cheats.add(code, enabled)
+    
+    def remove_cheat(self, code: str) -> None:
+        """Quita un código añadido con add_cheat()."""
+        if self._cheats is not None:
+            self._cheats.remove(code)
+    
+    def set_cheat_enabled(self, code: str, enabled: bool) -> None:
+        """
+        Activa o desactiva un código sin quitarlo.
+        
+        Raises:
+            KeyError: Si el código no está añadido
+        """
+        if self._cheats is None:
+            raise KeyError(code)
+        self._cheats.set_enabled(code, enabled)
+    
+    def get_cheats(self) -> list[Cheat]:
+        """Devuelve los códigos añadidos (activos o no)."""
+        return self._cheats.cheats if self._cheats is not None else []
+    
+    def _get_save_slots(self) -> SaveSlots:
+        if self._save_slots is None:
+            if self._cartridge is None:
+                raise RuntimeError("Los slots de guardado necesitan un cartucho cargado.")
+            self._save_slots = SaveSlots(self._cartridge)
+        return self._save_slots
+    
+    def select_save_slot(self, slot: int) -> None:
+        """
+        Selecciona el slot que usan save_state_slot()/load_state_slot() sin argumento.
+        
+        Raises:
+            ValueError: Si el slot está fuera de 0..SLOT_COUNT-1
+        """
+        if not 0 <= slot < SLOT_COUNT:
+            raise ValueError(f"Slot inválido: {slot} (0-{SLOT_COUNT - 1})")
+        self._save_slot = slot
+        if self._renderer is not None:
+            self._renderer.set_title(f"Viboy Color v0.0.1 - Slot {slot}")
+    
+    def save_state_slot(self, slot: int | None = None) -> None:
+        """
+        Guarda el estado en un slot (None = slot seleccionado). La compresión y la
+        escritura se hacen en segundo plano (ver src/savestate.py).
+        """
+        self._get_save_slots().save(self, self._save_slot if slot is None else slot)
+    
+    def load_state_slot(self, slot: int | None = None) -> bool:
+        """
+        Carga el estado de un slot (None = slot seleccionado).
+        
+        Returns:
+            True si se restauró; False si el slot está vacío o no es válido
+        """
+        return self._get_save_slots().load(self, self._save_slot if slot is None else slot)
+    
+    def close_save_slots(self) -> None:
+        """Espera a que se escriban los guardados pendientes."""
+        if self._save_slots is not None:
+            self._save_slots.close()
+            self._save_slots = None
+    
+    def set_input_bindings(self, bindings: InputBindings) -> None:
+        """
+        Establece la tabla de asignaciones de teclado y mando.
+        
+        Args:
+            bindings: Tabla cargada con InputBindings.load() o from_dict()
+        """
+        self._input_bindings = bindings
+        if self._input is not None:
+            self._input.set_bindings(bindings)
+    
     def get_total_cycles(self) -> int:
         """
         Devuelve el número total de ciclos ejecutados desde el inicio.
@@ -603,6 +1070,15 @@ class Viboy:
         """
         return self._mmu
 
+    def get_model(self) -> str:
+        """
+        Devuelve el modelo de máquina emulado.
+        
+        Returns:
+            MODEL_DMG o MODEL_CGB
+        """
+        return self._model
+    
     def get_cartridge(self) -> Cartridge | None:
         """
         Devuelve la instancia del cartucho (para tests y debugging).
@@ -621,9 +1097,36 @@ class Viboy:
         """
         return self._ppu
     
+    def get_timer(self) -> Timer | None:
+        """
+        Devuelve la instancia del Timer (para tests y snapshots).
+        
+        Returns:
+            Instancia de Timer o None si no está inicializada
+        """
+        return self._timer
+    
+    def get_joypad(self) -> Joypad | None:
+        """
+        Devuelve la instancia del Joypad (para tests y snapshots).
+        
+        Returns:
+            Instancia de Joypad o None si no está inicializada
+        """
+        return self._joypad
+    
+    def get_renderer(self) -> Renderer | None:
+        """
+        Devuelve la instancia del Renderer (para herramientas y depuración).
+        
+        Returns:
+            Instancia de Renderer o None si no está disponible
+        """
+        return self._renderer
+    
     def _handle_pygame_events(self) -> bool:
         """
-        Maneja eventos de Pygame (cierre de ventana y teclado para Joypad).
+        Maneja eventos de Pygame (cierre de ventana; teclado y mandos para el Joypad).
         
         IMPORTANTE: En macOS, pygame.event.pump() es necesario para que la ventana se actualice.
         
@@ -639,39 +1142,32 @@ class Viboy:
             # para que la ventana se actualice correctamente
             pygame.event.pump()
             
-            # Mapeo de teclas a botones del Joypad
-            # Múltiples teclas mapean al mismo botón para mayor comodidad
-            key_mapping: dict[int, str] = {
-                pygame.K_UP: "up",
-                pygame.K_DOWN: "down",
-                pygame.K_LEFT: "left",
-                pygame.K_RIGHT: "right",
-                pygame.K_z: "a",      # Z o A para botón A
-                pygame.K_a: "a",       # Alternativa: A también mapea a botón A
-                pygame.K_x: "b",       # X o S para botón B
-                pygame.K_s: "b",       # Alternativa: S también mapea a botón B
-                pygame.K_RETURN: "start",
-                pygame.K_RSHIFT: "select",
-            }
+            if self._input is None:
+                self._input = InputManager(self._joypad, self._input_bindings)
+                self._input.init_controllers()
             
             # Obtener todos los eventos pendientes
-            for event in pygame.event.get():
+            events = pygame.event.get()
+            for event in events:
                 # Manejar cierre de ventana
                 if event.type == pygame.QUIT:
                     return False
                 
-                # Manejar eventos de teclado para el Joypad
-                if self._joypad is not None:
-                    if event.type == pygame.KEYDOWN:
-                        button = key_mapping.get(event.key)
-                        if button:
-                            logger.debug(f"KEY PRESS: {event.key} -> button '{button}'")
-                            self._joypad.press(button)
-                    elif event.type == pygame.KEYUP:
-                        button = key_mapping.get(event.key)
-                        if button:
-                            logger.debug(f"KEY RELEASE: {event.key} -> button '{button}'")
-                            self._joypad.release(button)
+                if event.type == pygame.KEYDOWN:
+                    # F2: alternar la mezcla de frames (desactivada / mix / persistence)
+                    if event.key == pygame.K_F2:
+                        self._renderer.cycle_frame_blending()
+                    # F5/F8: guardar/cargar el slot actual; F6/F7: slot anterior/siguiente
+                    elif event.key == pygame.K_F5:
+                        self.save_state_slot()
+                    elif event.key == pygame.K_F8:
+                        self.load_state_slot()
+                    elif event.key in (pygame.K_F6, pygame.K_F7):
+                        step = 1 if event.key == pygame.K_F7 else -1
+                        self.select_save_slot((self._save_slot + step) % SLOT_COUNT)
+            
+            # Teclado y mandos -> Joypad (una sola actualización por sondeo)
+            self._input.process(events)
             
             return True
         except ImportError:
@@ -0,0 +1,62 @@
+"""
+Fixtures compartidas por los tests que arrancan una máquina completa.
+
+- make_rom: escribe una ROM sintética en tmp_path (cabecera, MBC y programa).
+- headless: Viboy sin renderer (sin ventana ni pygame).
+"""
+
+from __future__ import annotations
+
+from collections.abc import Callable, Mapping
+from pathlib import Path
+
+import pytest
+
+import src.viboy
+
+ROM_BANK_SIZE = 0x4000
+PROGRAM_START = 0x0150
+
+
+@pytest.fixture
+def make_rom(tmp_path: Path) -> Callable[..., Path]:
+    """
+    Fábrica de ROMs. Sin programa, la ROM es un bucle infinito en 0x0100 (JP 0x0100);
+    con programa, salta a 0x0150, donde se copia.
+
+    Args de la fábrica:
+        title: Título de la cabecera (0x0134, hasta 15 bytes)
+        cgb_flag: Flag CGB (0x0143)
+        mbc: Tipo de cartucho (0x0147)
+        program: Código a partir de 0x0150 (None = bucle en 0x0100)
+        banks: Bancos de 16KB (2 = 32KB)
+        fill: Byte de relleno del resto de la ROM
+        patches: Bytes sueltos {dirección: valor} (p. ej. datos en otros bancos)
+        name: Nombre del archivo sin extensión (None = título en minúsculas)
+    """
+
+    def factory(title: bytes = b"TESTROM", *, cgb_flag: int = 0x00, mbc: int = 0x00,
+                program: bytes | None = None, banks: int = 2, fill: int = 0x00,
+                patches: Mapping[int, int] | None = None, name: str | None = None) -> Path:
+        rom = bytearray([fill]) * (banks * ROM_BANK_SIZE)
+        rom[0x0134:0x0134 + len(title)] = title
+        rom[0x0143] = cgb_flag
+        rom[0x0147] = mbc
+        if program is None:
+            rom[0x0100:0x0103] = bytes([0xC3, 0x00, 0x01])  # JP 0x0100
+        else:
+            rom[0x0100:0x0103] = bytes([0xC3, PROGRAM_START & 0xFF, PROGRAM_START >> 8])
+            rom[PROGRAM_START:PROGRAM_START + len(program)] = program
+        for address, value in (patches or {}).items():
+            rom[address] = value
+        path = tmp_path / f"{name if name is not None else title.decode().lower()}.gb"
+        path.write_bytes(bytes(rom))
+        return path
+
+    return factory
+
+
+@pytest.fixture
+def headless(monkeypatch: pytest.MonkeyPatch) -> None:
+    """Viboy sin renderer: los tests no abren ventana aunque pygame esté instalado."""
+    monkeypatch.setattr(src.viboy, "Renderer", None)
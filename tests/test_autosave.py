@@ -0,0 +1,154 @@
+"""
+Tests del guardado automático y la reanudación (src/autosave.py).
+
+Valida la escritura en segundo plano (el más reciente gana, sin bloquear al
+llamante), el guardado al salir de run() y la restauración del slot por ROM.
+"""
+
+import threading
+from collections.abc import Callable
+from pathlib import Path
+
+import pytest
+
+import src.autosave
+from src import snapshot
+from src.autosave import SnapshotWriter, resume_slot_path
+from src.memory.cartridge import Cartridge
+from src.viboy import Viboy
+
+
+class StopAfterFrame:
+    """Reloj que detiene run() tras el primer frame con la excepción indicada."""
+
+    def __init__(self, exc: type[BaseException] = KeyboardInterrupt) -> None:
+        self.exc = exc
+
+    def tick(self, fps: int) -> None:
+        raise self.exc
+
+
+class TestSnapshotWriter:
+    """Tests del escritor en segundo plano"""
+
+    def test_submit_never_blocks_and_latest_wins(self, tmp_path: Path,
+                                                 monkeypatch: pytest.MonkeyPatch) -> None:
+        """Test: Con el disco ocupado, submit() no espera y solo se escribe el último pendiente"""
+        release = threading.Event()
+        written: list[bytes] = []
+
+        def slow_write(path: Path, data: bytes) -> None:
+            release.wait(5)
+            written.append(data)
+
+        monkeypatch.setattr(src.autosave, "write_atomic", slow_write)
+        writer = SnapshotWriter(tmp_path / "slot.resume")
+        for i in range(5):
+            writer.submit(bytes([i]))  # Volvería bloqueado si esperase al disco
+        release.set()
+        writer.close()
+
+        assert snapshot.decompress(written[-1]) == bytes([4])
+        assert len(written) <= 2  # El primero (ya en curso) y el más reciente
+
+    def test_close_writes_snapshot_submitted_during_write(self, tmp_path: Path,
+                                                         monkeypatch: pytest.MonkeyPatch) -> None:
+        """Test: close() con una escritura en curso también escribe el snapshot de salida"""
+        writing = threading.Event()
+        release = threading.Event()
+        written: list[bytes] = []
+
+        def blocking_write(path: Path, data: bytes) -> None:
+            writing.set()
+            release.wait(5)
+            written.append(data)
+
+        monkeypatch.setattr(src.autosave, "write_atomic", blocking_write)
+        writer = SnapshotWriter(tmp_path / "slot.resume")
+        writer.submit(b"periodic")
+        assert writing.wait(5)
+        writer.submit(b"exit")
+        closer = threading.Thread(target=writer.close)
+        closer.start()
+        release.set()
+        closer.join(5)
+
+        assert not closer.is_alive()
+        assert [snapshot.decompress(data) for data in written] == [b"periodic", b"exit"]
+
+    def test_atomic_write_replaces_previous_file(self, tmp_path: Path) -> None:
+        """Test: El archivo final tiene el último contenido y no quedan temporales"""
+        writer = SnapshotWriter(tmp_path / "slot.resume")
+        writer.submit(b"first")
+        writer.close()
+        writer = SnapshotWriter(tmp_path / "slot.resume")
+        writer.submit(b"second")
+        writer.close()
+        assert snapshot.decompress((tmp_path / "slot.resume").read_bytes()) == b"second"
+        assert [p.name for p in tmp_path.iterdir()] == ["slot.resume"]
+
+
+class TestResume:
+    """Tests del guardado al salir y la reanudación"""
+
+    def test_slot_is_per_rom_contents(self, tmp_path: Path, make_rom: Callable[..., Path]) -> None:
+        """Test: El slot depende del contenido de la ROM, no del nombre del archivo"""
+        a = resume_slot_path(Cartridge(make_rom(name="a")), tmp_path)
+        renamed = resume_slot_path(Cartridge(make_rom(name="b")), tmp_path)
+        other = resume_slot_path(Cartridge(make_rom(name="c", fill=0xFF)), tmp_path)
+        assert a == renamed
+        assert a != other
+
+    def test_clean_exit_saves_and_launch_resumes(self, tmp_path: Path, make_rom: Callable[..., Path],
+                                                 headless: None) -> None:
+        """Test: Salir con Ctrl+C guarda el estado y el siguiente arranque lo restaura"""
+        rom = make_rom()
+        slot = tmp_path / "slot.resume"
+        viboy = Viboy(rom)
+        viboy.enable_autosave(slot, interval_frames=0)
+        viboy.get_mmu().write_byte(0xC000, 0x5A)
+        viboy._clock = StopAfterFrame()
+        viboy.run()
+        assert slot.exists()
+
+        resumed = Viboy(rom)
+        assert resumed.resume(slot) is True
+        assert resumed.get_mmu().read_byte(0xC000) == 0x5A
+        assert resumed.get_cpu().save_state() == viboy.get_cpu().save_state()
+        assert resumed.get_total_cycles() == viboy.get_total_cycles()
+
+    def test_periodic_save_during_run(self, tmp_path: Path, make_rom: Callable[..., Path],
+                                      headless: None) -> None:
+        """Test: Con intervalo de 1 frame, el bucle guarda sin esperar a la salida"""
+        viboy = Viboy(make_rom())
+        viboy.enable_autosave(tmp_path / "slot.resume", interval_frames=1)
+        autosave = viboy._autosave
+        viboy._clock = StopAfterFrame()
+        viboy.run()
+        assert autosave.writes >= 1
+
+    def test_error_exit_does_not_save(self, tmp_path: Path, make_rom: Callable[..., Path],
+                                      headless: None) -> None:
+        """Test: Tras un error no se guarda (reanudar llevaría al mismo error)"""
+        slot = tmp_path / "slot.resume"
+        viboy = Viboy(make_rom())
+        viboy.enable_autosave(slot, interval_frames=0)
+        viboy._clock = StopAfterFrame(RuntimeError)
+        with pytest.raises(RuntimeError):
+            viboy.run()
+        assert not slot.exists()
+
+    def test_invalid_or_missing_slot_keeps_state(self, tmp_path: Path, make_rom: Callable[..., Path],
+                                                 headless: None) -> None:
+        """Test: Sin slot, con datos inválidos o de otro modelo, resume() devuelve False"""
+        viboy = Viboy(make_rom())
+        assert viboy.resume(tmp_path / "missing.resume") is False
+
+        (tmp_path / "bad.resume").write_bytes(b"garbage")
+        assert viboy.resume(tmp_path / "bad.resume") is False
+
+        cgb = Viboy(make_rom(b"CGBGAME", cgb_flag=0x80))
+        cgb.enable_autosave(tmp_path / "cgb.resume", interval_frames=0)
+        cgb.disable_autosave()
+        assert viboy.resume(tmp_path / "cgb.resume") is False
+        assert viboy.get_cpu().registers.get_pc() == 0x0100
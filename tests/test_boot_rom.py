@@ -0,0 +1,173 @@
+"""
+Tests de la Boot ROM opcional y de la caché del estado post-arranque.
+
+Usa una Boot ROM sintética (no se distribuye ninguna real): deja marcas en I/O y
+VRAM y termina escribiendo en 0xFF50 justo antes de 0x0100, como la original.
+"""
+
+import os
+from collections.abc import Callable
+from pathlib import Path
+
+import pytest
+
+from src import snapshot
+from src.memory.boot_rom import BootCache, BootROM, BootROMOverlay
+from src.memory.cartridge import MODEL_DMG, Cartridge
+from src.memory.mmu import IO_BOOT, IO_SCX
+from src.viboy import Viboy
+
+
+# Visible en 0x0000 cuando la Boot ROM se desmapea
+CARTRIDGE_MARK = {0x0000: 0xAA}
+
+
+def make_boot_rom(finishes: bool = True) -> BootROM:
+    """Boot ROM DMG: SP, SCX=0x42, VRAM[0x8010]=1, NOPs y LDH (0x50),A en 0x00FE."""
+    code = bytearray(0x100)
+    code[0x00:0x03] = bytes([0x31, 0xFE, 0xFF])  # LD SP,0xFFFE
+    code[0x03:0x07] = bytes([0x3E, 0x42, 0xE0, 0x43])  # LD A,0x42 ; LDH (SCX),A
+    code[0x07:0x0D] = bytes([0x3E, 0x01, 0x21, 0x10, 0x80, 0x77])  # LD A,1 ; LD HL,0x8010 ; LD (HL),A
+    if not finishes:
+        code[0x0D:0x0F] = bytes([0x18, 0xFE])  # JR -2: bloqueo (logo inválido)
+    code[0xFC:0x100] = bytes([0x3E, 0x01, 0xE0, 0x50])  # LD A,1 ; LDH (0x50),A
+    return BootROM(bytes(code))
+
+
+class TestBootROM:
+    """Tests de mapeo, ejecución y caché de la Boot ROM"""
+
+    def test_boot_rom_size_is_validated(self) -> None:
+        """Test: Solo se aceptan Boot ROMs DMG (256 bytes) o CGB (2304 bytes)"""
+        with pytest.raises(ValueError):
+            BootROM(bytes(512))
+        assert BootROM(bytes(0x100)).is_cgb is False
+        assert BootROM(bytes(0x900)).is_cgb is True
+
+    def test_cgb_overlay_leaves_header_visible(self, make_rom: Callable[..., Path]) -> None:
+        """Test: La Boot ROM CGB ocupa 0x0000-0x00FF y 0x0200-0x08FF; la cabecera es del cartucho"""
+        overlay = BootROMOverlay(BootROM(bytes([0x11]) * 0x900), Cartridge(make_rom(b"BOOTTEST")))
+        assert overlay.read_byte(0x0000) == 0x11
+        assert overlay.read_byte(0x0134) == ord("B")
+        assert overlay.read_byte(0x0200) == 0x11
+        assert overlay.read_byte(0x0900) == 0x00
+
+    def test_boot_rom_runs_until_ff50(self, make_rom: Callable[..., Path], headless: None) -> None:
+        """Test: La Boot ROM se ejecuta desde 0x0000 y se desmapea al escribir en 0xFF50"""
+        viboy = Viboy(make_rom(patches=CARTRIDGE_MARK))
+        mmu = viboy.get_mmu()
+        assert viboy.run_boot_rom(make_boot_rom()) is False
+
+        regs = viboy.get_cpu().registers
+        assert regs.get_pc() == 0x0100
+        assert regs.get_sp() == 0xFFFE
+        assert mmu.read_byte(IO_SCX) == 0x42
+        assert mmu.read_byte(0x8010) == 0x01
+        assert mmu.read_byte(IO_BOOT) == 0x01
+        assert mmu.is_boot_rom_mapped() is False
+        assert mmu.read_byte(0x0000) == 0xAA  # Vuelve a verse el cartucho
+
+    def test_second_launch_restores_from_cache(self, tmp_path: Path, make_rom: Callable[..., Path],
+                                               headless: None, monkeypatch: pytest.MonkeyPatch) -> None:
+        """Test: El estado post-arranque se guarda y el siguiente arranque no ejecuta nada"""
+        cache = BootCache(tmp_path / "cache")
+        rom = make_rom(patches=CARTRIDGE_MARK)
+        first = Viboy(rom)
+        assert first.run_boot_rom(make_boot_rom(), cache) is False
+        assert len(list(cache.directory.glob("*.state"))) == 1
+
+        def no_tick(self: Viboy) -> int:
+            raise AssertionError("La Boot ROM no debería ejecutarse con la caché")
+
+        monkeypatch.setattr(Viboy, "tick", no_tick)
+        second = Viboy(rom)
+        assert second.run_boot_rom(make_boot_rom(), cache) is True
+        assert second.get_cpu().save_state() == first.get_cpu().save_state()
+        assert second.get_mmu().save_state() == first.get_mmu().save_state()
+        assert second.get_total_cycles() == first.get_total_cycles()
+        assert second.get_mmu().read_byte(0x0000) == 0xAA
+
+    def test_cache_key_depends_on_header(self, tmp_path: Path, make_rom: Callable[..., Path],
+                                         headless: None) -> None:
+        """Test: Otro cartucho (otra cabecera) no reutiliza el estado de la caché"""
+        cache = BootCache(tmp_path / "cache")
+        Viboy(make_rom(b"GAMEONE")).run_boot_rom(make_boot_rom(), cache)
+        assert Viboy(make_rom(b"GAMETWO")).run_boot_rom(make_boot_rom(), cache) is False
+        assert len(list(cache.directory.glob("*.state"))) == 2
+
+    def test_failed_store_leaves_no_temporary_file(self, tmp_path: Path,
+                                                   monkeypatch: pytest.MonkeyPatch) -> None:
+        """Test: Si el renombrado falla, la caché no guarda nada ni deja temporales"""
+        cache = BootCache(tmp_path / "cache")
+
+        def failing_replace(src: str, dst: Path) -> None:
+            raise OSError("disco lleno")
+
+        monkeypatch.setattr(os, "replace", failing_replace)
+        cache.store("key", b"state")
+        assert cache.load("key") is None
+        assert list(cache.directory.iterdir()) == []
+
+    def test_stuck_boot_rom_falls_back_to_post_boot_state(self, tmp_path: Path, make_rom: Callable[..., Path],
+                                                          headless: None,
+                                                          monkeypatch: pytest.MonkeyPatch) -> None:
+        """Test: Una Boot ROM que no termina se abandona y no se guarda en caché"""
+        monkeypatch.setattr(Viboy, "BOOT_CYCLE_LIMIT", 10_000)
+        cache = BootCache(tmp_path / "cache")
+        viboy = Viboy(make_rom())
+        assert viboy.run_boot_rom(make_boot_rom(finishes=False), cache) is False
+
+        regs = viboy.get_cpu().registers
+        assert viboy.get_model() == MODEL_DMG
+        assert (regs.get_pc(), regs.get_a()) == (0x0100, 0x01)
+        assert viboy.get_mmu().is_boot_rom_mapped() is False
+        assert not cache.directory.exists() or not list(cache.directory.glob("*.state"))
+
+
+class TestSnapshot:
+    """Tests del formato de snapshot compartido"""
+
+    def test_round_trip_and_validation(self, make_rom: Callable[..., Path], headless: None) -> None:
+        """Test: restore() deshace los cambios posteriores a capture() y rechaza datos inválidos"""
+        viboy = Viboy(make_rom())
+        mmu = viboy.get_mmu()
+        mmu.write_byte(0xC000, 0x12)
+        state = snapshot.capture(viboy)
+
+        mmu.write_byte(0xC000, 0x34)
+        viboy.get_cpu().registers.set_pc(0x1234)
+        snapshot.restore(viboy, state)
+        assert mmu.read_byte(0xC000) == 0x12
+        assert viboy.get_cpu().registers.get_pc() == 0x0100
+
+        with pytest.raises(ValueError):
+            snapshot.restore(viboy, b"garbage")
+        with pytest.raises(ValueError):
+            snapshot.restore(viboy, state[:-10])
+        cgb = Viboy(make_rom(b"CGBGAME", cgb_flag=0x80))
+        with pytest.raises(ValueError):
+            snapshot.restore(cgb, state)
+
+    def test_invalid_later_section_leaves_machine_unchanged(self, make_rom: Callable[..., Path],
+                                                            headless: None) -> None:
+        """Test: Una sección dañada tras CPU y MMU no restaura nada (restore es atómico)"""
+        viboy = Viboy(make_rom())
+        mmu = viboy.get_mmu()
+        mmu.write_byte(0xC000, 0x12)
+        state = snapshot.capture(viboy)
+
+        # Sección PPU con un byte de menos (tamaño de cabecera coherente)
+        tag_offset = state.index(b"PPU ")
+        size = int.from_bytes(state[tag_offset + 4:tag_offset + 8], "little")
+        data_offset = tag_offset + 8
+        damaged = (state[:tag_offset + 4] + (size - 1).to_bytes(4, "little")
+                   + state[data_offset:data_offset + size - 1] + state[data_offset + size:])
+
+        mmu.write_byte(0xC000, 0x34)
+        viboy.get_cpu().registers.set_pc(0x1234)
+        before = snapshot.capture(viboy)
+        with pytest.raises(ValueError, match="PPU"):
+            snapshot.restore(viboy, damaged)
+        assert snapshot.capture(viboy) == before
+        assert viboy.get_cpu().registers.get_pc() == 0x1234
+        assert mmu.read_byte(0xC000) == 0x34
@@ -0,0 +1,96 @@
+"""
+Tests del modo de doble velocidad CGB (KEY1 + STOP).
+
+Valida el registro KEY1, la instrucción STOP y la escala entre el reloj de la
+CPU/Timer y el de la PPU.
+"""
+
+import pytest
+
+import src.viboy
+from src.cpu.core import CPU
+from src.memory.mmu import IO_DIV, IO_KEY1, IO_LCDC, DMGMMU, MMU
+from src.io.timer import Timer
+from src.viboy import Viboy
+
+
+def make_cpu(mmu: MMU) -> CPU:
+    timer = Timer()
+    mmu.set_timer(timer)
+    timer.set_mmu(mmu)
+    cpu = CPU(mmu)
+    mmu.write_byte(0x0100, 0x10)  # STOP
+    mmu.write_byte(0x0101, 0x00)
+    cpu.registers.set_pc(0x0100)
+    return cpu
+
+
+class TestDoubleSpeed:
+    """Tests de KEY1, STOP y escalado de relojes"""
+
+    def test_stop_switches_speed_when_armed(self) -> None:
+        """Test: STOP con KEY1 armado cambia a doble velocidad y reinicia DIV"""
+        mmu = MMU(None)
+        cpu = make_cpu(mmu)
+        assert mmu.read_byte(IO_KEY1) == 0x7E
+        mmu._timer.tick(1024)
+        assert mmu.read_byte(IO_DIV) != 0
+
+        mmu.write_byte(IO_KEY1, 0x01)
+        assert mmu.read_byte(IO_KEY1) == 0x7F
+        cpu.step()
+
+        assert mmu.double_speed is True
+        assert mmu.read_byte(IO_KEY1) == 0xFE  # Bit 7 = doble, bit 0 limpio
+        assert mmu.read_byte(IO_DIV) == 0
+        assert cpu.registers.get_pc() == 0x0102  # STOP ocupa 2 bytes
+        assert cpu.halted is False
+
+        # Un segundo cambio vuelve a velocidad normal
+        mmu.write_byte(IO_KEY1, 0x01)
+        cpu.registers.set_pc(0x0100)
+        cpu.step()
+        assert mmu.double_speed is False
+
+    def test_stop_without_switch_enters_low_power(self) -> None:
+        """Test: STOP sin cambio preparado (o en DMG) detiene la CPU"""
+        for mmu in (MMU(None), DMGMMU(None)):
+            cpu = make_cpu(mmu)
+            mmu.write_byte(IO_KEY1, 0x01 if isinstance(mmu, DMGMMU) else 0x00)
+            cpu.step()
+            assert cpu.halted is True
+            assert mmu.double_speed is False
+
+    def test_tick_scales_ppu_clock(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        """Test: En doble velocidad, cada M-Cycle son 2 puntos de PPU (4 en normal)"""
+        monkeypatch.setattr(src.viboy, "Renderer", None)
+        viboy = Viboy()
+        viboy.get_mmu().write_byte(IO_LCDC, 0x91)  # LCD encendido: la PPU avanza
+        ppu = viboy.get_ppu()
+        start = ppu.clock
+        viboy.tick()  # NOP (memoria a cero)
+        assert ppu.clock - start == 4
+
+        viboy.get_mmu().double_speed = True
+        start = ppu.clock
+        viboy.tick()
+        assert ppu.clock - start == 2
+
+    @pytest.mark.parametrize("double_speed,expected", [(False, 17_556), (True, 35_112)])
+    def test_run_executes_twice_the_cpu_cycles_per_frame(
+        self, monkeypatch: pytest.MonkeyPatch, double_speed: bool, expected: int
+    ) -> None:
+        """Test: Un frame de PPU ejecuta el doble de ciclos de CPU en doble velocidad"""
+        monkeypatch.setattr(src.viboy, "Renderer", None)
+        viboy = Viboy()
+        viboy.get_mmu().double_speed = double_speed
+
+        class StopAfterFrame:
+            def tick(self, fps: int) -> None:
+                raise KeyboardInterrupt
+
+        viboy._clock = StopAfterFrame()
+        viboy.run()
+        # NOPs de 1 M-Cycle: 70224 puntos / 4 (normal) o / 2 (doble)
+        assert viboy.get_total_cycles() == expected
+        assert viboy.get_ppu().ly == 0  # La PPU completó exactamente un frame
@@ -0,0 +1,101 @@
+"""
+Tests de los trucos Game Genie (páginas de ROM parcheadas) y GameShark
+(escrituras en RAM por frame).
+"""
+
+from collections.abc import Callable
+from pathlib import Path
+
+import pytest
+
+from src.memory.cartridge import Cartridge
+from src.memory.cheats import KIND_GAME_GENIE, KIND_GAMESHARK, parse_cheat
+from src.memory.mmu import IO_LCDC
+from src.viboy import Viboy
+
+
+@pytest.fixture
+def cheat_rom(make_rom: Callable[..., Path]) -> Path:
+    """ROM MBC1 de 64KB (4 bancos); 0x4010 vale 0x11 en el banco 1 y 0x22 en el 2."""
+    return make_rom(b"CHEATTST", mbc=0x01, banks=4,
+                    patches={0x0200: 0xAB, 1 * 0x4000 + 0x0010: 0x11, 2 * 0x4000 + 0x0010: 0x22})
+
+
+def select_bank(cartridge: Cartridge, bank: int) -> None:
+    cartridge.write_byte(0x2000, bank)
+
+
+class TestCheatParsing:
+    """Tests de decodificación de códigos"""
+
+    def test_game_genie_codes(self) -> None:
+        """Test: AB = valor, FCDE ^ 0xF000 = dirección, GI = comparación codificada"""
+        # 0x4010 ^ 0xF000 = 0xB010 -> C=0 D=1 E=0 F=B; 0x11 ^ 0xBA = 0xAB, rotado 2 a la izquierda = 0xAE
+        cheat = parse_cheat("3c0-10b-a0e")
+        assert (cheat.kind, cheat.address, cheat.value, cheat.compare) == (KIND_GAME_GENIE, 0x4010, 0x3C, 0x11)
+
+        short = parse_cheat("3C0-10B")
+        assert (short.address, short.value, short.compare) == (0x4010, 0x3C, None)
+
+    def test_gameshark_codes_and_errors(self) -> None:
+        """Test: ABCDEFGH -> banco AB, valor CD, dirección GHEF"""
+        cheat = parse_cheat("015A00C0")
+        assert (cheat.kind, cheat.bank, cheat.value, cheat.address) == (KIND_GAMESHARK, 0x01, 0x5A, 0xC000)
+
+        for bad in ("", "XYZ-123", "12345", "01FF0040", "000-000"):
+            with pytest.raises(ValueError):
+                parse_cheat(bad)
+
+
+class TestCheatOverlays:
+    """Tests de los parches de ROM por página y de las escrituras GameShark"""
+
+    def test_game_genie_patches_only_matching_banks(self, cheat_rom: Path, headless: None) -> None:
+        """Test: Con comparación, solo se parchea el banco cuyo byte coincide"""
+        viboy = Viboy(cheat_rom)
+        cartridge = viboy.get_cartridge()
+        viboy.add_cheat("3C0-10B-A0E")
+
+        select_bank(cartridge, 1)
+        assert viboy.get_mmu().read_byte(0x4010) == 0x3C
+        select_bank(cartridge, 2)
+        assert viboy.get_mmu().read_byte(0x4010) == 0x22  # Comparación distinta: sin parche
+
+        # Desactivar restaura la página original
+        viboy.set_cheat_enabled("3C0-10B-A0E", False)
+        select_bank(cartridge, 1)
+        assert viboy.get_mmu().read_byte(0x4010) == 0x11
+        viboy.set_cheat_enabled("3C0-10B-A0E", True)
+        assert viboy.get_mmu().read_byte(0x4010) == 0x3C
+        viboy.remove_cheat("3C0-10B-A0E")
+        assert viboy.get_mmu().read_byte(0x4010) == 0x11
+        assert viboy.get_cheats() == []
+
+    def test_only_affected_pages_are_rebuilt(self, cheat_rom: Path) -> None:
+        """Test: Los bancos sin parches siguen siendo vistas de la ROM original"""
+        cartridge = Cartridge(cheat_rom)
+        # Banco 0 (0x0200), sin comparación
+        assert cartridge.set_rom_patches([(0x0200, 0x00, None)]) == {0}
+        assert cartridge.read_byte(0x0200) == 0x00
+        assert cartridge._pages[1] is cartridge._base_pages[1]
+        # Añadir un parche del banco 1 no vuelve a tocar el banco 0
+        assert cartridge.set_rom_patches([(0x0200, 0x00, None), (0x4010, 0x99, 0x11)]) == {1}
+        assert cartridge.set_rom_patches([]) == {0, 1}
+        assert cartridge.read_byte(0x0200) == 0xAB
+        assert cartridge._pages == cartridge._base_pages
+
+    def test_gameshark_applied_each_frame(self, cheat_rom: Path, headless: None) -> None:
+        """Test: Un código GameShark fija el valor en RAM en cada V-Blank"""
+        viboy = Viboy(cheat_rom)
+        mmu = viboy.get_mmu()
+        mmu.write_byte(IO_LCDC, 0x91)  # LCD encendido: la PPU llega a V-Blank
+        viboy.add_cheat("015A00C0")
+        mmu.write_byte(0xC000, 0x00)
+
+        class StopAfterFrame:
+            def tick(self, fps: int) -> None:
+                raise KeyboardInterrupt
+
+        viboy._clock = StopAfterFrame()
+        viboy.run()
+        assert mmu.read_byte(0xC000) == 0x5A
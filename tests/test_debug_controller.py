@@ -0,0 +1,143 @@
+"""
+Tests para el controlador de depuración (src/debug/controller.py).
+
+Valida breakpoints de PC (con banco), watchpoints, condiciones sobre registros,
+step-over/step-out y que el step original se restaura al desarmar todo.
+"""
+
+from types import SimpleNamespace
+
+import pytest
+
+import src.viboy as viboy_module
+from src.cpu.core import CPU
+from src.debug import DebugController
+from src.viboy import Viboy
+
+# Programa de prueba:
+# 0x0100: LD A, 0x05
+# 0x0102: CALL 0x0200
+# 0x0105: LD (0xC000), A
+# 0x0108: JR -2 (bucle infinito)
+# 0x0200: INC A
+# 0x0201: RET
+PROGRAM = {
+    0x0100: [0x3E, 0x05],
+    0x0102: [0xCD, 0x00, 0x02],
+    0x0105: [0xEA, 0x00, 0xC0],
+    0x0108: [0x18, 0xFE],
+    0x0200: [0x3C],
+    0x0201: [0xC9],
+}
+
+
+@pytest.fixture
+def viboy(monkeypatch: pytest.MonkeyPatch) -> Viboy:
+    """Viboy sin renderer (headless) con el programa de prueba cargado."""
+    monkeypatch.setattr(viboy_module, "Renderer", None)
+    system = Viboy()
+    mmu = system.get_mmu()
+    for base, data in PROGRAM.items():
+        for offset, value in enumerate(data):
+            mmu.write_byte(base + offset, value)
+    # Desactivar interrupciones para que el flujo sea determinista
+    mmu.write_byte(0xFFFF, 0x00)
+    return system
+
+
+class TestDebugController:
+    """Tests del controlador de depuración"""
+
+    def test_zero_overhead_when_unused(self, viboy: Viboy) -> None:
+        """Test: Sin nada armado, la CPU usa su step original"""
+        dbg = DebugController(viboy)
+        cpu = viboy.get_cpu()
+        assert not dbg.is_armed()
+        dbg.add_breakpoint(0x0105)
+        assert dbg.is_armed()
+        dbg.remove_breakpoint(0x0105)
+        assert not dbg.is_armed()
+        assert "step" not in cpu.__dict__
+        assert cpu.step.__func__ is CPU.step
+        assert cpu.mmu is viboy.get_mmu()
+
+    def test_pc_breakpoint_and_resume(self, viboy: Viboy) -> None:
+        """Test: Para antes de ejecutar la instrucción y reanuda sin re-disparar"""
+        dbg = DebugController(viboy)
+        dbg.add_breakpoint(0x0105)
+        reason = dbg.cont(max_instructions=100)
+        assert reason is not None
+        assert reason.kind == "breakpoint"
+        assert reason.pc == 0x0105
+        assert viboy.get_cpu().registers.get_a() == 0x06
+
+        # Reanudar: ejecuta LD (0xC000),A y sigue en el bucle sin volver a parar
+        assert dbg.cont(max_instructions=10) is None
+        assert viboy.get_mmu().read_byte(0xC000) == 0x06
+
+    def test_bank_qualified_breakpoint(self, viboy: Viboy) -> None:
+        """Test: Un breakpoint en 0x4000-0x7FFF solo dispara en su banco"""
+        dbg = DebugController(viboy)
+        dbg._cartridge = SimpleNamespace(get_rom_bank=lambda: 2)
+        mmu = viboy.get_mmu()
+        # 0x0100: JP 0x4000; 0x4000: JR -2
+        for addr, value in ((0x0100, 0xC3), (0x0101, 0x00), (0x0102, 0x40), (0x4000, 0x18), (0x4001, 0xFE)):
+            mmu.write_byte(addr, value)
+
+        dbg.add_breakpoint(0x4000, bank=3)
+        assert dbg.cont(max_instructions=20) is None
+
+        dbg.add_breakpoint(0x4000, bank=2)
+        reason = dbg.cont(max_instructions=20)
+        assert reason is not None and reason.kind == "breakpoint"
+
+    def test_write_watchpoint(self, viboy: Viboy) -> None:
+        """Test: Un watchpoint de escritura para tras la instrucción que escribe"""
+        dbg = DebugController(viboy)
+        dbg.add_watchpoint(0xC000, write=True)
+        reason = dbg.cont(max_instructions=100)
+        assert reason is not None
+        assert reason.kind == "watch_write"
+        assert reason.addr == 0xC000
+        assert reason.value == 0x06
+        assert reason.pc == 0x0108
+        dbg.remove_watchpoint(0xC000)
+        assert viboy.get_cpu().mmu is viboy.get_mmu()
+
+    def test_register_condition(self, viboy: Viboy) -> None:
+        """Test: Una condición sobre un registro para cuando se cumple"""
+        dbg = DebugController(viboy)
+        dbg.add_register_condition("a", 0x06)
+        reason = dbg.cont(max_instructions=100)
+        assert reason is not None
+        assert reason.kind == "condition"
+        assert reason.pc == 0x0201  # justo después de INC A
+        with pytest.raises(ValueError):
+            dbg.add_register_condition("zz", 0)
+
+    def test_step_and_step_over(self, viboy: Viboy) -> None:
+        """Test: step ejecuta una instrucción y step-over salta la subrutina"""
+        dbg = DebugController(viboy)
+        regs = viboy.get_cpu().registers
+        reason = dbg.step()
+        assert reason is not None and reason.kind == "step"
+        assert regs.get_pc() == 0x0102
+
+        reason = dbg.step_over()
+        assert reason is not None
+        assert regs.get_pc() == 0x0105
+        assert regs.get_a() == 0x06
+        assert not dbg.is_armed()
+
+    def test_step_out(self, viboy: Viboy) -> None:
+        """Test: step-out corre hasta el RET que abandona la subrutina"""
+        dbg = DebugController(viboy)
+        dbg.add_breakpoint(0x0200)
+        assert dbg.cont(max_instructions=100).pc == 0x0200
+        dbg.remove_breakpoint(0x0200)
+
+        reason = dbg.step_out()
+        assert reason is not None
+        assert reason.kind == "step_out"
+        assert viboy.get_cpu().registers.get_pc() == 0x0105
+        assert not dbg.is_armed()
@@ -0,0 +1,118 @@
+"""
+Tests del bucle de frames en estado estable: sin crecimiento de memoria ni
+pasadas del recolector (tracemalloc + gc.callbacks), y las superficies del
+renderer se reutilizan en lugar de crearse de nuevo.
+"""
+
+import gc
+import os
+import tracemalloc
+from collections.abc import Callable
+from pathlib import Path
+from typing import Any
+
+import pytest
+
+import src.viboy
+from src.viboy import Viboy
+
+os.environ.setdefault("SDL_VIDEODRIVER", "dummy")
+os.environ.setdefault("SDL_AUDIODRIVER", "dummy")
+
+try:
+    from src.gpu.renderer import Renderer
+except ImportError:  # pragma: no cover - sin pygame
+    Renderer = None  # type: ignore[assignment,misc]
+
+WARMUP_FRAMES = 10
+MEASURED_FRAMES = 100
+# Margen para los contadores internos de pygame/SDL y de tracemalloc
+GROWTH_BUDGET_BYTES = 4 * 1024
+
+# Bucle que ejercita CPU (CB: SWAP, RL, BIT), escrituras en VRAM (tile 1) y un
+# sprite que se mueve, con LCD, fondo y sprites activos
+PROGRAM = bytes([
+    0x31, 0xFE, 0xFF,        # LD SP, 0xFFFE
+    0x3E, 0xE4, 0xE0, 0x47,  # LD A, 0xE4; LDH (BGP), A
+    0x3E, 0xD2, 0xE0, 0x48,  # LD A, 0xD2; LDH (OBP0), A
+    0x21, 0x00, 0xFE,        # LD HL, 0xFE00
+    0x36, 0x20, 0x2C,        # LD (HL), 0x20; INC L   (Y)
+    0x36, 0x20, 0x2C,        # LD (HL), 0x20; INC L   (X)
+    0x36, 0x01,              # LD (HL), 0x01          (tile 1)
+    0x3E, 0x93, 0xE0, 0x40,  # LD A, 0x93; LDH (LCDC), A
+    # loop (0x0168):
+    0x21, 0x10, 0x80,        # LD HL, 0x8010
+    0x7E,                    # LD A, (HL)
+    0xCB, 0x37,              # SWAP A
+    0xCB, 0x17,              # RL A
+    0x3C,                    # INC A
+    0x77,                    # LD (HL), A
+    0xCB, 0x47,              # BIT 0, A
+    0x21, 0x01, 0xFE,        # LD HL, 0xFE01
+    0x34,                    # INC (HL)
+    0x18, 0xEE,              # JR loop
+])
+
+
+class MeasuringClock:
+    """Reloj falso: mide memoria y colecciones entre el frame de calentamiento y el final."""
+
+    def __init__(self, viboy: Viboy) -> None:
+        self.viboy = viboy
+        self.frames = 0
+        self.growth: int | None = None
+        self.collections = 0
+        self.surfaces: list[Any] = []
+
+    def _on_gc(self, phase: str, info: dict[str, Any]) -> None:
+        if phase == "start":
+            self.collections += 1
+
+    def tick(self, fps: int) -> None:
+        self.frames += 1
+        if self.frames == WARMUP_FRAMES:
+            self.surfaces = self._surfaces()
+            tracemalloc.start()
+            self._before = tracemalloc.get_traced_memory()[0]
+            gc.callbacks.append(self._on_gc)
+        elif self.frames == WARMUP_FRAMES + MEASURED_FRAMES:
+            gc.callbacks.remove(self._on_gc)
+            self.growth = tracemalloc.get_traced_memory()[0] - self._before
+            tracemalloc.stop()
+            assert self._surfaces() == self.surfaces
+            raise KeyboardInterrupt
+
+    def _surfaces(self) -> list[Any]:
+        """Superficies del tile 1 (fondo y sprite) y destino del escalado."""
+        renderer = self.viboy.get_renderer()
+        if renderer is None:
+            return []
+        return [renderer.tile_cache[1], *renderer._sprite_surfaces[1], renderer._presenter._scaled]
+
+    def get_fps(self) -> float:
+        return 60.0
+
+
+class TestFrameAllocations:
+    """Tests del bucle de frames sin asignaciones en estado estable"""
+
+    def test_steady_state_frames_do_not_allocate(self, make_rom: Callable[..., Path],
+                                                 monkeypatch: pytest.MonkeyPatch) -> None:
+        """Test: 100 frames tras calentar no hacen crecer la memoria ni disparan el GC"""
+        if Renderer is not None:
+            monkeypatch.setattr(Renderer, "_show_loading_screen", lambda self, duration=0: None)
+        # Con pygame se mide también el renderer y la presentación; sin él, headless
+        viboy = Viboy(make_rom(b"FRAMELOP", program=PROGRAM), headless=Renderer is None)
+        clock = MeasuringClock(viboy)
+        viboy._clock = clock
+        monkeypatch.setattr(src.viboy.Viboy, "_create_clock", staticmethod(lambda: clock))
+
+        viboy.run()
+
+        assert clock.growth is not None
+        if Renderer is not None:
+            assert all(surface is not None for surface in clock.surfaces)
+        assert viboy.get_mmu().read_byte(0xFE01) != 0x20  # El sprite se ha movido
+        assert clock.growth < GROWTH_BUDGET_BYTES, f"{clock.growth} bytes en {MEASURED_FRAMES} frames"
+        assert clock.collections == 0
+        assert not gc.get_freeze_count()  # run() descongela al salir
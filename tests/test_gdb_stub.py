@@ -0,0 +1,168 @@
+"""
+Tests para el stub del protocolo remoto de GDB (src/debug/gdb_stub.py).
+
+Usa un cliente RSP mínimo escrito en el propio test que se conecta por
+localhost (o socket Unix): no se requiere red ni gdb instalado.
+"""
+
+import socket
+import sys
+import threading
+
+import pytest
+
+import src.viboy as viboy_module
+from src.debug.gdb_stub import GDBStub, checksum, encode_packet
+from src.viboy import Viboy
+
+# 0x0100: LD A, 0x05 / 0x0102: INC A / 0x0103: LD (0xC000), A / 0x0106: JR -2
+PROGRAM = [0x3E, 0x05, 0x3C, 0xEA, 0x00, 0xC0, 0x18, 0xFE]
+
+
+@pytest.fixture
+def viboy(monkeypatch: pytest.MonkeyPatch) -> Viboy:
+    """Viboy sin renderer con el programa de prueba en 0x0100."""
+    monkeypatch.setattr(viboy_module, "Renderer", None)
+    system = Viboy()
+    mmu = system.get_mmu()
+    for offset, value in enumerate(PROGRAM):
+        mmu.write_byte(0x0100 + offset, value)
+    mmu.write_byte(0xFFFF, 0x00)
+    return system
+
+
+class RSPClient:
+    """Cliente RSP mínimo."""
+
+    def __init__(self, sock: socket.socket) -> None:
+        self.sock = sock
+        self.buffer = b""
+        self.ack = True
+
+    def _read_until(self, marker: bytes) -> None:
+        while marker not in self.buffer:
+            data = self.sock.recv(4096)
+            assert data, "conexión cerrada por el stub"
+            self.buffer += data
+
+    def command(self, payload: str) -> str:
+        self.sock.sendall(encode_packet(payload.encode("ascii")))
+        if self.ack:
+            self._read_until(b"+")
+            self.buffer = self.buffer[self.buffer.index(b"+") + 1:]
+        self._read_until(b"#")
+        end = self.buffer.index(b"#")
+        while len(self.buffer) < end + 3:
+            self.buffer += self.sock.recv(4096)
+        start = self.buffer.index(b"$")
+        body = self.buffer[start + 1:end]
+        assert int(self.buffer[end + 1:end + 3], 16) == checksum(body)
+        self.buffer = self.buffer[end + 3:]
+        if self.ack:
+            self.sock.sendall(b"+")
+        return body.decode("ascii")
+
+
+def _start(stub: GDBStub, family: int, address) -> tuple[RSPClient, threading.Thread]:
+    thread = threading.Thread(target=stub.serve, daemon=True)
+    thread.start()
+    sock = socket.socket(family, socket.SOCK_STREAM)
+    sock.settimeout(10)
+    sock.connect(address)
+    return RSPClient(sock), thread
+
+
+class TestGDBStub:
+    """Tests del stub RSP"""
+
+    def test_packet_encoding(self) -> None:
+        """Test: Enmarcado y escape de paquetes"""
+        assert encode_packet(b"OK") == b"$OK#9a"
+        assert encode_packet(b"a#b") == b"$a}\x03b#" + f"{checksum(b'a}' + bytes([0x03]) + b'b'):02x}".encode()
+
+    def test_handle_packet_registers_and_memory(self, viboy: Viboy) -> None:
+        """Test: g/p/P/m/M sin transporte"""
+        stub = GDBStub(viboy)
+        regs = viboy.get_cpu().registers
+        regs.set_bc(0x1234)
+        g = stub.handle_packet(b"g").decode()
+        assert len(g) == 6 * 4
+        assert g[4:8] == "3412"  # BC little-endian
+        assert g[20:24] == "0001"  # PC = 0x0100
+
+        assert stub.handle_packet(b"P1=cdab") == b"OK"
+        assert regs.get_bc() == 0xABCD
+        assert stub.handle_packet(b"p5") == b"0001"
+
+        assert stub.handle_packet(b"m100,3") == b"3e053c"
+        assert stub.handle_packet(b"Mc100,2:beef") == b"OK"
+        assert viboy.get_mmu().read_byte(0xC101) == 0xEF
+        assert stub.handle_packet(b"vMustReplyEmpty") == b""
+
+    def test_malformed_arguments_reply_error(self, viboy: Viboy) -> None:
+        """Test: Argumentos mal formados responden E01 sin cortar la sesión"""
+        stub = GDBStub(viboy)
+        for packet in (b"mzz,1", b"P5=12", b"Pzz=0001", b"p", b"Mc000,1:zz", b"Z2,zz,1", b"czz"):
+            assert stub.handle_packet(packet) == b"E01", packet
+        assert stub.handle_packet(b"m100,1") == b"3e"
+
+    def test_access_watchpoint_reports_awatch(self, viboy: Viboy) -> None:
+        """Test: Un watchpoint de acceso (Z4) para con awatch y uno de escritura (Z2) con watch"""
+        stub = GDBStub(viboy)
+        assert stub.handle_packet(b"Z4,c000,1") == b"OK"
+        assert stub.handle_packet(b"c") == b"T05awatch:c000;"
+        assert stub.handle_packet(b"z4,c000,1") == b"OK"
+        viboy.get_cpu().registers.set_pc(0x0100)
+        assert stub.handle_packet(b"Z2,c000,1") == b"OK"
+        assert stub.handle_packet(b"c") == b"T05watch:c000;"
+        assert stub.handle_packet(b"D") == b"OK"
+
+    def test_session_over_tcp(self, viboy: Viboy) -> None:
+        """Test: Sesión completa por localhost: breakpoint, continue, step, watchpoint"""
+        stub = GDBStub(viboy, port=0)
+        address = stub.listen()
+        client, thread = _start(stub, socket.AF_INET, address)
+        try:
+            assert "PacketSize" in client.command("qSupported:swbreak+")
+            assert client.command("?") == "T05"
+
+            assert client.command("Z0,103,1") == "OK"
+            assert client.command("c") == "T05swbreak:;"
+            assert viboy.get_cpu().registers.get_pc() == 0x0103
+            assert client.command("z0,103,1") == "OK"
+
+            assert client.command("s") == "T05"
+            assert viboy.get_cpu().registers.get_pc() == 0x0106
+            assert client.command("mc000,1") == "06"
+
+            assert client.command("Z2,c000,1") == "OK"
+            # El bucle JR -2 no escribe: hay que interrumpir con Ctrl-C
+            client.sock.sendall(b"\x03")
+            assert client.command("c") == "T02"
+
+            assert client.command("D") == "OK"
+        finally:
+            client.sock.close()
+            thread.join(timeout=10)
+            stub.close()
+        # Tras desconectar no queda nada armado
+        assert not stub.debugger.is_armed()
+        assert viboy.get_cpu().mmu is viboy.get_mmu()
+
+    @pytest.mark.skipif(sys.platform == "win32", reason="Sockets Unix no disponibles")
+    def test_session_over_unix_socket(self, viboy: Viboy, tmp_path) -> None:
+        """Test: El stub también escucha en un socket Unix"""
+        path = str(tmp_path / "viboy-gdb.sock")
+        stub = GDBStub(viboy, unix_path=path)
+        stub.listen()
+        client, thread = _start(stub, socket.AF_UNIX, path)
+        try:
+            assert client.command("QStartNoAckMode") == "OK"
+            # Sin acks a partir de aquí
+            client.ack = False
+            assert client.command("p5") == "0001"
+            client.sock.sendall(encode_packet(b"k"))
+        finally:
+            client.sock.close()
+            thread.join(timeout=10)
+            stub.close()
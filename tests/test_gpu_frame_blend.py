@@ -0,0 +1,79 @@
+"""
+Tests para la mezcla de frames (src/gpu/frame_blend.py).
+
+Valida los modos "mix" (50/50 con el frame anterior) y "persistence"
+(exponencial), que el framebuffer original no se modifica y el cambio de modo
+en tiempo de ejecución desde el Renderer.
+"""
+
+from __future__ import annotations
+
+import pytest
+
+pygame = pytest.importorskip("pygame")
+
+from src.gpu.frame_blend import FrameBlender
+from src.gpu.renderer import Renderer
+from src.memory.mmu import MMU
+
+
+def _solid(value: int) -> pygame.Surface:
+    surface = pygame.Surface((160, 144), 0, 32)
+    surface.fill((value, value, value))
+    return surface
+
+
+def _grey(surface: pygame.Surface) -> int:
+    return surface.get_at((80, 72))[0]
+
+
+class TestFrameBlender:
+    """Tests del post-proceso"""
+
+    def test_mix_alternating_frames(self) -> None:
+        """Test: Un sprite en frames alternos se ve al 50% y estable"""
+        blender = FrameBlender((160, 144), "mix")
+        white, black = _solid(255), _solid(0)
+        # El primer frame no tiene historial: se presenta tal cual
+        assert _grey(blender.apply(white)) == 255
+        outputs = [_grey(blender.apply(frame)) for frame in (black, white, black, white)]
+        assert all(abs(value - 128) <= 1 for value in outputs)
+        # El framebuffer de entrada no se modifica
+        assert _grey(black) == 0 and _grey(white) == 255
+
+    def test_persistence_decays(self) -> None:
+        """Test: Con persistencia la imagen anterior se desvanece poco a poco"""
+        blender = FrameBlender((160, 144), "persistence", persistence=0.75)
+        blender.apply(_solid(255))
+        black = _solid(0)
+        values = [_grey(blender.apply(black)) for _ in range(4)]
+        assert values == sorted(values, reverse=True)
+        assert abs(values[0] - 191) <= 2      # 255 * 0.75
+        assert abs(values[1] - 143) <= 3      # 255 * 0.75^2
+        blender.reset()
+        assert _grey(blender.apply(black)) == 0
+
+    def test_invalid_arguments(self) -> None:
+        """Test: Modo o persistencia no válidos"""
+        with pytest.raises(ValueError):
+            FrameBlender((160, 144), "motion-blur")
+        with pytest.raises(ValueError):
+            FrameBlender((160, 144), "persistence", persistence=1.5)
+
+    def test_renderer_toggle(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        """Test: El Renderer alterna los modos y el framebuffer no se mezcla"""
+        monkeypatch.setattr(Renderer, "_show_loading_screen", lambda self, duration=0: None)
+        renderer = Renderer(MMU(), scale=1)
+        try:
+            assert renderer.get_frame_blending() is None
+            assert renderer.cycle_frame_blending() == "mix"
+            assert renderer.cycle_frame_blending() == "persistence"
+            assert renderer.cycle_frame_blending() is None
+            
+            renderer.set_frame_blending("mix")
+            renderer.render_frame()
+            raw = renderer.get_framebuffer_rgb()
+            renderer.render_frame()
+            assert renderer.get_framebuffer_rgb() == raw
+        finally:
+            renderer.quit()
@@ -18,7 +18,7 @@ except ImportError:
     pygame = None
     pytestmark = pytest.mark.skip("Pygame no disponible")
 
-from src.gpu.renderer import Renderer
+from src.gpu.renderer import TILE_SLOT_SIGNED, TILE_SLOT_UNSIGNED, Renderer
 from src.memory.mmu import MMU, IO_LCDC, IO_BGP
 
 
@@ -164,3 +164,90 @@ class TestPerformance:
         # Log informativo
         print(f"\n✅ Tiempo por frame: {elapsed_time*1000:.2f}ms (objetivo: < 16ms para 60 FPS)")
 
+
+
+class TestDirectViews:
+    """Tests para las lecturas directas de VRAM/OAM del renderer."""
+    
+    def test_render_frame_avoids_read_byte_for_vram(self, renderer: Renderer, monkeypatch: pytest.MonkeyPatch) -> None:
+        """
+        Test: Un frame con fondo, window y sprites solo llama a read_byte() para registros I/O.
+        
+        Los tilemaps, los datos de tile y OAM se leen de vistas directas.
+        """
+        mmu = renderer.mmu
+        mmu.write_byte(IO_LCDC, 0xF3)  # LCD, window (0x9C00), tiles 0x8000, sprites, BG
+        for i in range(0x8000, 0x9800):
+            mmu.write_byte(i, i & 0xFF)
+        mmu.write_byte(0xFE00, 40)
+        mmu.write_byte(0xFE01, 40)
+        renderer.render_frame()
+        
+        addresses: list[int] = []
+        original = MMU.read_byte
+        
+        def counting_read(self: MMU, addr: int) -> int:
+            addresses.append(addr)
+            return original(self, addr)
+        
+        monkeypatch.setattr(MMU, "read_byte", counting_read)
+        renderer.render_frame()
+        
+        assert not [addr for addr in addresses if addr < 0xFF00], addresses
+        assert len(addresses) < 20
+
+
+class TestUnifiedTileCache:
+    """Tests para la caché unificada de tiles (2 bancos x 384, ambos direccionamientos)."""
+    
+    def test_slot_tables(self) -> None:
+        """Test: Las tablas Tile ID -> slot cubren 0x8000 (unsigned) y 0x8800/0x9000 (signed)"""
+        assert TILE_SLOT_UNSIGNED[0] == 0 and TILE_SLOT_UNSIGNED[255] == 255
+        assert TILE_SLOT_SIGNED[0] == 256  # 0x9000
+        assert TILE_SLOT_SIGNED[127] == 383  # 0x97F0
+        assert TILE_SLOT_SIGNED[128] == 128  # 0x8800
+        assert TILE_SLOT_SIGNED[255] == 255  # 0x8FF0
+    
+    def test_signed_addressing_and_palette_change(self, renderer: Renderer) -> None:
+        """Test: Tiles en 0x8800/0x9000 salen de la caché; un cambio de BGP no re-decodifica"""
+        mmu = renderer.mmu
+        mmu.write_byte(IO_LCDC, 0x81)  # LCD ON, BG ON, signed (LCDC.4 = 0), mapa 0x9800
+        mmu.write_byte(IO_BGP, 0xE4)
+        # Tile ID 0 (0x9000): fila 0 en color 3; tile ID 0x80 (0x8800): fila 0 en color 1
+        mmu.write_byte(0x9000, 0xFF)
+        mmu.write_byte(0x9001, 0xFF)
+        mmu.write_byte(0x8800, 0xFF)
+        mmu.write_byte(0x9800, 0x00)
+        mmu.write_byte(0x9801, 0x80)
+        renderer.render_frame()
+        assert tuple(renderer.buffer.get_at((0, 0)))[:3] == (0, 0, 0)
+        assert tuple(renderer.buffer.get_at((8, 0)))[:3] == (170, 170, 170)
+        assert not any(renderer.tile_dirty)
+        
+        # Paleta invertida: los mismos tiles cambian de color sin marcarse como sucios
+        cached = renderer.tile_cache[256]
+        mmu.write_byte(IO_BGP, 0x1B)
+        renderer.render_frame()
+        assert renderer.tile_cache[256] is cached
+        assert tuple(renderer.buffer.get_at((0, 0)))[:3] == (255, 255, 255)
+        assert tuple(renderer.buffer.get_at((8, 0)))[:3] == (85, 85, 85)
+    
+    def test_bank1_tiles(self, renderer: Renderer) -> None:
+        """Test: Escrituras en el banco 1 usan los slots 384-767 y el atributo CGB bit 3 los selecciona"""
+        mmu = renderer.mmu
+        mmu.set_renderer(renderer)
+        mmu.write_byte(IO_LCDC, 0x91)  # unsigned, mapa 0x9800
+        mmu.write_byte(IO_BGP, 0xE4)
+        renderer.render_frame()
+        
+        mmu.write_byte(0xFF4F, 0x01)  # VBK = 1
+        mmu.write_byte(0x8000, 0xFF)  # Tile 0 del banco 1, fila 0 en color 3
+        mmu.write_byte(0x8001, 0xFF)
+        mmu.write_byte(0x9800, 0x08)  # Atributo del tile (0,0): banco 1
+        mmu.write_byte(0xFF4F, 0x00)
+        assert renderer.tile_dirty[384] and not renderer.tile_dirty[0]
+        
+        renderer.render_frame()
+        assert tuple(renderer.buffer.get_at((0, 0)))[:3] == (0, 0, 0)
+        # El tile (1,0) usa el tile 0 del banco 0 (vacío)
+        assert tuple(renderer.buffer.get_at((8, 0)))[:3] == (255, 255, 255)
@@ -0,0 +1,91 @@
+"""
+Tests para los presentadores de frames (src/gpu/presenter.py).
+
+El presentador por textura debe mostrar el mismo frame escalado que el
+presentador por software, reutilizando una única textura SDL2 para toda la
+vida de la ventana, y volver a "surface" si pygame._sdl2 no está disponible.
+"""
+
+from __future__ import annotations
+
+import builtins
+
+import pytest
+
+pygame = pytest.importorskip("pygame")
+
+from src.gpu.renderer import Renderer
+from src.memory.mmu import MMU, IO_BGP, IO_LCDC
+
+
+@pytest.fixture
+def renderer(monkeypatch: pytest.MonkeyPatch) -> Renderer:
+    """Renderer (scale=2) sin pantalla de carga, registrado en su MMU."""
+    monkeypatch.setattr(Renderer, "_show_loading_screen", lambda self, duration=0: None)
+    mmu = MMU()
+    renderer = Renderer(mmu, scale=2)
+    mmu.set_renderer(renderer)
+    yield renderer
+    renderer.quit()
+
+
+def _draw_black_tile(mmu: MMU) -> None:
+    """Tile 1 completamente negro en la esquina superior izquierda del fondo."""
+    for addr in range(0x8010, 0x8020):
+        mmu.write_byte(addr, 0xFF)
+    mmu.write_byte(0x9800, 0x01)
+    mmu.write_byte(IO_BGP, 0xE4)
+    mmu.write_byte(IO_LCDC, 0x91)
+
+
+class TestPresenter:
+    """Tests de selección y salida de los presentadores"""
+
+    def test_texture_presents_scaled_frame(self, renderer: Renderer) -> None:
+        """Test: La textura escala el framebuffer a la ventana"""
+        if renderer.set_presenter("texture") != "texture":
+            pytest.skip("pygame._sdl2 no disponible")
+        _draw_black_tile(renderer.mmu)
+        renderer.render_frame()
+
+        output = renderer._presenter.renderer.to_surface()
+        assert output.get_size() == (320, 288)
+        # El tile de 8x8 ocupa 16x16 píxeles en la ventana
+        assert output.get_at((0, 0))[:3] == (0, 0, 0)
+        assert output.get_at((15, 15))[:3] == (0, 0, 0)
+        assert output.get_at((16, 16))[:3] == (255, 255, 255)
+
+    def test_texture_is_reused(self, renderer: Renderer) -> None:
+        """Test: Se usa la misma textura en todos los frames"""
+        if renderer.set_presenter("texture") != "texture":
+            pytest.skip("pygame._sdl2 no disponible")
+        texture = renderer._presenter.texture
+        for _ in range(3):
+            renderer.render_frame()
+        assert renderer._presenter.texture is texture
+
+    def test_fallback_without_sdl2(self, renderer: Renderer, monkeypatch: pytest.MonkeyPatch) -> None:
+        """Test: Sin pygame._sdl2 se mantiene la presentación por software"""
+        real_import = builtins.__import__
+
+        def fake_import(name, *args, **kwargs):
+            if name.startswith("pygame._sdl2"):
+                raise ImportError(name)
+            return real_import(name, *args, **kwargs)
+
+        monkeypatch.setattr(builtins, "__import__", fake_import)
+        assert renderer.set_presenter("texture") == "surface"
+        assert renderer.get_presenter() == "surface"
+        renderer.render_frame()
+        with pytest.raises(ValueError):
+            renderer.set_presenter("opengl")
+
+    def test_switch_back_to_surface(self, renderer: Renderer) -> None:
+        """Test: Volver a "surface" recrea la ventana del módulo display"""
+        renderer.set_presenter("texture")
+        assert renderer.set_presenter("surface") == "surface"
+        assert renderer.screen is pygame.display.get_surface()
+        _draw_black_tile(renderer.mmu)
+        renderer.render_frame()
+        assert renderer.screen.get_at((0, 0))[:3] == (0, 0, 0)
+        assert renderer.screen.get_at((16, 16))[:3] == (255, 255, 255)
@@ -11,7 +11,7 @@ from __future__ import annotations
 
 import pytest
 from src.memory.mmu import MMU, IO_DMA, IO_LCDC, IO_OBP0, IO_OBP1
-from src.gpu.renderer import Renderer, VRAM_START, BYTES_PER_TILE
+from src.gpu.renderer import Renderer, VRAM_START, BYTES_PER_TILE, PALETTE_GREYSCALE
 from src.memory.cartridge import Cartridge
 
 
@@ -204,3 +204,70 @@ class TestSpriteRendering:
         
         renderer.quit()
 
+
+
+def _reference_sprite_pixel(mmu: MMU, tile_id: int, row: int, col: int) -> int:
+    """Decodifica un píxel de tile directamente desde VRAM (referencia sin caché)."""
+    addr = VRAM_START + tile_id * BYTES_PER_TILE + row * 2
+    bit = 7 - col
+    low = (mmu.read_byte(addr) >> bit) & 0x01
+    high = (mmu.read_byte(addr + 1) >> bit) & 0x01
+    return (high << 1) | low
+
+
+class TestSpriteTileCache:
+    """Tests para la caché de tiles de sprites (variantes de flip y 8x16)."""
+    
+    @pytest.fixture
+    def renderer(self, monkeypatch: pytest.MonkeyPatch) -> Renderer:
+        """Renderer sin pantalla de carga, con dos tiles asimétricos (IDs 2 y 3)."""
+        monkeypatch.setattr(Renderer, "_show_loading_screen", lambda self, duration=0: None)
+        mmu = MMU()
+        for i in range(2 * BYTES_PER_TILE):
+            mmu.write_byte(VRAM_START + 2 * BYTES_PER_TILE + i, (i * 37 + 11) & 0xFF)
+        mmu.write_byte(IO_OBP0, 0xE4)
+        renderer = Renderer(mmu, scale=1)
+        mmu.set_renderer(renderer)
+        yield renderer
+        renderer.quit()
+    
+    def _draw(self, renderer: Renderer, lcdc: int, tile_id: int, attributes: int) -> None:
+        mmu = renderer.mmu
+        mmu.write_byte(IO_LCDC, lcdc)
+        mmu.write_byte(0xFE00, 40 + 16)
+        mmu.write_byte(0xFE01, 30 + 8)
+        mmu.write_byte(0xFE02, tile_id)
+        mmu.write_byte(0xFE03, attributes)
+        renderer.buffer.fill((1, 2, 3))
+        assert renderer.render_sprites() == 1
+    
+    @pytest.mark.parametrize("attributes", [0x00, 0x20, 0x40, 0x60])
+    @pytest.mark.parametrize("tall", [False, True])
+    def test_flip_variants_match_reference(self, renderer: Renderer, attributes: int, tall: bool) -> None:
+        """Los píxeles compuestos coinciden con una decodificación directa, con transparencia."""
+        height = 16 if tall else 8
+        self._draw(renderer, 0x86 if tall else 0x82, 0x03 if tall else 0x02, attributes)
+        x_flip = bool(attributes & 0x20)
+        y_flip = bool(attributes & 0x40)
+        for y in range(height):
+            for x in range(8):
+                src_y = height - 1 - y if y_flip else y
+                src_x = 7 - x if x_flip else x
+                # En 8x16 el bit 0 del Tile ID se ignora (tile 2 arriba, 3 abajo)
+                color = _reference_sprite_pixel(renderer.mmu, 2 + src_y // 8, src_y % 8, src_x)
+                pixel = tuple(renderer.buffer.get_at((30 + x, 40 + y)))[:3]
+                if color == 0:
+                    assert pixel == (1, 2, 3)
+                else:
+                    assert pixel == PALETTE_GREYSCALE[color]
+    
+    def test_vram_write_invalidates_cache(self, renderer: Renderer) -> None:
+        """Escribir en VRAM invalida las variantes cacheadas del tile."""
+        self._draw(renderer, 0x82, 0x02, 0x00)
+        assert renderer.sprite_tile_cache[2] is not None
+        # Fila 0 del tile 2 a color 3
+        renderer.mmu.write_byte(VRAM_START + 2 * BYTES_PER_TILE, 0xFF)
+        renderer.mmu.write_byte(VRAM_START + 2 * BYTES_PER_TILE + 1, 0xFF)
+        assert renderer.sprite_tile_cache[2] is None
+        self._draw(renderer, 0x82, 0x02, 0x00)
+        assert tuple(renderer.buffer.get_at((30, 40)))[:3] == PALETTE_GREYSCALE[3]
@@ -0,0 +1,147 @@
+"""
+Tests para la pantalla en terminal (src/gpu/terminal.py).
+
+Valida la codificación con semibloques, la codificación delta (solo celdas
+cambiadas, agrupadas por tramos) y el hilo de dibujo.
+"""
+
+from __future__ import annotations
+
+import io
+import re
+import threading
+
+import pytest
+
+import src.viboy as viboy_module
+from src.gpu.terminal import (
+    SHOW_CURSOR,
+    UPPER_HALF_BLOCK,
+    TerminalDisplay,
+    TerminalFrameEncoder,
+)
+from src.viboy import Viboy
+
+WHITE = bytes((255, 255, 255))
+BLACK = bytes((0, 0, 0))
+CURSOR_MOVE = re.compile(r"\x1b\[(\d+);(\d+)H")
+
+
+def _frame(color: bytes = WHITE) -> bytearray:
+    return bytearray(color * (160 * 144))
+
+
+def _set_pixel(frame: bytearray, x: int, y: int, color: bytes) -> None:
+    i = (y * 160 + x) * 3
+    frame[i:i + 3] = color
+
+
+class TestTerminalFrameEncoder:
+    """Tests del codificador ANSI"""
+
+    def test_full_frame_then_no_changes(self) -> None:
+        """Test: El primer frame dibuja 160x72 celdas; uno idéntico no emite nada"""
+        encoder = TerminalFrameEncoder()
+        frame = bytes(_frame())
+        output = encoder.encode(frame)
+        assert output.count(UPPER_HALF_BLOCK) == 160 * 72
+        # Un color sólido: un solo SGR y un movimiento de cursor por fila
+        assert output.count("38;2;255;255;255") == 1
+        assert len(CURSOR_MOVE.findall(output)) == 72
+        assert encoder.encode(frame) == ""
+
+    def test_delta_single_pixel(self) -> None:
+        """Test: Cambiar un píxel redibuja solo su celda, en su posición"""
+        encoder = TerminalFrameEncoder(origin=(1, 1))
+        frame = _frame()
+        encoder.encode(bytes(frame))
+        _set_pixel(frame, 10, 21, BLACK)  # Fila inferior de la celda (10, 10)
+        output = encoder.encode(bytes(frame))
+        assert output.count(UPPER_HALF_BLOCK) == 1
+        assert CURSOR_MOVE.findall(output) == [("11", "11")]
+        # Solo cambia el fondo (píxel inferior)
+        assert "48;2;0;0;0" in output and "38;2;" not in output
+
+    def test_runs_share_cursor_move(self) -> None:
+        """Test: Celdas cambiadas consecutivas comparten movimiento de cursor"""
+        encoder = TerminalFrameEncoder()
+        frame = _frame()
+        encoder.encode(bytes(frame))
+        # Un sprite de 8x8 que aparece: 4 filas de celdas x 8 columnas
+        for y in range(40, 48):
+            for x in range(50, 58):
+                _set_pixel(frame, x, y, BLACK)
+        output = encoder.encode(bytes(frame))
+        assert output.count(UPPER_HALF_BLOCK) == 32
+        assert len(CURSOR_MOVE.findall(output)) == 4
+        assert len(output.encode("utf-8")) < 512
+
+    def test_reset_redraws(self) -> None:
+        """Test: reset() fuerza un redibujado completo"""
+        encoder = TerminalFrameEncoder()
+        frame = bytes(_frame(BLACK))
+        encoder.encode(frame)
+        encoder.reset()
+        assert encoder.encode(frame).count(UPPER_HALF_BLOCK) == 160 * 72
+
+
+class TestTerminalDisplay:
+    """Tests del hilo de dibujo"""
+
+    def test_submit_and_close(self) -> None:
+        """Test: Se dibuja lo entregado y se restaura la terminal al cerrar"""
+        stream = io.StringIO()
+        display = TerminalDisplay(stream, fps=1000, alternate_screen=False)
+        assert display.wants_frame()
+        display.submit(bytes(_frame()))
+        display.close()
+        output = stream.getvalue()
+        assert output.count(UPPER_HALF_BLOCK) == 160 * 72
+        assert SHOW_CURSOR in output
+        assert display.frames_drawn == 1
+        assert display.bytes_written == len(output.encode("utf-8"))
+        with pytest.raises(ValueError):
+            TerminalDisplay(stream, fps=0)
+
+    def test_close_draws_frame_submitted_during_draw(self) -> None:
+        """Test: Un frame entregado mientras se dibuja otro se dibuja antes de cerrar"""
+        display = TerminalDisplay(io.StringIO(), fps=1000, alternate_screen=False)
+        drawing = threading.Event()
+        release = threading.Event()
+        drawn: list[bytes] = []
+
+        def blocking_draw(frame: bytes) -> None:
+            drawing.set()
+            release.wait(5)
+            drawn.append(frame)
+
+        display._draw = blocking_draw  # type: ignore[method-assign]
+        display.submit(b"first")
+        assert drawing.wait(5)
+        display.submit(b"last")
+        closer = threading.Thread(target=display.close)
+        closer.start()
+        release.set()
+        closer.join(5)
+        assert not closer.is_alive()
+        assert drawn == [b"first", b"last"]
+
+    def test_refresh_decoupled(self) -> None:
+        """Test: Tras entregar un frame, no se piden más hasta el siguiente intervalo"""
+        display = TerminalDisplay(io.StringIO(), fps=0.5, alternate_screen=False)
+        try:
+            display.submit(bytes(_frame()))
+            assert not display.wants_frame()
+        finally:
+            display.close()
+
+    def test_viboy_headless(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        """Test: Sin renderer, Viboy entrega frames compuestos con NumPy"""
+        pytest.importorskip("numpy")
+        monkeypatch.setattr(viboy_module, "Renderer", None)
+        viboy = Viboy()
+        stream = io.StringIO()
+        viboy.enable_terminal_display(fps=1000, stream=stream)
+        viboy._terminal_display.submit(viboy._capture_frame())
+        viboy.disable_terminal_display()
+        assert stream.getvalue().count(UPPER_HALF_BLOCK) == 160 * 72
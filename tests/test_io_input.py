@@ -0,0 +1,134 @@
+"""
+Tests para el subsistema de entrada (teclado y mandos -> Joypad).
+
+Usan eventos sintéticos de pygame: no necesitan ventana ni mando conectado.
+"""
+
+import json
+import time
+
+import pytest
+
+pygame = pytest.importorskip("pygame")
+
+from src.io.input import InputBindings, InputManager, PACKED_BITS
+from src.io.joypad import Joypad
+from src.memory.mmu import MMU, IO_IF
+
+
+def key(etype: int, k: int) -> "pygame.event.Event":
+    return pygame.event.Event(etype, key=k)
+
+
+def pad_button(etype: int, button: int, instance_id: int = 0) -> "pygame.event.Event":
+    return pygame.event.Event(etype, button=button, instance_id=instance_id)
+
+
+def axis(axis_id: int, value: int, instance_id: int = 0) -> "pygame.event.Event":
+    return pygame.event.Event(pygame.CONTROLLERAXISMOTION, axis=axis_id, value=value,
+                              instance_id=instance_id)
+
+
+class TestInput:
+    """Tests de la tabla de asignaciones y la máscara empaquetada"""
+
+    def test_keyboard_packed_mask(self) -> None:
+        """Test: Las teclas por defecto se empaquetan y llegan al Joypad"""
+        joypad = Joypad(None)
+        manager = InputManager(joypad)
+        manager.process([key(pygame.KEYDOWN, pygame.K_z), key(pygame.KEYDOWN, pygame.K_UP),
+                         key(pygame.KEYDOWN, pygame.K_q)])
+        assert manager.mask == PACKED_BITS["a"] | PACKED_BITS["up"]
+        assert joypad.get_masks() == (0x04, 0x01)
+
+        manager.process([key(pygame.KEYUP, pygame.K_UP)])
+        assert joypad.get_masks() == (0x00, 0x01)
+
+    def test_two_keys_same_button(self) -> None:
+        """Test: Soltar una tecla no suelta el botón si otra asignada sigue pulsada"""
+        joypad = Joypad(None)
+        manager = InputManager(joypad)
+        manager.process([key(pygame.KEYDOWN, pygame.K_z), key(pygame.KEYDOWN, pygame.K_a)])
+        manager.process([key(pygame.KEYUP, pygame.K_z)])
+        assert joypad.get_state("a") is True
+        manager.process([key(pygame.KEYUP, pygame.K_a)])
+        assert joypad.get_state("a") is False
+
+    def test_controller_buttons_and_deadzone(self) -> None:
+        """Test: Botones de mando y stick izquierdo con zona muerta"""
+        joypad = Joypad(None)
+        manager = InputManager(joypad, InputBindings(deadzone=10000))
+        manager.process([pad_button(pygame.CONTROLLERBUTTONDOWN, pygame.CONTROLLER_BUTTON_START)])
+        assert joypad.get_state("start") is True
+
+        # Dentro de la zona muerta no hay dirección
+        manager.process([axis(pygame.CONTROLLER_AXIS_LEFTX, -9000)])
+        assert joypad.get_state("left") is False
+        manager.process([axis(pygame.CONTROLLER_AXIS_LEFTX, -20000),
+                         axis(pygame.CONTROLLER_AXIS_LEFTY, 32767)])
+        assert joypad.get_masks() == (PACKED_BITS["left"] | PACKED_BITS["down"], 0x08)
+
+        # Volver al centro suelta las direcciones; desconectar el mando suelta todo
+        manager.process([axis(pygame.CONTROLLER_AXIS_LEFTX, 0)])
+        assert joypad.get_state("left") is False
+        manager.process([pygame.event.Event(pygame.CONTROLLERDEVICEREMOVED, instance_id=0)])
+        assert joypad.get_masks() == (0, 0)
+
+    def test_bindings_from_config(self, tmp_path) -> None:
+        """Test: La configuración sustituye las teclas del botón indicado"""
+        config = tmp_path / "input.json"
+        config.write_text(json.dumps({"keyboard": {"a": ["k"]}, "deadzone": 12000}))
+        bindings = InputBindings.load(config)
+        assert bindings.deadzone == 12000
+        assert bindings.keys[pygame.K_k] == PACKED_BITS["a"]
+        assert pygame.K_z not in bindings.keys
+        # Los demás botones conservan sus teclas por defecto
+        assert bindings.keys[pygame.K_x] == PACKED_BITS["b"]
+
+        with pytest.raises(ValueError):
+            InputBindings(keyboard={"turbo": ["t"]})
+        with pytest.raises(ValueError):
+            InputBindings(keyboard={"a": ["no_such_key"]})
+
+    def test_single_update_and_interrupt(self) -> None:
+        """Test: Una tanda de eventos produce una sola actualización y una interrupción"""
+        mmu = MMU(None)
+        joypad = Joypad(mmu)
+        calls = []
+        original = joypad.set_masks
+        joypad.set_masks = lambda d, b: (calls.append((d, b)), original(d, b))  # type: ignore[method-assign]
+        manager = InputManager(joypad)
+        mmu.write_byte(IO_IF, 0x00)
+        manager.process([key(pygame.KEYDOWN, pygame.K_RETURN), key(pygame.KEYDOWN, pygame.K_RIGHT),
+                         pygame.event.Event(pygame.MOUSEMOTION, pos=(0, 0), rel=(0, 0), buttons=(0, 0, 0))])
+        assert calls == [(0x01, 0x08)]
+        assert (mmu.read_byte(IO_IF) & 0x10) != 0
+
+        # Sin cambios: no se vuelve a tocar el Joypad
+        manager.process([key(pygame.KEYDOWN, pygame.K_q)])
+        assert len(calls) == 1
+
+    def test_poll_cost(self) -> None:
+        """Test: Procesar los eventos de un frame cuesta microsegundos"""
+        manager = InputManager(Joypad(None))
+        events = [key(pygame.KEYDOWN, pygame.K_z), key(pygame.KEYUP, pygame.K_z)]
+        start = time.perf_counter()
+        for _ in range(1000):
+            manager.process(events)
+        per_poll = (time.perf_counter() - start) / 1000
+        assert per_poll < 100e-6, f"Sondeo demasiado lento: {per_poll * 1e6:.1f} µs"
+
+    def test_viboy_event_loop(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        """Test: El bucle de eventos de Viboy entrega las teclas al Joypad"""
+        from src.gpu.renderer import Renderer
+        from src.viboy import Viboy
+        monkeypatch.setattr(Renderer, "_show_loading_screen", lambda self, duration=0: None)
+        viboy = Viboy()
+        if viboy.get_renderer() is None:
+            pytest.skip("Renderer no disponible")
+        viboy.set_input_bindings(InputBindings(keyboard={"start": ["p"]}))
+        pygame.event.clear()
+        pygame.event.post(key(pygame.KEYDOWN, pygame.K_p))
+        assert viboy._handle_pygame_events() is True
+        assert viboy._joypad is not None and viboy._joypad.get_state("start") is True
+        viboy.get_renderer().quit()
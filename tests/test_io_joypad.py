@@ -247,3 +247,51 @@ class TestJoypad:
         # Todos los bits 0-3 deben ser 0 (todos pulsados)
         assert (value & 0x0F) == 0x00, "Todos los botones pulsados deben tener bits 0-3 = 0"
 
+    
+    def test_joypad_masks_and_precomputed_p1(self) -> None:
+        """Test: El estado son dos máscaras de 4 bits y P1 se recalcula al cambiar"""
+        joypad = Joypad(None)
+        joypad.press("left")
+        joypad.press("start")
+        assert joypad.get_masks() == (0x02, 0x08)
+        
+        # Ningún grupo seleccionado: P1 no refleja nada
+        joypad.write(0x30)
+        assert joypad.read() == 0xFF
+        
+        # Ambos grupos seleccionados: las pulsaciones se combinan
+        joypad.write(0x00)
+        assert joypad.read() == 0xF5
+        
+        # El valor ya está calculado: leer no cambia nada
+        assert joypad.read() == joypad.read() == joypad._p1
+        
+        joypad.release("left")
+        assert joypad.read() == 0xF7
+    
+    def test_joypad_set_masks_interrupt(self) -> None:
+        """Test: set_masks solo pide interrupción si algún botón pasa a pulsado"""
+        mmu = MMU(None)
+        joypad = Joypad(mmu)
+        mmu.write_byte(IO_IF, 0x00)
+        
+        joypad.set_masks(0x00, 0x01)
+        assert (mmu.read_byte(IO_IF) & 0x10) != 0
+        
+        # Soltar o mantener no genera interrupción
+        mmu.write_byte(IO_IF, 0x00)
+        joypad.set_masks(0x00, 0x01)
+        joypad.set_masks(0x00, 0x00)
+        assert (mmu.read_byte(IO_IF) & 0x10) == 0
+        
+        # Los bits por encima de 3 se ignoran
+        joypad.set_masks(0xF0, 0xF0)
+        assert joypad.get_masks() == (0, 0)
+    
+    def test_joypad_unknown_button(self) -> None:
+        """Test: Un botón desconocido se ignora"""
+        joypad = Joypad(None)
+        joypad.press("turbo")
+        joypad.release("turbo")
+        assert joypad.get_masks() == (0, 0)
+        assert joypad.get_state("turbo") is False
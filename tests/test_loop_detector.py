@@ -0,0 +1,94 @@
+"""
+Tests para la detección incremental de bucles de las herramientas de diagnóstico.
+
+Valida que LoopDetector (tools/doctor_viboy.py) y LoopTracker (tools/debug_trace.py)
+mantienen sus contadores de forma incremental y dan los mismos resultados que
+el recuento directo sobre la ventana.
+"""
+
+import random
+from collections import deque
+
+from tools.debug_trace import LoopTracker
+from tools.doctor_viboy import LoopDetector
+
+
+class TestLoopDetector:
+    """Tests del detector de bucles de Doctor Viboy"""
+
+    def test_window_counts_match_naive_count(self) -> None:
+        """Test: Los contadores incrementales coinciden con contar en la ventana"""
+        rng = random.Random(1234)
+        detector = LoopDetector(window_size=100, confidence_threshold=10**9)
+        window: deque[int] = deque(maxlen=100)
+        for _ in range(5000):
+            pc = 0x0100 + rng.randrange(40)
+            detector.add_pc(pc)
+            window.append(pc)
+            assert detector.get_window_count(pc) == window.count(pc)
+        assert detector.get_loop_range() == (min(window), max(window))
+        assert sum(detector._window_counts.values()) == len(window)
+
+    def test_detects_tight_loop(self) -> None:
+        """Test: Un bucle de una instrucción (JR -2) se reporta al alcanzar el umbral"""
+        detector = LoopDetector(window_size=100, confidence_threshold=50)
+        for _ in range(20):
+            assert not detector.add_pc(0x0100)
+            assert not detector.add_pc(0x0101)
+        detected_at = None
+        for i in range(1000):
+            if detector.add_pc(0x0150):
+                detected_at = i
+                break
+        # 10 apariciones para entrar en la ventana de confianza + 49 iteraciones más
+        assert detected_at == 58
+        assert detector.get_loop_range() == (0x0100, 0x0150)
+
+    def test_rolling_hash_finds_period(self) -> None:
+        """Test: El hash rodante identifica el periodo del patrón repetido"""
+        detector = LoopDetector(window_size=100, confidence_threshold=10**9, pattern_length=8)
+        loop = [0x0200 + 2 * n for n in range(7)]
+        for i in range(200):
+            detector.add_pc(loop[i % len(loop)])
+        assert detector.loop_period == len(loop)
+        assert sorted(detector.get_loop_pattern()) == loop
+        assert detector.period_repeats > 100
+
+    def test_no_period_for_non_repeating_sequence(self) -> None:
+        """Test: Una secuencia sin repetición no produce periodo"""
+        detector = LoopDetector(window_size=100, confidence_threshold=10**9, pattern_length=8)
+        for pc in range(0x1000, 0x1400):
+            detector.add_pc(pc)
+        assert detector.loop_period is None
+        assert detector.get_loop_pattern() == []
+        # El historial de hashes está acotado por la ventana
+        assert len(detector._hash_last_seen) <= 100
+
+
+class TestLoopTracker:
+    """Tests del detector de bucles de debug_trace"""
+
+    def test_detects_repeated_pattern(self) -> None:
+        """Test: Un patrón de 4 PCs repetido se detecta con su secuencia"""
+        tracker = LoopTracker(history_size=20, threshold=5)
+        loop = [0x0300, 0x0301, 0x0303, 0x0306]
+        result = (False, None)
+        for i in range(12):
+            result = tracker.add_pc(loop[i % 4])
+        has_loop, pattern = result
+        assert has_loop
+        assert sorted(pattern) == loop
+
+    def test_linear_code_is_not_a_loop(self) -> None:
+        """Test: Código lineal nunca se reporta como bucle"""
+        tracker = LoopTracker(history_size=20, threshold=5)
+        for pc in range(0x0100, 0x0200):
+            has_loop, _ = tracker.add_pc(pc)
+            assert not has_loop
+
+    def test_few_unique_pcs_is_a_loop(self) -> None:
+        """Test: Pocos PCs únicos en las últimas 10 instrucciones indican bucle"""
+        tracker = LoopTracker(history_size=20, threshold=5)
+        sequence = [0x0400, 0x0402, 0x0400, 0x0400, 0x0404] * 4
+        detected = [tracker.add_pc(pc)[0] for pc in sequence]
+        assert detected[-1]
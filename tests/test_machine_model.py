@@ -0,0 +1,96 @@
+"""
+Tests del modelo de máquina (DMG/CGB) elegido desde la cabecera del cartucho.
+
+Valida el flag CGB (0x0143), la MMU especializada para DMG y el Post-Boot
+State de cada modelo.
+"""
+
+from collections.abc import Callable
+from pathlib import Path
+
+import pytest
+
+from src.memory.cartridge import MODEL_CGB, MODEL_DMG, Cartridge
+from src.memory.mmu import (
+    IO_BGP, IO_DMA, IO_LCDC, IO_LY, IO_SCX, IO_STAT, IO_VBK, DMGMMU, MMU, create_mmu,
+)
+from src.viboy import Viboy
+
+
+class TestMachineModel:
+    """Tests de selección de modelo y especialización DMG"""
+
+    @pytest.mark.parametrize("flag,model", [(0x00, MODEL_DMG), (0x80, MODEL_CGB), (0xC0, MODEL_CGB)])
+    def test_cartridge_model_from_header(self, make_rom: Callable[..., Path], flag: int,
+                                         model: str) -> None:
+        """Test: El bit 7 de 0x0143 decide el modelo"""
+        assert Cartridge(make_rom(cgb_flag=flag)).get_model() == model
+
+    def test_post_boot_state_per_model(self, make_rom: Callable[..., Path], headless: None) -> None:
+        """Test: Un cartucho DMG arranca con A=0x01 y DMGMMU; uno CGB con A=0x11"""
+        dmg = Viboy(make_rom(b"DMGGAME"))
+        regs = dmg.get_cpu().registers
+        assert dmg.get_model() == MODEL_DMG
+        assert type(dmg.get_mmu()) is DMGMMU
+        assert (regs.get_a(), regs.get_f(), regs.get_bc(), regs.get_de(), regs.get_hl()) == (
+            0x01, 0xB0, 0x0013, 0x00D8, 0x014D)
+
+        cgb = Viboy(make_rom(b"CGBGAME", cgb_flag=0x80))
+        regs = cgb.get_cpu().registers
+        assert cgb.get_model() == MODEL_CGB
+        assert type(cgb.get_mmu()) is MMU
+        assert (regs.get_a(), regs.get_f(), regs.get_bc(), regs.get_de(), regs.get_hl()) == (
+            0x11, 0x80, 0x0000, 0xFF56, 0x000D)
+
+        # El modelo se puede forzar
+        forced = Viboy(make_rom(b"CGBGAME", cgb_flag=0x80), model=MODEL_DMG)
+        assert forced.get_cpu().registers.get_a() == 0x01
+
+    def test_dmg_mmu_matches_mmu(self) -> None:
+        """Test: DMGMMU se comporta igual que MMU fuera de los registros CGB"""
+        mmus = [MMU(None), DMGMMU(None)]
+        for mmu in mmus:
+            mmu.write_byte(0x8010, 0x3C)      # VRAM
+            mmu.write_byte(0xC123, 0x42)      # WRAM
+            mmu.write_byte(0xFF90, 0x99)      # HRAM
+            mmu.write_byte(0xFFFF, 0x1F)      # IE
+            mmu.write_byte(IO_LY, 0x55)       # Solo lectura
+            mmu.write_byte(IO_STAT, 0xFF)     # Bits 0-2 de solo lectura
+            mmu.write_byte(IO_BGP, 0x00)      # Forzado a 0xE4
+            mmu.write_byte(IO_SCX, 0x07)
+            for i in range(160):
+                mmu.write_byte(0xC000 + i, i)
+            mmu.write_byte(IO_DMA, 0xC0)      # DMA desde 0xC000
+        addresses = [0x8010, 0xC123, 0xFF90, 0xFFFF, IO_LY, IO_STAT, IO_BGP, IO_SCX, IO_DMA,
+                     0xFE00, 0xFE9F, 0xE000]
+        reference, dmg = mmus
+        for addr in addresses:
+            assert dmg.read_byte(addr) == reference.read_byte(addr), f"0x{addr:04X}"
+        assert bytes(dmg.get_oam_view()) == bytes(range(160))
+
+    def test_dmg_mmu_ignores_vram_banking(self) -> None:
+        """Test: En DMG, VBK es un registro sin efecto y la VRAM es siempre el banco 0"""
+        mmu = create_mmu(None, MODEL_DMG)
+        mmu.write_byte(IO_VBK, 0x01)
+        mmu.write_byte(0x8000, 0xAB)
+        assert mmu.get_vram_view(0)[0] == 0xAB
+        assert mmu.get_vram_view(1)[0] == 0x00
+
+        with pytest.raises(ValueError):
+            create_mmu(None, "sgb")
+
+    def test_dmg_renderer_skips_attributes(self) -> None:
+        """Test: El compositor da el mismo frame en DMG sin consultar atributos CGB"""
+        np = pytest.importorskip("numpy")
+        from src.gpu.numpy_compositor import NumpyCompositor
+
+        frames = []
+        for mmu in (MMU(None), DMGMMU(None)):
+            mmu.write_byte(IO_LCDC, 0x91)
+            for i in range(16):
+                mmu.write_byte(0x8010 + i, 0xF0 if i % 2 else 0x0F)
+            for i in range(0x400):
+                mmu.write_byte(0x9800 + i, 1 if i % 3 == 0 else 0)
+            compositor = NumpyCompositor(mmu)
+            frames.append(compositor.compose().copy())
+        assert np.array_equal(frames[0], frames[1])
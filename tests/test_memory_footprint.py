@@ -0,0 +1,49 @@
+"""
+Tests de la memoria por instancia del emulador (muchas instancias en un proceso).
+"""
+
+import gc
+import mmap
+import tracemalloc
+from collections.abc import Callable
+from pathlib import Path
+
+from src.viboy import Viboy
+
+# Presupuesto por instancia, sin contar la ROM (mapeada y compartida)
+INSTANCE_BUDGET_BYTES = 200 * 1024
+
+
+class TestMemoryFootprint:
+    """Tests del presupuesto de memoria por instancia"""
+
+    def test_instance_fits_budget(self, make_rom: Callable[..., Path]) -> None:
+        """Test: Cada instancia headless ocupa menos de 200 KiB (tracemalloc)"""
+        rom_path = make_rom(b"FOOTPRNT", mbc=0x01, banks=4)
+        Viboy(rom_path, headless=True)  # Imports y tablas compartidas fuera de la medida
+        gc.collect()
+
+        count = 8
+        tracemalloc.start()
+        try:
+            before = tracemalloc.get_traced_memory()[0]
+            instances = [Viboy(rom_path, headless=True) for _ in range(count)]
+            gc.collect()
+            per_instance = (tracemalloc.get_traced_memory()[0] - before) / count
+        finally:
+            tracemalloc.stop()
+
+        assert len(instances) == count
+        assert per_instance < INSTANCE_BUDGET_BYTES, f"{per_instance / 1024:.1f} KiB por instancia"
+
+    def test_shared_tables_and_lazy_components(self, make_rom: Callable[..., Path]) -> None:
+        """Test: Tablas de despacho compartidas, ROM mapeada y sin Renderer ni reloj"""
+        rom_path = make_rom(b"FOOTPRNT", mbc=0x01, banks=4)
+        first = Viboy(rom_path, headless=True)
+        second = Viboy(rom_path, headless=True)
+
+        assert first.get_cpu()._opcode_table is second.get_cpu()._opcode_table
+        assert first.get_cpu()._cb_opcode_table is second.get_cpu()._cb_opcode_table
+        assert isinstance(first.get_cartridge()._rom_data, mmap.mmap)
+        assert first.get_renderer() is None
+        assert first._clock is None
@@ -185,3 +185,28 @@ class TestMMU:
         result = mmu.read_word(0x1000)
         assert result == 0xABCD, f"Ejemplo de docs falló: esperado 0xABCD, obtenido 0x{result:04X}"
 
+
+    def test_direct_views_reflect_writes_and_are_read_only(self) -> None:
+        """Test: las vistas de VRAM/OAM/tilemaps reflejan escrituras y no admiten escritura"""
+        mmu = MMU()
+        vram0 = mmu.get_vram_view(0)
+        vram1 = mmu.get_vram_view(1)
+        oam = mmu.get_oam_view()
+        map_9c00 = mmu.get_tile_map_view(1)
+        assert (len(vram0), len(vram1), len(oam), len(map_9c00)) == (0x2000, 0x2000, 0xA0, 0x400)
+        
+        mmu.write_byte(0x8010, 0xAB)
+        mmu.write_byte(0x9C21, 0x42)
+        mmu.write_byte(0xFE9F, 0x7F)
+        # Banco 1 de VRAM (VBK = 1)
+        mmu.write_byte(0xFF4F, 0x01)
+        mmu.write_byte(0x8010, 0xCD)
+        mmu.write_byte(0xFF4F, 0x00)
+        
+        assert vram0[0x10] == 0xAB
+        assert vram1[0x10] == 0xCD
+        assert map_9c00[0x21] == 0x42
+        assert vram0[0x1C21] == 0x42
+        assert oam[0x9F] == 0x7F
+        with pytest.raises(TypeError):
+            vram0[0] = 0x00
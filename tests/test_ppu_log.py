@@ -0,0 +1,121 @@
+"""
+Tests para el registro de escrituras de la PPU (src/gpu/ppu_log.py) y el
+re-renderizado offline (tools/rerender_ppu_log.py).
+
+Los frames reconstruidos desde el registro deben ser idénticos a los que se
+habrían compuesto durante la emulación, también repartiendo el trabajo entre
+procesos y con un registro sin cerrar (sin índice).
+"""
+
+from __future__ import annotations
+
+import random
+from pathlib import Path
+
+import pytest
+
+np = pytest.importorskip("numpy")
+
+import src.viboy as viboy_module
+from src.gpu.numpy_compositor import NumpyCompositor
+from src.gpu.ppu_log import TRAILER_STRUCT, read_log_info
+from src.gpu.recorder import FRAME_SIZE
+from src.memory.mmu import IO_BGP, IO_DMA, IO_LCDC, IO_SCX, IO_SCY, IO_VBK
+from src.viboy import Viboy
+from tools.rerender_ppu_log import rerender
+
+
+@pytest.fixture
+def viboy(monkeypatch: pytest.MonkeyPatch) -> Viboy:
+    """Viboy sin renderer."""
+    monkeypatch.setattr(viboy_module, "Renderer", None)
+    return Viboy()
+
+
+def _emulate(viboy: Viboy, log_path: Path, frames: int, keyframe_interval: int) -> list[bytes]:
+    """Simula escrituras de un juego durante varios frames y devuelve los frames esperados."""
+    mmu = viboy.get_mmu()
+    rng = random.Random(1234)
+    compositor = NumpyCompositor(mmu)
+    # Estado previo al registro: debe llegar a través del primer keyframe
+    for addr in range(0x8000, 0x9C00):
+        mmu.write_byte(addr, rng.randrange(256))
+    mmu.write_byte(IO_LCDC, 0x93)
+
+    viboy.enable_ppu_log(log_path, keyframe_interval)
+    expected = []
+    for frame in range(frames):
+        for _ in range(200):
+            mmu.write_byte(rng.randrange(0x8000, 0x9C00), rng.randrange(256))
+        mmu.write_byte(IO_VBK, 1)
+        for _ in range(20):
+            mmu.write_byte(rng.randrange(0x9800, 0x9C00), 0x08 if rng.random() < 0.5 else 0)
+        mmu.write_byte(IO_VBK, 0)
+        mmu.write_byte(IO_SCX, frame * 3)
+        mmu.write_byte(IO_SCY, frame)
+        mmu.write_byte(IO_BGP, rng.choice((0xE4, 0x1B, 0xD2)))
+        # OAM por DMA desde WRAM y alguna escritura directa
+        for i in range(160):
+            mmu.write_byte(0xC000 + i, rng.randrange(256))
+        mmu.write_byte(IO_DMA, 0xC0)
+        mmu.write_byte(0xFE00, 40 + frame)
+        mmu.write_byte(0xFE01, 30 + frame)
+        viboy._ppu_log.end_frame()
+        expected.append(compositor.compose().tobytes())
+    viboy.disable_ppu_log()
+    return expected
+
+
+def _frames(video: Path) -> list[bytes]:
+    data = video.read_bytes()
+    return [data[i:i + FRAME_SIZE] for i in range(0, len(data), FRAME_SIZE)]
+
+
+class TestPPULog:
+    """Tests del registro y el re-renderizado"""
+
+    @pytest.mark.parametrize("jobs", [1, 3])
+    def test_rerender_matches(self, viboy: Viboy, tmp_path: Path, jobs: int) -> None:
+        """Test: Los frames re-renderizados coinciden con los de la emulación"""
+        log = tmp_path / "run.ppulog"
+        expected = _emulate(viboy, log, frames=7, keyframe_interval=3)
+
+        info = read_log_info(log)
+        assert info.frames == 7
+        assert [frame for frame, _ in info.keyframes] == [0, 3, 6]
+
+        video = tmp_path / "out.rgb"
+        assert rerender(log, video=video, jobs=jobs) == 7
+        assert _frames(video) == expected
+
+    def test_ppm_output(self, viboy: Viboy, tmp_path: Path) -> None:
+        """Test: Un PPM por frame, numerado por frame absoluto"""
+        log = tmp_path / "run.ppulog"
+        expected = _emulate(viboy, log, frames=4, keyframe_interval=2)
+        out = tmp_path / "frames"
+        rerender(log, out_dir=out, jobs=2)
+        images = sorted(out.iterdir())
+        assert [p.name for p in images] == [f"frame_{n:06d}.ppm" for n in range(4)]
+        assert images[3].read_bytes().endswith(expected[3])
+
+    def test_unclosed_log(self, viboy: Viboy, tmp_path: Path) -> None:
+        """Test: Sin índice (emulador interrumpido) se recorre el archivo"""
+        log = tmp_path / "run.ppulog"
+        _emulate(viboy, log, frames=5, keyframe_interval=2)
+        closed = read_log_info(log)
+
+        data = log.read_bytes()
+        index_size = len(data) - closed.data_end
+        # Quitar índice y trailer, y dejar un registro a medias al final
+        log.write_bytes(data[:-index_size] + b"\x00\x80")
+        assert index_size > TRAILER_STRUCT.size
+        info = read_log_info(log)
+        assert info.frames == closed.frames
+        assert info.keyframes == closed.keyframes
+
+    def test_mmu_hook(self, viboy: Viboy, tmp_path: Path) -> None:
+        """Test: El registro se conecta a la MMU y se desconecta al cerrarlo"""
+        viboy.enable_ppu_log(tmp_path / "run.ppulog")
+        assert viboy.get_mmu()._write_log is viboy._ppu_log
+        viboy.disable_ppu_log()
+        assert viboy.get_mmu()._write_log is None
@@ -0,0 +1,174 @@
+"""
+Tests de los parches IPS/UPS/BPS aplicados al cargar la ROM (src/memory/rom_patch.py).
+"""
+
+import mmap
+import zlib
+from pathlib import Path
+
+import pytest
+
+import src.viboy
+from src.memory.cartridge import Cartridge
+from src.memory.rom_patch import apply_patch
+from src.viboy import Viboy
+
+
+def make_rom() -> bytes:
+    """ROM de 32KB con título "ORIGINAL" y un patrón reconocible."""
+    rom = bytearray(32 * 1024)
+    rom[0x0134:0x013C] = b"ORIGINAL"
+    rom[0x0100:0x0104] = bytes([0x00, 0xC3, 0x50, 0x01])
+    for i in range(0x0200, 0x0300):
+        rom[i] = i & 0xFF
+    return bytes(rom)
+
+
+def number(value: int) -> bytes:
+    """Codifica un entero de longitud variable de UPS/BPS."""
+    out = bytearray()
+    while True:
+        low = value & 0x7F
+        value >>= 7
+        if value == 0:
+            out.append(0x80 | low)
+            return bytes(out)
+        out.append(low)
+        value -= 1
+
+
+def crc(data: bytes) -> bytes:
+    return zlib.crc32(data).to_bytes(4, "little")
+
+
+def with_footer(body: bytes, source: bytes, target: bytes) -> bytes:
+    body = body + crc(source) + crc(target)
+    return body + crc(body)
+
+
+def make_ups(source: bytes, target: bytes) -> bytes:
+    """Construye un parche UPS con un bloque XOR por cada tramo distinto."""
+    body = bytearray(b"UPS1") + number(len(source)) + number(len(target))
+    last = 0
+    i = 0
+    while i < len(target):
+        if (source[i] if i < len(source) else 0) == target[i]:
+            i += 1
+            continue
+        body += number(i - last)
+        while i < len(target) and (source[i] if i < len(source) else 0) != target[i]:
+            body.append((source[i] if i < len(source) else 0) ^ target[i])
+            i += 1
+        body.append(0)
+        i += 1
+        last = i
+    return with_footer(bytes(body), source, target)
+
+
+def write_rom(tmp_path: Path, data: bytes) -> Path:
+    path = tmp_path / "game.gb"
+    path.write_bytes(data)
+    return path
+
+
+class TestPatchFormats:
+    """Tests de cada formato"""
+
+    def test_ips_records_rle_and_truncation(self) -> None:
+        """Test: Registro normal, registro RLE y tamaño final tras EOF"""
+        rom = make_rom()
+        patch = (b"PATCH"
+                 + (0x0134).to_bytes(3, "big") + (8).to_bytes(2, "big") + b"PATCHED!"
+                 + (0x0200).to_bytes(3, "big") + b"\x00\x00" + (4).to_bytes(2, "big") + b"\xAA"
+                 + b"EOF" + (0x4000).to_bytes(3, "big"))
+        patched = apply_patch(bytearray(rom), patch)
+        assert patched[0x0134:0x013C] == b"PATCHED!"
+        assert patched[0x0200:0x0205] == b"\xAA\xAA\xAA\xAA\x04"
+        assert len(patched) == 0x4000
+
+    def test_ups_round_trip_and_crc_checks(self) -> None:
+        """Test: UPS aplica el XOR (también creciendo la ROM) y comprueba los tres CRC"""
+        rom = make_rom()
+        target = bytearray(rom)
+        target[0x0134:0x013C] = b"UPSPATCH"
+        target += b"\x12\x34" * 0x2000  # Destino más grande que el origen
+        patch = make_ups(rom, bytes(target))
+        assert apply_patch(bytearray(rom), patch) == target
+
+        other = bytearray(rom)
+        other[0x7000] = 0x01
+        with pytest.raises(ValueError, match="origen"):
+            apply_patch(other, patch)
+
+        damaged = bytearray(patch)
+        damaged[10] ^= 0xFF
+        with pytest.raises(ValueError, match="dañado"):
+            apply_patch(bytearray(rom), bytes(damaged))
+
+        with pytest.raises(ValueError, match="desconocido"):
+            apply_patch(bytearray(rom), b"NOTAPATCH")
+
+    def test_bps_actions(self) -> None:
+        """Test: SourceRead, TargetRead, SourceCopy y TargetCopy (solapado)"""
+        rom = make_rom()
+        size = len(rom)
+        expected = bytearray(rom)
+        expected[0x0134:0x013C] = b"BPSPATCH"
+        expected += rom[0x0100:0x0104]
+        expected += bytes([expected[-1]]) * 12  # Repetición del último byte
+
+        def action(kind: int, length: int) -> bytes:
+            return number(((length - 1) << 2) | kind)
+
+        body = (b"BPS1" + number(size) + number(len(expected)) + number(0)
+                + action(0, 0x0134)
+                + action(1, 8) + b"BPSPATCH"
+                + action(0, size - 0x013C)
+                + action(2, 4) + number(0x0100 << 1)
+                + action(3, 12) + number((size + 3) << 1))
+        patch = with_footer(body, rom, bytes(expected))
+        assert apply_patch(bytearray(rom), patch) == expected
+
+
+class TestCartridgePatches:
+    """Tests de la carga del cartucho con parches"""
+
+    def test_patches_applied_in_order_and_header_reparsed(self, tmp_path: Path,
+                                                          monkeypatch: pytest.MonkeyPatch) -> None:
+        """Test: IPS y luego UPS sobre el resultado; el archivo original no cambia"""
+        rom = make_rom()
+        rom_path = write_rom(tmp_path, rom)
+        ips = tmp_path / "first.ips"
+        ips.write_bytes(b"PATCH" + (0x0134).to_bytes(3, "big") + (8).to_bytes(2, "big")
+                        + b"FIRST   " + b"EOF")
+        after_ips = bytearray(rom)
+        after_ips[0x0134:0x013C] = b"FIRST   "
+        final = bytearray(after_ips)
+        final[0x0134:0x013C] = b"SECOND  "
+        final[0x0147] = 0x01
+        ups = tmp_path / "second.ups"
+        ups.write_bytes(make_ups(bytes(after_ips), bytes(final)))
+
+        monkeypatch.setattr(src.viboy, "Renderer", None)
+        viboy = Viboy(rom_path, patches=[ips, ups])
+        info = viboy.get_cartridge().get_header_info()
+        assert info["title"] == "SECOND"
+        assert info["cartridge_type"] == "0x01"
+        assert viboy.get_mmu().read_byte(0x0134) == ord("S")
+        assert rom_path.read_bytes() == rom
+
+        # En el orden inverso el UPS no corresponde a la ROM
+        with pytest.raises(ValueError, match="second.ups"):
+            Cartridge(rom_path, [ups, ips])
+
+    def test_unpatched_rom_is_mapped_read_only(self, tmp_path: Path) -> None:
+        """Test: Sin parches la ROM es un mmap de solo lectura (sin copia privada)"""
+        cartridge = Cartridge(write_rom(tmp_path, make_rom()))
+        assert isinstance(cartridge._rom_data, mmap.mmap)
+        assert cartridge.read_byte(0x0134) == ord("O")
+        assert cartridge.get_header_info()["title"] == "ORIGINAL"
+        with pytest.raises(TypeError):
+            cartridge._rom_data[0] = 0  # type: ignore[index]
+
+        with pytest.raises(FileNotFoundError):
+            Cartridge(tmp_path / "game.gb", [tmp_path / "missing.ips"])
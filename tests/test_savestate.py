@@ -0,0 +1,150 @@
+"""
+Tests de los slots de guardado (src/savestate.py) y del contenedor comprimido
+de snapshots (snapshot.compress/decompress/read_file).
+"""
+
+import threading
+import time
+from collections.abc import Callable
+from pathlib import Path
+
+import pytest
+
+import src.savestate
+from src import snapshot
+from src.savestate import SLOT_COUNT, SaveSlots
+from src.viboy import Viboy
+
+
+@pytest.fixture
+def viboy(tmp_path: Path, make_rom: Callable[..., Path], headless: None,
+          monkeypatch: pytest.MonkeyPatch) -> Viboy:
+    monkeypatch.setenv("XDG_DATA_HOME", str(tmp_path / "data"))
+    return Viboy(make_rom(b"SAVESTAT"))
+
+
+class TestContainer:
+    """Tests del contenedor en disco"""
+
+    def test_round_trip_and_checksum(self, viboy: Viboy, tmp_path: Path) -> None:
+        """Test: El contenedor comprime, y un byte alterado se detecta antes de descomprimir"""
+        data = snapshot.capture(viboy)
+        packed = snapshot.compress(data)
+        assert len(packed) < len(data) // 4
+        assert snapshot.decompress(packed) == data
+        assert snapshot.decompress(data) == data  # Snapshot sin empaquetar (versión anterior)
+
+        damaged = bytearray(packed)
+        damaged[-1] ^= 0xFF
+        with pytest.raises(ValueError):
+            snapshot.decompress(bytes(damaged))
+
+        (tmp_path / "empty").write_bytes(b"")
+        with pytest.raises(ValueError):
+            snapshot.read_file(tmp_path / "empty")
+
+
+class TestSaveSlots:
+    """Tests de guardado y carga de slots"""
+
+    def test_save_and_load_from_disk(self, viboy: Viboy, tmp_path: Path) -> None:
+        """Test: Un slot escrito en disco se restaura desde otra instancia (vía mmap)"""
+        viboy.get_mmu().write_byte(0xC000, 0x77)
+        slots = SaveSlots(viboy.get_cartridge(), tmp_path / "states")
+        slots.save(viboy, 3)
+        slots.close()
+        assert slots.path(3).exists()
+        assert slots.occupied() == [3]
+
+        viboy.get_mmu().write_byte(0xC000, 0x00)
+        viboy.get_cpu().registers.set_pc(0x4000)
+        slots = SaveSlots(viboy.get_cartridge(), tmp_path / "states")
+        assert slots.load(viboy, 3) is True
+        assert slots.load(viboy, 4) is False  # Vacío
+        slots.close()
+        assert viboy.get_mmu().read_byte(0xC000) == 0x77
+        assert viboy.get_cpu().registers.get_pc() == 0x0100
+
+        with pytest.raises(ValueError):
+            slots.path(SLOT_COUNT)
+
+    def test_damaged_slot_keeps_current_state(self, viboy: Viboy, tmp_path: Path) -> None:
+        """Test: Un slot dañado (CRC o sección del cartucho) no modifica la máquina"""
+        viboy.get_mmu().write_byte(0xC000, 0x55)
+        state = snapshot.capture(viboy)
+        slots = SaveSlots(viboy.get_cartridge(), tmp_path / "states")
+        slots.path(0).parent.mkdir(parents=True, exist_ok=True)
+
+        # Slot 0: contenedor con un byte alterado (falla el CRC)
+        packed = bytearray(snapshot.compress(state))
+        packed[-1] ^= 0xFF
+        slots.path(0).write_bytes(bytes(packed))
+        # Slot 1: CRC correcto, pero la última sección (CART) tiene un byte de más;
+        # CPU, MMU y PPU van antes y no deben tocarse
+        cart = state.index(b"CART")
+        size = int.from_bytes(state[cart + 4:cart + 8], "little")
+        damaged = (state[:cart + 4] + (size + 1).to_bytes(4, "little")
+                   + state[cart + 8:cart + 8 + size] + b"\x00" + state[cart + 8 + size:])
+        slots.path(1).write_bytes(snapshot.compress(damaged))
+
+        viboy.get_mmu().write_byte(0xC000, 0x66)
+        viboy.get_cpu().registers.set_pc(0x4000)
+        before = snapshot.capture(viboy)
+        assert slots.load(viboy, 0) is False
+        assert slots.load(viboy, 1) is False
+        slots.close()
+        assert snapshot.capture(viboy) == before
+        assert viboy.get_mmu().read_byte(0xC000) == 0x66
+        assert viboy.get_cpu().registers.get_pc() == 0x4000
+
+    def test_save_does_not_wait_for_disk(self, viboy: Viboy, tmp_path: Path,
+                                         monkeypatch: pytest.MonkeyPatch) -> None:
+        """Test: save() vuelve con el disco ocupado y el slot se puede cargar ya"""
+        release = threading.Event()
+        real_write = src.savestate.write_atomic
+
+        def slow_write(path: Path, data: bytes) -> None:
+            release.wait(5)
+            real_write(path, data)
+
+        monkeypatch.setattr(src.savestate, "write_atomic", slow_write)
+        slots = SaveSlots(viboy.get_cartridge(), tmp_path / "states")
+        viboy.get_mmu().write_byte(0xC000, 0x42)
+        slots.save(viboy, 0)
+        assert not slots.path(0).exists()
+
+        viboy.get_mmu().write_byte(0xC000, 0x00)
+        assert slots.load(viboy, 0) is True  # Copia en memoria, sin esperar al disco
+        assert viboy.get_mmu().read_byte(0xC000) == 0x42
+        release.set()
+        slots.close()
+        assert slots.path(0).exists()
+
+    def test_save_and_load_fit_in_a_frame(self, viboy: Viboy, tmp_path: Path) -> None:
+        """Test: Captura y carga desde disco tardan menos de un frame (16,7 ms)"""
+        slots = SaveSlots(viboy.get_cartridge(), tmp_path / "states")
+        start = time.perf_counter()
+        slots.save(viboy, 1)
+        save_time = time.perf_counter() - start
+        slots.close()
+
+        slots = SaveSlots(viboy.get_cartridge(), tmp_path / "states")
+        start = time.perf_counter()
+        assert slots.load(viboy, 1) is True
+        load_time = time.perf_counter() - start
+        slots.close()
+        assert save_time < 1 / 60
+        assert load_time < 1 / 60
+
+    def test_viboy_slot_api(self, viboy: Viboy) -> None:
+        """Test: save_state_slot()/load_state_slot() usan el slot seleccionado"""
+        viboy.select_save_slot(5)
+        viboy.get_mmu().write_byte(0xC000, 0x99)
+        viboy.save_state_slot()
+        viboy.get_mmu().write_byte(0xC000, 0x00)
+        assert viboy.load_state_slot(4) is False
+        assert viboy.load_state_slot() is True
+        assert viboy.get_mmu().read_byte(0xC000) == 0x99
+        viboy.close_save_slots()
+        with pytest.raises(ValueError):
+            viboy.select_save_slot(SLOT_COUNT)
@@ -0,0 +1,117 @@
+"""
+Tests para la exportación del estado en memoria compartida (src/debug/state_export.py).
+
+Valida el formato del segmento, el protocolo seqlock (un lector nunca devuelve
+una copia a medias) y la lectura desde un proceso distinto.
+"""
+
+import os
+import subprocess
+import sys
+from pathlib import Path
+
+import pytest
+
+import src.viboy as viboy_module
+from src.debug.state_export import (
+    SEQ_OFFSET,
+    SEQ_STRUCT,
+    SharedStateExporter,
+    SharedStateReader,
+)
+from src.viboy import Viboy
+
+REPO_ROOT = Path(__file__).resolve().parent.parent
+
+
+@pytest.fixture
+def viboy(monkeypatch: pytest.MonkeyPatch) -> Viboy:
+    """Viboy sin renderer con algo de estado reconocible."""
+    monkeypatch.setattr(viboy_module, "Renderer", None)
+    system = Viboy()
+    regs = system.get_cpu().registers
+    regs.set_a(0x42)
+    regs.set_hl(0xBEEF)
+    mmu = system.get_mmu()
+    mmu.write_byte(0xC000, 0x11)
+    mmu.write_byte(0xDFFF, 0x22)
+    mmu.write_byte(0xFF80, 0x33)
+    return system
+
+
+@pytest.fixture
+def segment_name(request: pytest.FixtureRequest) -> str:
+    """Nombre único por test para no chocar con otros procesos."""
+    return f"viboy_test_{os.getpid()}_{request.node.name[:20]}"
+
+
+class TestStateExport:
+    """Tests del exportador/lector de estado"""
+
+    def test_publish_and_read(self, viboy: Viboy, segment_name: str) -> None:
+        """Test: Lo publicado se lee coherente en el mismo proceso"""
+        exporter = SharedStateExporter(segment_name)
+        reader = SharedStateReader(segment_name)
+        try:
+            # Antes del primer publish no hay instantánea
+            assert reader.read() is None
+
+            exporter.publish(viboy)
+            exporter.publish(viboy)
+            snapshot = reader.read()
+            assert snapshot is not None
+            assert snapshot.frame == 2
+            assert snapshot.registers["a"] == 0x42
+            assert snapshot.registers["h"] == 0xBE and snapshot.registers["l"] == 0xEF
+            assert snapshot.registers["pc"] == 0x0100
+            assert snapshot.wram[0] == 0x11 and snapshot.wram[-1] == 0x22
+            assert snapshot.hram[0] == 0x33
+            assert len(snapshot.framebuffer) == 160 * 144 * 3
+            assert reader.sequence() == 4
+        finally:
+            reader.close()
+            exporter.close()
+
+    def test_odd_sequence_is_never_returned(self, viboy: Viboy, segment_name: str) -> None:
+        """Test: Con el escritor a mitad (seq impar) el lector no devuelve datos"""
+        exporter = SharedStateExporter(segment_name)
+        reader = SharedStateReader(segment_name)
+        try:
+            exporter.publish(viboy)
+            SEQ_STRUCT.pack_into(exporter._buf, SEQ_OFFSET, 3)
+            assert reader.read(max_retries=10) is None
+            SEQ_STRUCT.pack_into(exporter._buf, SEQ_OFFSET, 4)
+            assert reader.read(max_retries=10) is not None
+        finally:
+            reader.close()
+            exporter.close()
+
+    def test_read_from_other_process(self, viboy: Viboy, segment_name: str) -> None:
+        """Test: Otro proceso ve el estado publicado"""
+        exporter = SharedStateExporter(segment_name)
+        try:
+            exporter.publish(viboy)
+            code = (
+                "from src.debug.state_export import SharedStateReader\n"
+                f"r = SharedStateReader({segment_name!r})\n"
+                "s = r.read()\n"
+                "print(s.frame, s.registers['a'], s.wram[0])\n"
+                "r.close()\n"
+            )
+            result = subprocess.run(
+                [sys.executable, "-c", code],
+                cwd=REPO_ROOT, capture_output=True, text=True, timeout=60,
+            )
+            assert result.returncode == 0, result.stderr
+            assert result.stdout.split() == ["1", str(0x42), str(0x11)]
+        finally:
+            exporter.close()
+
+    def test_viboy_enable_disable(self, viboy: Viboy, segment_name: str) -> None:
+        """Test: Viboy crea y elimina el segmento"""
+        assert viboy.enable_state_export(segment_name) == segment_name
+        reader = SharedStateReader(segment_name)
+        reader.close()
+        viboy.disable_state_export()
+        with pytest.raises(FileNotFoundError):
+            SharedStateReader(segment_name)
@@ -0,0 +1,145 @@
+"""
+Tests para el comparador de trazas en streaming (tools/trace_diff.py).
+
+Valida:
+- Formato de línea compatible con gameboy-doctor
+- Parada en la primera discrepancia con contexto y registro distinto
+- Consumo en streaming (no se leen líneas más allá de la discrepancia)
+"""
+
+import sys
+from itertools import count
+from pathlib import Path
+
+import pytest
+
+import src.viboy
+from src.cpu.core import CPU
+from src.memory.mmu import MMU
+from tools import trace_diff
+from tools.trace_diff import (
+    compare_doctor_lines,
+    diff_traces,
+    format_doctor_line,
+    stream_cpu_trace,
+)
+
+LINE_0100 = "A:01 F:B0 B:00 C:13 D:00 E:D8 H:01 L:4D SP:FFFE PC:0100 PCMEM:00,C3,13,02"
+
+
+def _make_line(pc: int, a: int = 0x01) -> str:
+    return (
+        f"A:{a:02X} F:B0 B:00 C:13 D:00 E:D8 H:01 L:4D SP:FFFE "
+        f"PC:{pc:04X} PCMEM:00,00,00,00"
+    )
+
+
+class TestTraceDiff:
+    """Tests del comparador de trazas"""
+
+    def test_format_doctor_line(self) -> None:
+        """Test: El estado de la CPU se formatea igual que gameboy-doctor"""
+        mmu = MMU()
+        cpu = CPU(mmu)
+        regs = cpu.registers
+        regs.set_a(0x01)
+        regs.set_f(0xB0)
+        regs.set_bc(0x0013)
+        regs.set_de(0x00D8)
+        regs.set_hl(0x014D)
+        regs.set_sp(0xFFFE)
+        regs.set_pc(0x0100)
+        for offset, value in enumerate((0x00, 0xC3, 0x13, 0x02)):
+            mmu.write_byte(0x0100 + offset, value)
+
+        assert format_doctor_line(cpu, mmu) == LINE_0100
+
+    def test_identical_traces(self) -> None:
+        """Test: Dos trazas idénticas no producen discrepancia"""
+        lines = [_make_line(pc) for pc in range(0x100, 0x200)]
+        mismatch, matched = diff_traces(iter(lines), iter(lines))
+        assert mismatch is None
+        assert matched == len(lines)
+
+    def test_first_mismatch_reports_register_and_context(self) -> None:
+        """Test: Se detiene en la primera discrepancia y reporta el registro"""
+        reference = [_make_line(pc) for pc in range(0x100, 0x110)]
+        ours = list(reference)
+        ours[7] = _make_line(0x107, a=0x02)
+        ours[9] = _make_line(0x109, a=0x03)
+
+        mismatch, matched = diff_traces(ours, reference, context=3)
+        assert mismatch is not None
+        assert matched == 7
+        assert mismatch.line_number == 8
+        assert mismatch.differing == [("A", "02", "01")]
+        assert mismatch.context == reference[4:7]
+
+    def test_case_and_whitespace_are_equivalent(self) -> None:
+        """Test: Diferencias de mayúsculas/espacios no son discrepancias"""
+        assert compare_doctor_lines(LINE_0100, LINE_0100.lower() + "\r") == []
+        mismatch, _ = diff_traces([LINE_0100], [LINE_0100.lower() + "\n"])
+        assert mismatch is None
+
+    def test_our_trace_ends_early(self) -> None:
+        """Test: Si nuestra traza se agota antes, es una discrepancia"""
+        reference = [_make_line(0x100), _make_line(0x101)]
+        mismatch, matched = diff_traces(reference[:1], reference)
+        assert mismatch is not None
+        assert mismatch.ours is None
+        assert matched == 1
+
+    def test_streaming_stops_consuming_at_mismatch(self) -> None:
+        """Test: El comparador no consume la referencia más allá de la discrepancia"""
+        consumed = 0
+
+        def reference():
+            nonlocal consumed
+            for n in count():
+                consumed += 1
+                yield _make_line(0x100 + n if n != 5 else 0xDEAD)
+
+        def ours():
+            for n in count():
+                yield _make_line(0x100 + n)
+
+        mismatch, _ = diff_traces(ours(), reference())
+        assert mismatch is not None
+        assert mismatch.differing[0][0] == "PC"
+        assert consumed == 6
+
+    def test_stream_cpu_trace_logs_state_before_step(self) -> None:
+        """Test: La traza de la CPU refleja el estado previo a cada instrucción"""
+        mmu = MMU()
+        cpu = CPU(mmu)
+        cpu.registers.set_pc(0x0100)
+        # NOP, NOP, INC A
+        mmu.write_byte(0x0100, 0x00)
+        mmu.write_byte(0x0101, 0x00)
+        mmu.write_byte(0x0102, 0x3C)
+
+        lines = list(stream_cpu_trace(cpu, mmu, cpu.step, max_lines=3))
+        assert [line.split()[9] for line in lines] == ["PC:0100", "PC:0101", "PC:0102"]
+        assert lines[2].endswith("PCMEM:3C,00,00,00")
+
+    def test_rom_trace_starts_from_dmg_state(self, tmp_path: Path, monkeypatch: pytest.MonkeyPatch,
+                                             capsys: pytest.CaptureFixture[str]) -> None:
+        """Test: Una ROM marcada como CGB se traza desde el estado DMG, sin ventana"""
+        rom = bytearray(32 * 1024)
+        rom[0x0100:0x0104] = bytes([0x00, 0xC3, 0x13, 0x02])  # NOP; JP 0x0213
+        rom[0x0143] = 0xC0  # Solo CGB
+        rom_path = tmp_path / "cgb.gb"
+        rom_path.write_bytes(bytes(rom))
+        reference = tmp_path / "doctor.log"
+        reference.write_text(LINE_0100 + "\n")
+
+        def no_window(*args: object, **kwargs: object) -> None:
+            raise AssertionError("trace_diff no debe abrir ventana")
+
+        monkeypatch.setattr(src.viboy, "Renderer", no_window)
+        first = next(trace_diff.trace_rom(rom_path))
+        assert first == LINE_0100
+
+        monkeypatch.setattr(sys, "argv", ["trace_diff.py", str(rom_path), str(reference)])
+        trace_diff.main()
+        assert "OK: 1 líneas idénticas" in capsys.readouterr().out
@@ -0,0 +1,105 @@
+"""
+Tests para la grabación de vídeo (src/gpu/recorder.py).
+
+Valida los formatos Y4M y RGB crudo, la conversión BT.601 (con y sin NumPy),
+que push() copie el frame y que Viboy grabe sin renderer.
+"""
+
+from __future__ import annotations
+
+from pathlib import Path
+
+import pytest
+
+import src.gpu.recorder as recorder_module
+import src.viboy as viboy_module
+from src.gpu.recorder import FRAME_SIZE, Y4M_HEADER, VideoRecorder, rgb_to_ycbcr
+from src.memory.mmu import IO_BGP, IO_LCDC
+from src.viboy import Viboy
+
+PLANE = 160 * 144
+
+
+def _solid(rgb: tuple[int, int, int]) -> bytes:
+    return bytes(rgb) * PLANE
+
+
+class TestVideoRecorder:
+    """Tests del grabador"""
+
+    def test_y4m_format(self, tmp_path: Path) -> None:
+        """Test: Cabecera a 4194304/70224 Hz y un bloque FRAME por frame"""
+        path = tmp_path / "out.y4m"
+        recorder = VideoRecorder(path)
+        recorder.push(_solid((255, 255, 255)))
+        recorder.push(_solid((0, 0, 0)))
+        recorder.close()
+
+        data = path.read_bytes()
+        assert data.startswith(Y4M_HEADER)
+        assert b" F4194304:70224 " in Y4M_HEADER
+        frames = data[len(Y4M_HEADER):].split(b"FRAME\n")[1:]
+        assert len(frames) == 2
+        assert all(len(frame) == 3 * PLANE for frame in frames)
+        # Blanco: Y=235, Cb=Cr=128; negro: Y=16
+        assert frames[0][0] == 235 and frames[0][PLANE] == 128 and frames[0][2 * PLANE] == 128
+        assert frames[1][0] == 16
+        assert recorder.duration == pytest.approx(2 / 59.7275, rel=1e-4)
+
+    def test_raw_format_and_copy(self, tmp_path: Path) -> None:
+        """Test: RGB crudo tal cual; modificar el buffer tras push() no altera el vídeo"""
+        path = tmp_path / "out.rgb"
+        recorder = VideoRecorder(path, max_queue=1)
+        assert recorder.format == "raw"
+        frame = bytearray(_solid((10, 20, 30)))
+        recorder.push(frame)
+        frame[0] = 99
+        recorder.push(frame)
+        recorder.close()
+
+        data = path.read_bytes()
+        assert len(data) == 2 * FRAME_SIZE
+        assert data[:3] == bytes((10, 20, 30))
+        assert data[FRAME_SIZE] == 99
+
+    def test_python_conversion_matches_numpy(self, tmp_path: Path,
+                                             monkeypatch: pytest.MonkeyPatch) -> None:
+        """Test: La conversión sin NumPy produce los mismos planos"""
+        frame = bytes((i * 37) & 0xFF for i in range(FRAME_SIZE))
+        expected = b"".join(bytes(c) for c in zip(*(
+            rgb_to_ycbcr(*frame[i:i + 3]) for i in range(0, FRAME_SIZE, 3)
+        )))
+        monkeypatch.setattr(recorder_module, "np", None)
+        recorder = VideoRecorder(tmp_path / "out.y4m")
+        try:
+            assert recorder._to_ycbcr_planes(frame) == expected
+        finally:
+            recorder.close()
+
+    def test_invalid_input(self, tmp_path: Path) -> None:
+        """Test: Formato desconocido, frame de tamaño incorrecto y grabador cerrado"""
+        with pytest.raises(ValueError):
+            VideoRecorder(tmp_path / "out.avi", fmt="avi")
+        recorder = VideoRecorder(tmp_path / "out.rgb")
+        with pytest.raises(ValueError):
+            recorder.push(b"\x00" * 10)
+        recorder.close()
+        with pytest.raises(RuntimeError):
+            recorder.push(_solid((0, 0, 0)))
+
+    def test_viboy_headless_recording(self, tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+        """Test: Sin renderer los frames salen del compositor NumPy"""
+        pytest.importorskip("numpy")
+        monkeypatch.setattr(viboy_module, "Renderer", None)
+        viboy = Viboy()
+        mmu = viboy.get_mmu()
+        mmu.write_byte(IO_BGP, 0xFF)    # Todo negro
+        mmu.write_byte(IO_LCDC, 0x91)
+        path = viboy.enable_recording(tmp_path / "out.rgb")
+        for _ in range(3):
+            viboy._record_frame()
+        viboy.disable_recording()
+
+        data = path.read_bytes()
+        assert len(data) == 3 * FRAME_SIZE
+        assert data[:3] == bytes((0, 0, 0))
@@ -94,40 +94,81 @@ class TraceMMU:
         return names.get(addr, f"IO_0x{addr:04X}")
 
 
-def detect_loop(pc_history: deque[int], threshold: int = 5) -> tuple[bool, list[int] | None]:
+class LoopTracker:
     """
     Detecta si el PC está en un bucle (misma secuencia repetida).
     
-    Args:
-        pc_history: Historial de direcciones PC (últimas N instrucciones)
-        threshold: Número mínimo de repeticiones para considerar bucle
-        
-    Returns:
-        Tupla (True si hay bucle, lista de PCs del bucle o None)
+    Mantiene el estado de forma incremental para que cada PC cueste O(1)
+    (acotado por `threshold`), en lugar de reconstruir listas y sets del
+    historial completo en cada instrucción:
+    - Para cada longitud de patrón p, un contador de "racha" de posiciones
+      consecutivas en las que PC == PC de hace p instrucciones. Si la racha
+      alcanza p, los últimos p PCs repiten exactamente los p anteriores.
+    - Contadores por PC de las últimas 10 instrucciones, actualizados al
+      entrar y salir cada PC, para saber cuántos PCs únicos hay.
     """
-    if len(pc_history) < threshold * 2:
-        return False, None
     
-    # Convertir a lista para análisis
-    history_list = list(pc_history)
+    # Ventana para la heurística de "pocos PCs únicos" (bucle corto con saltos)
+    SHORT_WINDOW = 10
     
-    # Buscar patrones repetidos: comparar últimos N con los N anteriores
-    for pattern_len in range(3, min(threshold + 1, len(history_list) // 2)):
-        last_pattern = history_list[-pattern_len:]
-        prev_pattern = history_list[-pattern_len * 2:-pattern_len]
+    def __init__(self, history_size: int = 20, threshold: int = 5) -> None:
+        """
+        Args:
+            history_size: Número de PCs recientes a conservar
+            threshold: Número mínimo de repeticiones para considerar bucle
+        """
+        self.threshold = threshold
+        self.pc_history: deque[int] = deque(maxlen=history_size)
+        self._match_runs: list[int] = [0] * (threshold + 1)
+        self._short_window: deque[int] = deque()
+        self._short_counts: dict[int, int] = {}
+    
+    def add_pc(self, pc: int) -> tuple[bool, list[int] | None]:
+        """
+        Añade un PC y comprueba si hay bucle.
         
-        # Si los patrones coinciden, es un bucle
-        if last_pattern == prev_pattern:
-            return True, last_pattern
-    
-    # También detectar si el PC oscila entre las mismas direcciones
-    # (bucle corto con saltos condicionales)
-    unique_pcs = set(history_list[-10:])
-    if len(unique_pcs) <= 3 and len(history_list) >= 10:
-        # Si solo hay 3 o menos PCs únicos en las últimas 10 instrucciones, es un bucle
-        return True, list(unique_pcs)
-    
-    return False, None
+        Returns:
+            Tupla (True si hay bucle, lista de PCs del bucle o None)
+        """
+        history = self.pc_history
+        size = len(history)
+        runs = self._match_runs
+        
+        # Actualizar las rachas de coincidencia para cada longitud de patrón
+        for pattern_len in range(3, self.threshold + 1):
+            if size >= pattern_len and history[-pattern_len] == pc:
+                runs[pattern_len] += 1
+            else:
+                runs[pattern_len] = 0
+        history.append(pc)
+        
+        # Actualizar contadores de la ventana corta
+        window = self._short_window
+        counts = self._short_counts
+        if len(window) == self.SHORT_WINDOW:
+            old = window.popleft()
+            if counts[old] == 1:
+                del counts[old]
+            else:
+                counts[old] -= 1
+        window.append(pc)
+        counts[pc] = counts.get(pc, 0) + 1
+        
+        if len(history) < self.threshold * 2:
+            return False, None
+        
+        # Si los últimos p PCs coinciden con los p anteriores, es un bucle
+        for pattern_len in range(3, self.threshold + 1):
+            if runs[pattern_len] >= pattern_len:
+                return True, list(history)[-pattern_len:]
+        
+        # También detectar si el PC oscila entre las mismas direcciones
+        # (bucle corto con saltos condicionales)
+        if len(counts) <= 3 and len(window) >= self.SHORT_WINDOW:
+            # Si solo hay 3 o menos PCs únicos en las últimas 10 instrucciones, es un bucle
+            return True, list(counts)
+        
+        return False, None
 
 
 def format_instruction_log(
@@ -222,7 +263,7 @@ def main() -> None:
     instruction_log: list[str] = []
     
     # Historial de PC para detección de bucles
-    pc_history: deque[int] = deque(maxlen=20)
+    loop_tracker = LoopTracker(history_size=20, threshold=5)
     
     # Detectar ejecución de DI/EI
     di_ei_log: list[dict] = []  # Lista de ejecuciones de DI/EI
@@ -291,12 +332,9 @@ def main() -> None:
             )
             instruction_log.append(log_line)
             
-            # Añadir PC al historial
-            pc_history.append(pc_before)
-            
-            # Detectar bucles
+            # Añadir PC al historial y detectar bucles
+            has_loop, loop_pattern = loop_tracker.add_pc(pc_before)
             if not loop_detected:
-                has_loop, loop_pattern = detect_loop(pc_history, threshold=5)
                 if has_loop:
                     loop_detected = True
                     print("=" * 80)
@@ -205,20 +205,56 @@ class Disassembler:
 class LoopDetector:
     """
     Detecta bucles infinitos analizando el historial de direcciones PC.
+    
+    Todo el trabajo por instrucción es O(1) para poder dejarlo activo en
+    ejecuciones largas (10M+ instrucciones):
+    - Contadores por PC mantenidos incrementalmente: al entrar un PC en la
+      ventana se incrementa su contador y al salir el más antiguo se decrementa.
+      Así "cuántas veces aparece PC en la ventana" es una consulta a un dict.
+    - Hash rodante (polinómico, estilo Rabin-Karp) de los últimos k PCs. Si el
+      hash actual ya se vio hace d instrucciones, la secuencia de PCs se repite
+      con periodo d (patrón del bucle).
     """
     
-    def __init__(self, window_size: int = 100, confidence_threshold: int = 5000):
+    # Parámetros del hash rodante: módulo primo de Mersenne (2^31 - 1) y base.
+    # Con este módulo todos los productos intermedios caben en ~48 bits
+    _HASH_MOD = (1 << 31) - 1
+    _HASH_BASE = 0x10001
+    
+    def __init__(
+        self,
+        window_size: int = 100,
+        confidence_threshold: int = 5000,
+        pattern_length: int = 16,
+    ):
         """
         Args:
             window_size: Tamaño de la ventana de direcciones recientes
             confidence_threshold: Número de iteraciones en el mismo rango para considerar bucle
+            pattern_length: Número de PCs (k) que cubre el hash rodante
         """
         self.window_size = window_size
         self.confidence_threshold = confidence_threshold
-        self.pc_history: deque[int] = deque(maxlen=window_size)
+        self.pattern_length = pattern_length
+        self.pc_history: deque[int] = deque()
         self.loop_counter: dict[int, int] = {}
         self.current_loop_start: int | None = None
         self.iterations_in_loop: int = 0
+        
+        # Apariciones de cada PC dentro de la ventana (sin entradas a cero)
+        self._window_counts: dict[int, int] = {}
+        
+        # Hash rodante de los últimos k PCs
+        self._hash: int = 0
+        self._hash_out_factor: int = pow(self._HASH_BASE, pattern_length, self._HASH_MOD)
+        # Hashes de las últimas `window_size` posiciones y última posición de cada hash
+        self._hash_ring: deque[int] = deque()
+        self._hash_last_seen: dict[int, int] = {}
+        self._position: int = 0
+        
+        # Periodo del patrón repetido actual (None si no hay patrón)
+        self.loop_period: int | None = None
+        self.period_repeats: int = 0
     
     def add_pc(self, pc: int) -> bool:
         """
@@ -227,16 +263,34 @@ class LoopDetector:
         Returns:
             True si se detecta un bucle con alta confianza
         """
-        self.pc_history.append(pc)
+        history = self.pc_history
+        counts = self._window_counts
+        
+        # Hash rodante: sacar el PC que abandona los últimos k (si lo hay)
+        k = self.pattern_length
+        h = self._hash * self._HASH_BASE + pc + 1
+        if len(history) >= k:
+            h -= (history[-k] + 1) * self._hash_out_factor
+        h %= self._HASH_MOD
+        self._hash = h
+        
+        # Ventana de PCs: decrementar el contador del PC que sale
+        if len(history) == self.window_size:
+            old = history.popleft()
+            remaining = counts[old] - 1
+            if remaining:
+                counts[old] = remaining
+            else:
+                del counts[old]
+        history.append(pc)
+        count = counts.get(pc, 0) + 1
+        counts[pc] = count
         
-        # Contar cuántas veces aparece PC en la ventana reciente
-        count = sum(1 for p in self.pc_history if p == pc)
+        self._update_pattern(h)
         
         # Si aparece muchas veces, incrementar contador de confianza
         if count >= 10:  # Aparece al menos 10 veces en las últimas 100
-            if pc not in self.loop_counter:
-                self.loop_counter[pc] = 0
-            self.loop_counter[pc] += 1
+            self.loop_counter[pc] = self.loop_counter.get(pc, 0) + 1
             
             # Si este PC es el inicio del bucle actual
             if self.current_loop_start == pc:
@@ -257,6 +311,57 @@ class LoopDetector:
         
         return False
     
+    def _update_pattern(self, h: int) -> None:
+        """
+        Actualiza el periodo del patrón a partir del hash de los últimos k PCs.
+        
+        Si el mismo hash apareció hace d posiciones (dentro de la ventana), los
+        últimos k PCs coinciden con los de hace d instrucciones: periodo d.
+        """
+        position = self._position
+        self._position = position + 1
+        if position < self.pattern_length - 1:
+            # Aún no hay k PCs: el hash no representa una ventana completa
+            return
+        
+        last_seen = self._hash_last_seen
+        previous = last_seen.get(h)
+        if previous is not None:
+            period = position - previous
+            if period == self.loop_period:
+                self.period_repeats += 1
+            else:
+                self.loop_period = period
+                self.period_repeats = 1
+        else:
+            self.loop_period = None
+            self.period_repeats = 0
+        
+        # Registrar el hash y expulsar el que sale de la ventana
+        ring = self._hash_ring
+        if len(ring) == self.window_size:
+            old_hash = ring.popleft()
+            if last_seen.get(old_hash) == position - self.window_size:
+                del last_seen[old_hash]
+        ring.append(h)
+        last_seen[h] = position
+    
+    def get_window_count(self, pc: int) -> int:
+        """Devuelve cuántas veces aparece PC en la ventana actual (O(1))."""
+        return self._window_counts.get(pc, 0)
+    
+    def get_loop_pattern(self) -> list[int]:
+        """
+        Devuelve la secuencia de PCs que se repite (un periodo completo).
+        
+        Returns:
+            Lista de PCs del patrón, o lista vacía si no hay patrón
+        """
+        period = self.loop_period
+        if period is None or period > len(self.pc_history):
+            return []
+        return list(self.pc_history)[-period:]
+    
     def get_loop_range(self) -> tuple[int, int]:
         """
         Devuelve el rango de direcciones del bucle detectado.
@@ -264,15 +369,11 @@ class LoopDetector:
         Returns:
             (min_pc, max_pc) del bucle
         """
-        if not self.pc_history:
-            return (0, 0)
-        
-        # Obtener el rango de direcciones únicas en la ventana
-        unique_pcs = sorted(set(self.pc_history))
-        if not unique_pcs:
+        # Las claves de los contadores son exactamente los PCs únicos de la ventana
+        if not self._window_counts:
             return (0, 0)
         
-        return (min(unique_pcs), max(unique_pcs))
+        return (min(self._window_counts), max(self._window_counts))
 
 
 class DoctorViboy:
@@ -358,6 +459,11 @@ class DoctorViboy:
         
         print(f"[*] Ubicacion del bucle: 0x{min_pc:04X} - 0x{max_pc:04X}")
         print(f"[*] Iteraciones detectadas: {self.loop_detector.iterations_in_loop:,}")
+        pattern = self.loop_detector.get_loop_pattern()
+        if pattern:
+            print(f"[*] Patron repetido (periodo {len(pattern)}): "
+                  f"{' '.join(f'0x{pc:04X}' for pc in pattern[:16])}"
+                  f"{' ...' if len(pattern) > 16 else ''}")
         print()
         
         # Desensamblar el bucle
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""
+Re-renderizado Offline de un Registro de la PPU
+
+Reconstruye los frames de una ejecución grabada con `main.py --ppu-log` (ver
+src/gpu/ppu_log.py) y los guarda como imágenes PPM o como un vídeo Y4M/RGB crudo.
+
+El registro contiene un keyframe (estado completo de VRAM/OAM/registros) cada N
+frames. Cada rango entre dos keyframes es independiente: se reparte entre
+procesos (multiprocessing), cada uno con su propia MMU y compositor NumPy, que
+aplican las escrituras desde su keyframe y componen cada frame. Los resultados
+se recogen en orden.
+
+Uso:
+    python tools/rerender_ppu_log.py <registro.ppulog> --out-dir frames/ [--jobs N]
+    python tools/rerender_ppu_log.py <registro.ppulog> --video salida.y4m [--jobs N]
+
+Requiere NumPy (compositor vectorizado).
+
+Fuente: Pan Docs - VRAM, OAM, LCD Control
+"""
+
+from __future__ import annotations
+
+import argparse
+import os
+import sys
+from multiprocessing import get_context
+from pathlib import Path
+from typing import TYPE_CHECKING, Iterable
+
+# Añadir el directorio raíz al path para importar módulos
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+from src.gpu.ppu_log import PPULogInfo, read_log_info, replay
+
+if TYPE_CHECKING:
+    from src.gpu.recorder import VideoRecorder
+
+PPM_HEADER = b"P6\n160 144\n255\n"
+
+
+def frame_ranges(info: PPULogInfo) -> list[tuple[int, int, int]]:
+    """
+    Divide el registro en rangos independientes, uno por keyframe.
+
+    Returns:
+        Lista de (offset del keyframe, primer frame, número de frames)
+    """
+    ranges = []
+    for i, (first, offset) in enumerate(info.keyframes):
+        end = info.keyframes[i + 1][0] if i + 1 < len(info.keyframes) else info.frames
+        if end > first:
+            ranges.append((offset, first, end - first))
+    return ranges
+
+
+def render_range(log_path: str, offset: int, first: int, count: int,
+                 out_dir: str | None = None) -> list[bytes]:
+    """
+    Reconstruye y compone los frames de un rango (se ejecuta en un proceso trabajador).
+
+    Args:
+        log_path: Registro de la PPU
+        offset: Offset del keyframe inicial
+        first: Número absoluto del primer frame (para nombrar las imágenes)
+        count: Frames del rango
+        out_dir: Directorio de imágenes PPM (None = devolver los frames)
+
+    Returns:
+        Frames RGB (vacío si se escribieron en out_dir)
+    """
+    from src.gpu.numpy_compositor import NumpyCompositor
+    from src.memory.mmu import MMU
+
+    mmu = MMU()
+    compositor = NumpyCompositor(mmu)
+    frames: list[bytes] = []
+    for n in replay(log_path, mmu, offset, count):
+        rgb = compositor.compose().tobytes()
+        if out_dir is None:
+            frames.append(rgb)
+        else:
+            (Path(out_dir) / f"frame_{first + n:06d}.ppm").write_bytes(PPM_HEADER + rgb)
+    return frames
+
+
+def _render_task(task: tuple[str, int, int, int, str | None]) -> list[bytes]:
+    return render_range(*task)
+
+
+def rerender(log_path: str | Path, out_dir: str | Path | None = None,
+             video: str | Path | None = None, jobs: int | None = None) -> int:
+    """
+    Re-renderiza todos los frames de un registro.
+
+    Args:
+        log_path: Registro de la PPU
+        out_dir: Directorio para imágenes PPM
+        video: Archivo de vídeo (.y4m = Y4M, otra extensión = RGB crudo)
+        jobs: Procesos trabajadores (None = número de CPUs; 1 = sin procesos)
+
+    Returns:
+        Número de frames renderizados
+    """
+    from src.gpu.recorder import VideoRecorder
+
+    info = read_log_info(log_path)
+    if out_dir is not None:
+        Path(out_dir).mkdir(parents=True, exist_ok=True)
+    ranges = frame_ranges(info)
+    tasks = [(str(log_path), offset, first, count, None if out_dir is None else str(out_dir))
+             for offset, first, count in ranges]
+
+    recorder = VideoRecorder(video) if video is not None else None
+    jobs = jobs or os.cpu_count() or 1
+    try:
+        if jobs == 1 or len(tasks) <= 1:
+            _collect(map(_render_task, tasks), recorder)
+        else:
+            # "spawn": los trabajadores no heredan el estado de SDL ni hilos del proceso padre
+            with get_context("spawn").Pool(min(jobs, len(tasks))) as pool:
+                # imap mantiene el orden de los rangos
+                _collect(pool.imap(_render_task, tasks), recorder)
+    finally:
+        if recorder is not None:
+            recorder.close()
+    return sum(count for _, _, count in ranges)
+
+
+def _collect(results: Iterable[list[bytes]], recorder: VideoRecorder | None) -> None:
+    """Envía al grabador, en orden, los frames devueltos por cada rango."""
+    for frames in results:
+        if recorder is not None:
+            for frame in frames:
+                recorder.push(frame)
+
+
+def main() -> None:
+    """Punto de entrada CLI"""
+    parser = argparse.ArgumentParser(
+        description="Re-renderiza offline un registro de escrituras de la PPU"
+    )
+    parser.add_argument("log", help="Registro generado con main.py --ppu-log")
+    output = parser.add_mutually_exclusive_group(required=True)
+    output.add_argument("--out-dir", help="Directorio donde guardar los frames como PPM")
+    output.add_argument("--video", help="Archivo de vídeo (.y4m = Y4M, otra extensión = RGB crudo)")
+    parser.add_argument("--jobs", type=int, default=None, help="Procesos trabajadores (por defecto, uno por CPU)")
+    args = parser.parse_args()
+
+    total = rerender(args.log, out_dir=args.out_dir, video=args.video, jobs=args.jobs)
+    print(f"{total} frames renderizados")
+
+
+if __name__ == "__main__":
+    main()
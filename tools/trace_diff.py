@@ -0,0 +1,347 @@
+#!/usr/bin/env python3
+"""
+Comparador de Trazas en Streaming para Viboy Color
+
+Este script compara la ejecución de nuestra CPU contra un log de referencia
+generado por otro emulador en el formato de "gameboy-doctor":
+
+    A:01 F:B0 B:00 C:13 D:00 E:D8 H:01 L:4D SP:FFFE PC:0100 PCMEM:00,C3,13,02
+
+Cada línea representa el estado de la CPU ANTES de ejecutar la instrucción
+situada en PC. PCMEM son los 4 bytes de memoria a partir de PC.
+
+Objetivo: Obtener feedback rápido de corrección tras cada optimización de la CPU.
+Los logs de referencia pueden tener cientos de millones de líneas, así que nada
+se carga entero en memoria: ambos lados se consumen como iteradores, línea a
+línea, y solo se guarda un buffer circular con las últimas N líneas de contexto.
+
+La comparación usa un "fast path": primero se comparan las cadenas completas
+(una sola comparación en C). Solo si difieren se parsean los campos para
+identificar qué registro es distinto.
+
+Uso:
+    python tools/trace_diff.py <rom_path> <reference.log[.gz]> [--context N] [--max-lines N]
+    python tools/trace_diff.py --ours <nuestro.log> <reference.log> [--context N]
+
+Fuente: gameboy-doctor (formato de log), Pan Docs - CPU Registers and Flags
+"""
+
+from __future__ import annotations
+
+import argparse
+import gzip
+import sys
+from collections import deque
+from dataclasses import dataclass, field
+from itertools import islice
+from pathlib import Path
+from typing import TYPE_CHECKING, Callable, Iterable, Iterator, TextIO
+
+# Añadir el directorio raíz al path para importar módulos
+sys.path.insert(0, str(Path(__file__).parent.parent))
+
+if TYPE_CHECKING:
+    from src.cpu.core import CPU
+    from src.memory.mmu import MMU
+
+# Orden de los campos en una línea de gameboy-doctor
+DOCTOR_FIELDS = ("A", "F", "B", "C", "D", "E", "H", "L", "SP", "PC", "PCMEM")
+
+# Tamaño del buffer de lectura para logs de referencia (1 MiB)
+READ_BUFFER_SIZE = 1 << 20
+
+# Valor que gameboy-doctor espera en LY (FF44): la referencia se genera con LY
+# fijado a 0x90 para que los bucles de espera de V-Blank sean deterministas
+DOCTOR_LY_STUB = 0x90
+
+
+@dataclass
+class TraceMismatch:
+    """
+    Resultado de la primera discrepancia encontrada entre dos trazas.
+
+    Attributes:
+        line_number: Número de línea (1-based) donde aparece la discrepancia
+        ours: Nuestra línea (None si nuestra traza terminó antes)
+        reference: Línea de referencia
+        context: Últimas líneas coincidentes antes de la discrepancia
+        differing: Lista de (campo, nuestro_valor, valor_referencia)
+    """
+
+    line_number: int
+    ours: str | None
+    reference: str
+    context: list[str] = field(default_factory=list)
+    differing: list[tuple[str, str | None, str | None]] = field(default_factory=list)
+
+
+def format_doctor_line(cpu: CPU, mmu: MMU) -> str:
+    """
+    Formatea el estado actual de la CPU como una línea de gameboy-doctor.
+
+    Args:
+        cpu: Instancia de la CPU (estado ANTES de ejecutar la instrucción en PC)
+        mmu: MMU para leer PCMEM
+
+    Returns:
+        Línea formateada (sin salto de línea)
+    """
+    regs = cpu.registers
+    pc = regs.get_pc()
+    read = mmu.read_byte
+    return (
+        f"A:{regs.get_a():02X} F:{regs.get_f():02X} "
+        f"B:{regs.get_b():02X} C:{regs.get_c():02X} "
+        f"D:{regs.get_d():02X} E:{regs.get_e():02X} "
+        f"H:{regs.get_h():02X} L:{regs.get_l():02X} "
+        f"SP:{regs.get_sp():04X} PC:{pc:04X} "
+        f"PCMEM:{read(pc):02X},{read((pc + 1) & 0xFFFF):02X},"
+        f"{read((pc + 2) & 0xFFFF):02X},{read((pc + 3) & 0xFFFF):02X}"
+    )
+
+
+def parse_doctor_line(line: str) -> dict[str, str]:
+    """
+    Parsea una línea de gameboy-doctor en un diccionario campo -> valor.
+
+    Los valores se normalizan a mayúsculas para tolerar logs en minúsculas.
+    Solo se llama en el camino lento (cuando las cadenas no coinciden).
+
+    Args:
+        line: Línea de log (p.ej. "A:01 F:B0 ... PC:0100 PCMEM:00,C3,13,02")
+
+    Returns:
+        Diccionario con los campos encontrados
+    """
+    fields: dict[str, str] = {}
+    for token in line.split():
+        name, sep, value = token.partition(":")
+        if sep:
+            fields[name.upper()] = value.upper()
+    return fields
+
+
+def compare_doctor_lines(ours: str, reference: str) -> list[tuple[str, str | None, str | None]]:
+    """
+    Compara dos líneas campo a campo.
+
+    Args:
+        ours: Nuestra línea
+        reference: Línea de referencia
+
+    Returns:
+        Lista de (campo, nuestro_valor, valor_referencia) que difieren.
+        Lista vacía si son equivalentes (p.ej. solo difieren en espacios o mayúsculas).
+    """
+    ours_fields = parse_doctor_line(ours)
+    ref_fields = parse_doctor_line(reference)
+    differing: list[tuple[str, str | None, str | None]] = []
+    # Primero los campos conocidos en orden canónico, después cualquier extra
+    names = list(DOCTOR_FIELDS)
+    names.extend(n for n in ref_fields if n not in DOCTOR_FIELDS)
+    names.extend(n for n in ours_fields if n not in DOCTOR_FIELDS and n not in ref_fields)
+    for name in names:
+        ours_value = ours_fields.get(name)
+        ref_value = ref_fields.get(name)
+        if ours_value != ref_value:
+            differing.append((name, ours_value, ref_value))
+    return differing
+
+
+def diff_traces(
+    ours: Iterable[str],
+    reference: Iterable[str],
+    context: int = 10,
+) -> tuple[TraceMismatch | None, int]:
+    """
+    Compara dos trazas en streaming y se detiene en la primera discrepancia.
+
+    Ninguna de las dos trazas se materializa: se consumen como iteradores y
+    solo se conservan las últimas `context` líneas en un buffer circular.
+
+    Args:
+        ours: Iterable de nuestras líneas
+        reference: Iterable de líneas de referencia
+        context: Número de líneas coincidentes a conservar como contexto
+
+    Returns:
+        Tupla (discrepancia o None, número de líneas comparadas con éxito)
+    """
+    history: deque[str] = deque(maxlen=context)
+    remember = history.append
+    ours_iter = iter(ours)
+    line_number = 0
+
+    for ref_line in reference:
+        ref_line = ref_line.rstrip("\r\n")
+        line_number += 1
+        our_line = next(ours_iter, None)
+        if our_line is None:
+            return TraceMismatch(line_number, None, ref_line, list(history)), line_number - 1
+        our_line = our_line.rstrip("\r\n")
+
+        # Fast path: comparación directa de cadenas
+        if our_line != ref_line:
+            differing = compare_doctor_lines(our_line, ref_line)
+            if differing:
+                return (
+                    TraceMismatch(line_number, our_line, ref_line, list(history), differing),
+                    line_number - 1,
+                )
+        remember(our_line)
+
+    # La referencia manda: si se agota sin discrepancias, la traza es correcta
+    # (nuestra traza suele ser un generador sin fin)
+    return None, line_number
+
+
+def stream_cpu_trace(
+    cpu: CPU,
+    mmu: MMU,
+    step: Callable[[], object],
+    max_lines: int | None = None,
+) -> Iterator[str]:
+    """
+    Genera nuestra traza instrucción a instrucción, bajo demanda.
+
+    Cada línea refleja el estado ANTES de ejecutar la instrucción, igual que
+    gameboy-doctor. Como es un generador, la emulación avanza solo al ritmo
+    al que el comparador consume líneas.
+
+    Args:
+        cpu: Instancia de la CPU
+        mmu: MMU para leer PCMEM
+        step: Función que ejecuta una instrucción (p.ej. Viboy.tick)
+        max_lines: Número máximo de líneas a generar (None = sin límite)
+
+    Yields:
+        Líneas en formato gameboy-doctor
+    """
+    produced = 0
+    while max_lines is None or produced < max_lines:
+        yield format_doctor_line(cpu, mmu)
+        step()
+        produced += 1
+
+
+def trace_rom(rom_path: str | Path, max_lines: int | None = None, ly_stub: bool = True) -> Iterator[str]:
+    """
+    Carga la ROM y genera su traza como la espera gameboy-doctor.
+
+    Los logs de gameboy-doctor parten del estado post-boot de una DMG
+    (A:01 F:B0 B:00 C:13 D:00 E:D8 H:01 L:4D), así que el modelo se fuerza a
+    DMG aunque la cabecera marque la ROM como compatible con CGB. El sistema
+    es headless: comparar trazas no necesita ventana.
+
+    Args:
+        rom_path: Ruta a la ROM
+        max_lines: Número máximo de líneas a generar (None = sin límite)
+        ly_stub: Fijar LY a DOCTOR_LY_STUB, como al generar la referencia
+
+    Returns:
+        Generador de líneas en formato gameboy-doctor
+
+    Raises:
+        RuntimeError: Si la CPU o la MMU no se inicializan
+    """
+    from src.memory.cartridge import MODEL_DMG
+    from src.viboy import Viboy
+
+    viboy = Viboy(rom_path, model=MODEL_DMG, headless=True)
+    cpu = viboy.get_cpu()
+    mmu = viboy.get_mmu()
+    ppu = viboy.get_ppu()
+    if cpu is None or mmu is None:
+        raise RuntimeError("CPU o MMU no inicializados")
+    if ppu is not None and ly_stub:
+        ppu.get_ly = lambda: DOCTOR_LY_STUB  # type: ignore[method-assign]
+    return stream_cpu_trace(cpu, mmu, viboy.tick, max_lines)
+
+
+def open_trace(path: Path) -> TextIO:
+    """
+    Abre un log de traza para lectura en streaming (soporta .gz).
+
+    Args:
+        path: Ruta al log
+
+    Returns:
+        Fichero de texto abierto con un buffer de lectura grande
+    """
+    if path.suffix == ".gz":
+        return gzip.open(path, "rt", encoding="ascii", errors="replace")
+    return open(path, "r", encoding="ascii", errors="replace", buffering=READ_BUFFER_SIZE)
+
+
+def print_mismatch(mismatch: TraceMismatch) -> None:
+    """Muestra la discrepancia con su contexto y los registros que difieren."""
+    print("=" * 80)
+    print(f"DISCREPANCIA EN LA LÍNEA {mismatch.line_number:,}")
+    print("=" * 80)
+    print("Contexto (últimas líneas coincidentes):")
+    first = mismatch.line_number - len(mismatch.context)
+    for offset, line in enumerate(mismatch.context):
+        print(f"  {first + offset:>12,}  {line}")
+    print("-" * 80)
+    print(f"  {'Viboy':>12}  {mismatch.ours if mismatch.ours is not None else '<fin de traza>'}")
+    print(f"  {'Referencia':>12}  {mismatch.reference}")
+    if mismatch.differing:
+        print("-" * 80)
+        print("Registros distintos:")
+        for name, ours_value, ref_value in mismatch.differing:
+            print(f"  {name:<6} Viboy={ours_value}  Referencia={ref_value}")
+    print("=" * 80)
+
+
+def main() -> None:
+    """Función principal del comparador de trazas."""
+    parser = argparse.ArgumentParser(
+        description="Compara la ejecución de Viboy contra un log de referencia (formato gameboy-doctor)"
+    )
+    parser.add_argument("rom", nargs="?", help="Ruta a la ROM a ejecutar")
+    parser.add_argument("reference", help="Log de referencia (.log o .log.gz)")
+    parser.add_argument("--ours", help="Comparar un log propio ya generado en lugar de ejecutar la ROM")
+    parser.add_argument("--context", type=int, default=10, help="Líneas de contexto a mostrar (default: 10)")
+    parser.add_argument("--max-lines", type=int, default=None, help="Máximo de líneas a comparar")
+    parser.add_argument(
+        "--no-ly-stub",
+        action="store_true",
+        help="No fijar LY a 0x90 (gameboy-doctor genera sus logs con LY=0x90)",
+    )
+    args = parser.parse_args()
+
+    reference_path = Path(args.reference)
+    if not reference_path.exists():
+        print(f"Error: Log de referencia no encontrado: {reference_path}")
+        sys.exit(1)
+
+    with open_trace(reference_path) as reference_file:
+        reference: Iterable[str] = reference_file
+        if args.max_lines is not None:
+            reference = islice(reference, args.max_lines)
+
+        if args.ours:
+            with open_trace(Path(args.ours)) as ours_file:
+                ours: Iterable[str] = ours_file
+                if args.max_lines is not None:
+                    ours = islice(ours, args.max_lines)
+                mismatch, matched = diff_traces(ours, reference, args.context)
+        else:
+            if args.rom is None:
+                parser.error("Se requiere una ROM o --ours")
+            try:
+                ours = trace_rom(args.rom, args.max_lines, ly_stub=not args.no_ly_stub)
+            except Exception as e:
+                print(f"Error al cargar ROM: {e}")
+                sys.exit(1)
+            mismatch, matched = diff_traces(ours, reference, args.context)
+
+    if mismatch is None:
+        print(f"OK: {matched:,} líneas idénticas")
+        return
+    print_mismatch(mismatch)
+    sys.exit(2)
+
+
+if __name__ == "__main__":
+    main()